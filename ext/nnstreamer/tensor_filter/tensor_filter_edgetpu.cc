@@ -101,6 +101,8 @@ class edgetpu_subplugin final : public tensor_filter_subplugin
   /**< EdgeTPU Device context */
   std::unique_ptr<tflite::FlatBufferModel> model;
   /**< Loaded TF Lite model (from model_path) */
+  const void *model_data;
+  /**< The model file mapped and shared in the process (nullptr if the model is loaded from file) */
   static std::unique_ptr<tflite::Interpreter> BuildEdgeTpuInterpreter (
       const tflite::FlatBufferModel &model, const edgetpu_subplugin_device_type dev_type,
       edgetpu::EdgeTpuContext *edgetpu_context = nullptr);
@@ -140,7 +142,8 @@ const accl_hw edgetpu_subplugin::hw_list[] = { ACCL_NPU_EDGE_TPU };
 edgetpu_subplugin::edgetpu_subplugin ()
     : tensor_filter_subplugin (), empty_model (true), model_path (nullptr),
       device_type (edgetpu_subplugin_device_type::DEFAULT),
-      model_interpreter (nullptr), edgetpu_context (nullptr), model (nullptr)
+      model_interpreter (nullptr), edgetpu_context (nullptr), model (nullptr),
+      model_data (nullptr)
 {
   gst_tensors_info_init (std::addressof (inputInfo));
   gst_tensors_info_init (std::addressof (outputInfo));
@@ -151,8 +154,16 @@ edgetpu_subplugin::edgetpu_subplugin ()
 void
 edgetpu_subplugin::cleanup ()
 {
-  if (empty_model)
-    return; /* Nothing to do if it is an empty model */
+  if (empty_model) {
+    /* The model file may be mapped if configure_instance() has failed */
+    if (model_data) {
+      model_interpreter = nullptr;
+      model = nullptr;
+      nnstreamer_filter_model_file_unref (model_data);
+      model_data = nullptr;
+    }
+    return; /* Nothing else to do if it is an empty model */
+  }
 
   if (model_interpreter) {
     model_interpreter = nullptr; /* delete unique_ptr */
@@ -167,6 +178,10 @@ edgetpu_subplugin::cleanup ()
   if (model) {
     model = nullptr; /* delete unique_ptr */
   }
+  if (model_data) {
+    nnstreamer_filter_model_file_unref (model_data);
+    model_data = nullptr;
+  }
 
   if (model_path)
     delete model_path;
@@ -274,8 +289,15 @@ edgetpu_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 
   model_path = g_strdup (prop->model_files[0]);
 
-  /** Read a model */
-  model = tflite::FlatBufferModel::BuildFromFile (_model_path.c_str ());
+  /** Read a model, the model file is shared with other instances if possible */
+  size_t model_size;
+  model_data = nnstreamer_filter_model_file_ref (_model_path.c_str (), &model_size);
+  if (model_data) {
+    model = tflite::FlatBufferModel::BuildFromBuffer (
+        static_cast<const char *> (model_data), model_size);
+  } else {
+    model = tflite::FlatBufferModel::BuildFromFile (_model_path.c_str ());
+  }
   if (nullptr == model) {
     cleanup ();
     throw std::invalid_argument ("Cannot load the given model file.");
@@ -24,12 +24,37 @@
  * This is the per-NN-framework plugin (tensorflow-lite, tensorflow2-lite)
  * for tensor_filter. The meson build system generates two .so files
  * (e.g., TF-Lite and TF2-Lite) from this source code.
+ *
+ * With the custom option "NumInterpreters:N", the subplugin builds N
+ * interpreters from one FlatBufferModel (the weights are loaded once) and
+ * each invoke runs on an idle interpreter, so that the concurrent callers
+ * of the opened model (e.g., single-shot invoked from several threads) do
+ * not wait for the others. The number of threads (NumThreads, num_cpus of
+ * tensor_filter, or the number of cores if not given) is divided by the
+ * interpreters, so that the interpreters running at once do not use more
+ * threads than given. Each interpreter applies its own delegate; with
+ * XNNPACK, each one has a thread pool of the divided threads and its own
+ * copy of the packed weights.
+ * The invokes, the average latency and the zero-copy invokes of each
+ * interpreter are shown with the property 'framework-stats' of tensor_filter.
+ *
+ * With the custom option "OutputRing:N" (tflite v2.5.0 or higher), the
+ * subplugin provides the ring of N output buffers to tensor_filter
+ * (GET_OUTPUT_RING). The aligned slots are bound to the output tensors with
+ * the custom allocation, so that the interpreter writes the output into the
+ * buffer passed downstream, without allocating the output or copying it from
+ * the arena with XNNPACK. tensor_filter waits for downstream to release a slot
+ * if all slots are in use.
  */
 
 #include <algorithm>
+#include <functional>
 #include <limits.h>
+#include <memory>
+#include <stdlib.h>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
@@ -75,6 +100,18 @@
 #  endif
 #endif
 
+/**
+ * @brief Custom allocation of tensor is available since tflite v2.5.0.
+ */
+#if (TFLITE_VERSION_MAJOR > 2) || (TFLITE_VERSION_MAJOR == 2 && TFLITE_VERSION_MINOR >= 5)
+#define TFLITE_CUSTOM_ALLOCATION_SUPPORTED 1
+#endif
+
+/**
+ * @brief Alignment of the memory bound to the tensor (kDefaultTensorAlignment of tflite).
+ */
+#define TFLITE_TENSOR_ALIGNMENT (64)
+
 #if !defined(TFLITE_SUBPLUGIN_NAME)
 #warning "The sub-plugin name for tensorflow-lite is not defined."
 #define TFLITE_SUBPLUGIN_NAME "tensorflow-lite"
@@ -107,6 +144,8 @@ typedef struct {
   const gchar *accelerators; /**< accelerators set for this subplugin */
   tflite_delegate_e delegate; /**< tensorflow-lite delegate */
   gint num_threads; /**< the number of threads */
+  gint num_interpreters; /**< the number of interpreters sharing the model */
+  gint num_output_slots; /**< the number of slots in the output ring (0 not to provide the ring) */
 } tflite_option_s;
 
 /**
@@ -122,12 +161,32 @@ static const gchar *tflite_accl_auto = ACCL_CPU_STR;
 #endif
 static const gchar *tflite_accl_default = ACCL_CPU_STR;
 
+/**
+ * @brief The memory bound to the tensor with the custom allocation.
+ */
+typedef struct {
+  void *bound; /**< The memory the tensor points to, after binding with the custom allocation (nullptr if not bound) */
+} tflite_tensor_binding_s;
+
+/**
+ * @brief The ring of output buffers given to tensor_filter, valid until tensor_filter releases it.
+ */
+typedef struct {
+  unsigned int num_slots; /**< The number of slots */
+  GstTensorMemory *slots; /**< The output tensors of each slot (NNS_TENSOR_SIZE_LIMIT tensors for each slot) */
+} tflite_output_ring_s;
+
 static GstTensorFilterFrameworkStatistics tflite_internal_stats = {
   .total_invoke_num = 0,
   .total_invoke_latency = 0,
   .total_overhead_latency = 0,
 };
 
+/**
+ * @brief Lock for the statistics, the interpreters may be invoked at once.
+ */
+G_LOCK_DEFINE_STATIC (tflite_stats);
+
 /**
  * @brief Wrapper class for TFLite Interpreter to support model switching
  */
@@ -138,7 +197,8 @@ class TFLiteInterpreter
   ~TFLiteInterpreter ();
 
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
-  int loadModel (int num_threads, tflite_delegate_e delegate);
+  int loadModel (int num_threads, tflite_delegate_e delegate,
+      std::shared_ptr<tflite::FlatBufferModel> shared_model = nullptr);
 
   int setInputTensorProp ();
   int setOutputTensorProp ();
@@ -181,6 +241,28 @@ class TFLiteInterpreter
     delegate_ = delegate;
   }
 
+  /** @brief get the model to build other interpreters */
+  std::shared_ptr<tflite::FlatBufferModel> getModel ()
+  {
+    return model;
+  }
+
+  /** @brief get the number of invokes of this interpreter */
+  int64_t getInvokeNum ()
+  {
+    return invoke_num;
+  }
+  /** @brief get the total invoke latency (usec) of this interpreter */
+  int64_t getInvokeLatency ()
+  {
+    return invoke_latency;
+  }
+  /** @brief get the number of invokes without copying the input and output */
+  int64_t getZeroCopyNum ()
+  {
+    return zero_copy_num;
+  }
+
   private:
   GMutex mutex;
   char *model_path;
@@ -188,7 +270,24 @@ class TFLiteInterpreter
   bool is_xnnpack_delegated; /**< To check if XNNPACK delegate is used */
 
   std::unique_ptr<tflite::Interpreter> interpreter;
-  std::unique_ptr<tflite::FlatBufferModel> model;
+  std::shared_ptr<tflite::FlatBufferModel> model; /**< The model, shared by the interpreters of the core */
+
+  int64_t invoke_num; /**< The number of invokes of this interpreter */
+  int64_t invoke_latency; /**< The total invoke latency (usec) of this interpreter */
+  int64_t zero_copy_num; /**< The number of invokes without copying the input and output */
+
+  int load_num_threads; /**< The number of threads given when loading the model */
+  tflite_delegate_e load_delegate; /**< The delegate given when loading the model */
+
+  bool use_custom_allocation; /**< To bind the memory of tensor_filter with the custom allocation */
+  std::vector<tflite_tensor_binding_s> inputBinding; /**< The memory bound to each input tensor */
+  std::vector<tflite_tensor_binding_s> outputBinding; /**< The memory bound to each output tensor */
+
+  bool isBindable (int tensor_idx, const void *data, size_t size);
+  int bindTensor (int tensor_idx, tflite_tensor_binding_s &binding,
+      void *data, size_t size, bool &need_allocate);
+  int bindInOutTensors (const GstTensorMemory *input, GstTensorMemory *output, bool &zero_copy);
+  void clearBinding ();
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
@@ -234,16 +333,28 @@ class TFLiteCore
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
   /** @brief cache input and output tensor ptr before invoke */
   int cacheInOutTensorPtr ();
+  gchar *getInterpreterStats ();
+  int getOutputRing (GstTensorFilterFrameworkEventData *data);
 
   private:
   int num_threads;
+  int num_interpreters;
+  int num_output_slots;
   accl_hw accelerator;
   tflite_delegate_e delegate;
 
   TFLiteInterpreter *interpreter;
   TFLiteInterpreter *interpreter_sub;
 
+  std::vector<TFLiteInterpreter *> extra_interpreters; /**< The interpreters sharing the model with the main one */
+  std::vector<TFLiteInterpreter *> idle_interpreters; /**< The interpreters not invoking */
+  GMutex pool_lock; /**< The lock for the interpreters, the idle interpreters and the main one replaced while reloading */
+  GCond pool_cond; /**< The condition to wait for an idle interpreter */
+
   void setAccelerator (const char *accelerators, tflite_delegate_e d);
+  std::vector<TFLiteInterpreter *> buildExtraInterpreters (TFLiteInterpreter *base);
+  int forEachInterpreter (std::function<int (TFLiteInterpreter *)> func);
+  void logInterpreterStats ();
 };
 
 extern "C" {
@@ -267,6 +378,19 @@ TFLiteInterpreter::TFLiteInterpreter ()
 
   is_cached_after_first_invoke = false;
   is_xnnpack_delegated = false;
+
+  invoke_num = 0;
+  invoke_latency = 0;
+  zero_copy_num = 0;
+
+  load_num_threads = -1;
+  load_delegate = TFLITE_DELEGATE_NONE;
+
+#ifdef TFLITE_CUSTOM_ALLOCATION_SUPPORTED
+  use_custom_allocation = true;
+#else
+  use_custom_allocation = false;
+#endif
 }
 
 /**
@@ -274,6 +398,8 @@ TFLiteInterpreter::TFLiteInterpreter ()
  */
 TFLiteInterpreter::~TFLiteInterpreter ()
 {
+  clearBinding ();
+
   g_mutex_clear (&mutex);
   g_free (model_path);
 
@@ -281,50 +407,199 @@ TFLiteInterpreter::~TFLiteInterpreter ()
   gst_tensors_info_free (&outputTensorMeta);
 }
 
+/**
+ * @brief Forget the memory bound to the tensors, the tensors are bound again at next invoke.
+ */
+void
+TFLiteInterpreter::clearBinding ()
+{
+  inputBinding.clear ();
+  outputBinding.clear ();
+}
+
+/**
+ * @brief Check the memory can be bound to the tensor with the custom allocation.
+ */
+bool
+TFLiteInterpreter::isBindable (int tensor_idx, const void *data, size_t size)
+{
+  TfLiteTensor *tensor_ptr = interpreter->tensor (tensor_idx);
+
+  /* tflite requires the aligned memory for the custom allocation */
+  return (data != nullptr && size >= tensor_ptr->bytes
+          && ((uintptr_t) data % TFLITE_TENSOR_ALIGNMENT) == 0);
+}
+
+/**
+ * @brief Bind the aligned memory to the tensor with the custom allocation.
+ * @param tensor_idx the index of tensor in the interpreter
+ * @param binding the memory bound to the tensor
+ * @param data the memory of tensor_filter
+ * @param size the size of memory
+ * @param[out] need_allocate set true if the tensors should be allocated again
+ * @return 0 if the memory is bound, negative value if failed.
+ */
+int
+TFLiteInterpreter::bindTensor (int tensor_idx, tflite_tensor_binding_s &binding,
+    void *data, size_t size, bool &need_allocate)
+{
+#ifdef TFLITE_CUSTOM_ALLOCATION_SUPPORTED
+  TfLiteCustomAllocation allocation;
+
+  allocation.data = data;
+  allocation.bytes = size;
+
+  if (allocation.data != binding.bound) {
+    if (interpreter->SetCustomAllocationForTensor (tensor_idx, allocation) != kTfLiteOk)
+      return -EINVAL;
+
+    /* the tensor was allocated in the arena, the plan should be updated */
+    if (binding.bound == nullptr)
+      need_allocate = true;
+    binding.bound = allocation.data;
+  }
+
+  return 0;
+#else
+  return -ENOENT;
+#endif
+}
+
+/**
+ * @brief Bind the input and output memory to the tensors if all of them are aligned.
+ * @param[out] zero_copy set true if all input and output are bound, false if the raw pointers should be updated
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteInterpreter::bindInOutTensors (
+    const GstTensorMemory *input, GstTensorMemory *output, bool &zero_copy)
+{
+  bool need_allocate = false;
+  unsigned int i;
+  int ret;
+
+  zero_copy = false;
+
+  for (i = 0; i < inputTensorMeta.num_tensors; ++i) {
+    if (!isBindable (interpreter->inputs ()[i], input[i].data, input[i].size))
+      return 0;
+  }
+
+  for (i = 0; i < outputTensorMeta.num_tensors; ++i) {
+    if (!isBindable (interpreter->outputs ()[i], output[i].data, output[i].size))
+      return 0;
+  }
+
+  if (inputBinding.size () != inputTensorMeta.num_tensors
+      || outputBinding.size () != outputTensorMeta.num_tensors) {
+    clearBinding ();
+    inputBinding.resize (inputTensorMeta.num_tensors, { nullptr });
+    outputBinding.resize (outputTensorMeta.num_tensors, { nullptr });
+  }
+
+  for (i = 0; i < inputTensorMeta.num_tensors; ++i) {
+    ret = bindTensor (interpreter->inputs ()[i], inputBinding[i], input[i].data,
+        input[i].size, need_allocate);
+    if (ret < 0)
+      return ret;
+  }
+
+  for (i = 0; i < outputTensorMeta.num_tensors; ++i) {
+    ret = bindTensor (interpreter->outputs ()[i], outputBinding[i],
+        output[i].data, output[i].size, need_allocate);
+    if (ret < 0)
+      return ret;
+  }
+
+  if (need_allocate && interpreter->AllocateTensors () != kTfLiteOk)
+    return -EPERM;
+
+  zero_copy = true;
+  return 0;
+}
+
+/**
+ * @brief Update the raw pointer of the tensor, and the memory bound to the tensor if it is not in the arena.
+ */
+static inline void
+setTensorRawPtr (TfLiteTensor *tensor_ptr,
+    std::vector<tflite_tensor_binding_s> &binding, unsigned int idx, void *data)
+{
+  tensor_ptr->data.raw = (char *) data;
+
+  if (idx < binding.size () && binding[idx].bound != nullptr)
+    binding[idx].bound = data;
+}
+
 /**
  * @brief Internal implementation of TFLiteCore's invoke()
  */
 int
 TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
-  int64_t start_time, stop_time;
+  int64_t start_time, stop_time, overhead_latency;
   TfLiteTensor *tensor_ptr;
   TfLiteStatus status;
+  bool zero_copy = false;
 
   start_time = g_get_monotonic_time ();
 
   /**
-   * When XNNPACK Delegate is used, we should not assign other buffer as ptr of output tensor data.
-   * The output data should be memcpy-ed from interpreter's output tensors.
+   * Bind the memory of tensor_filter to the tensors with the custom allocation,
+   * so that the interpreter (and the delegates) reads the input and writes the
+   * output directly. If the memory is not aligned, the raw pointer is updated.
    */
-  if (!is_xnnpack_delegated) {
+  if (use_custom_allocation && bindInOutTensors (input, output, zero_copy) != 0) {
+    ml_logw ("Failed to bind the tensor memory with the custom allocation, fallback to the raw pointer.");
+    use_custom_allocation = false;
+    zero_copy = false;
+  }
+
+  if (!zero_copy) {
+    /**
+     * When XNNPACK Delegate is used, we should not assign other buffer as ptr of output tensor data.
+     * The output data should be memcpy-ed from interpreter's output tensors.
+     * The tensor bound with the custom allocation is not in the arena, it points to the output.
+     */
     for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
-      tensor_ptr = outputTensorPtr[i];
-      tensor_ptr->data.raw = (char *) output[i].data;
+      if (!is_xnnpack_delegated
+          || (i < outputBinding.size () && outputBinding[i].bound != nullptr)) {
+        tensor_ptr = outputTensorPtr[i];
+        setTensorRawPtr (tensor_ptr, outputBinding, i, output[i].data);
+      }
     }
-  }
 
-  for (unsigned int i = 0; i < inputTensorMeta.num_tensors; ++i) {
-    tensor_ptr = inputTensorPtr[i];
-    tensor_ptr->data.raw = (char *) input[i].data;
+    for (unsigned int i = 0; i < inputTensorMeta.num_tensors; ++i) {
+      tensor_ptr = inputTensorPtr[i];
+      setTensorRawPtr (tensor_ptr, inputBinding, i, input[i].data);
+    }
   }
   stop_time = g_get_monotonic_time ();
 
-  tflite_internal_stats.total_overhead_latency += stop_time - start_time;
+  overhead_latency = stop_time - start_time;
 
   start_time = g_get_monotonic_time ();
   status = interpreter->Invoke ();
 
-  if (is_xnnpack_delegated) {
+  if (!zero_copy && is_xnnpack_delegated) {
     for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
-      memcpy (output[i].data, outputTensorPtr[i]->data.raw, output[i].size);
+      if (outputTensorPtr[i]->data.raw != (char *) output[i].data)
+        memcpy (output[i].data, outputTensorPtr[i]->data.raw, output[i].size);
     }
   }
 
   stop_time = g_get_monotonic_time ();
 
+  G_LOCK (tflite_stats);
+  tflite_internal_stats.total_overhead_latency += overhead_latency;
   tflite_internal_stats.total_invoke_latency += stop_time - start_time;
   tflite_internal_stats.total_invoke_num += 1;
+  G_UNLOCK (tflite_stats);
+
+  invoke_latency += stop_time - start_time;
+  invoke_num += 1;
+  if (zero_copy)
+    zero_copy_num += 1;
 
 #if (DBG)
   ml_logi ("Invoke() is finished: %" G_GINT64_FORMAT "ms, model path: %s",
@@ -334,6 +609,8 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
       tflite_internal_stats.total_invoke_num,
       (tflite_internal_stats.total_invoke_latency / tflite_internal_stats.total_invoke_num),
       tflite_internal_stats.total_overhead_latency);
+  ml_logi ("%" G_GINT64_FORMAT " of %" G_GINT64_FORMAT " invokes without copying the tensors",
+      zero_copy_num, invoke_num);
 #endif
 
   if (status != kTfLiteOk) {
@@ -352,19 +629,61 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   return 0;
 }
 
+/**
+ * @brief Build the model from the model file mapped and shared in the process.
+ * @return The model which releases the mapping when it is destroyed. nullptr if the file cannot be mapped.
+ * @note The instances opening the same model file share the mapped data, instead of mapping the file for each instance.
+ */
+static std::shared_ptr<tflite::FlatBufferModel>
+buildSharedModel (const char *path)
+{
+  const void *data;
+  size_t size;
+
+  data = nnstreamer_filter_model_file_ref (path, &size);
+  if (data == nullptr)
+    return nullptr;
+
+  std::unique_ptr<tflite::FlatBufferModel> model
+      = tflite::FlatBufferModel::BuildFromBuffer (static_cast<const char *> (data), size);
+  if (!model) {
+    nnstreamer_filter_model_file_unref (data);
+    return nullptr;
+  }
+
+  return std::shared_ptr<tflite::FlatBufferModel> (
+      model.release (), [data] (tflite::FlatBufferModel *m) {
+        delete m;
+        nnstreamer_filter_model_file_unref (data);
+      });
+}
+
 /**
  * @brief Internal implementation of TFLiteCore's loadModel()
+ * @param shared_model the model loaded by other interpreter (nullptr to load the model file)
  * @return 0 if OK. non-zero if error.
  */
 int
-TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate)
+TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate,
+    std::shared_ptr<tflite::FlatBufferModel> shared_model)
 {
 #if (DBG)
   gint64 start_time, stop_time;
   start_time = g_get_monotonic_time ();
 #endif
 
-  model = tflite::FlatBufferModel::BuildFromFile (model_path);
+  load_num_threads = num_threads;
+  load_delegate = delegate;
+
+  if (shared_model) {
+    model = shared_model;
+  } else {
+    model = buildSharedModel (model_path);
+    if (!model) {
+      ml_logw ("Failed to load the shared model file, load it without sharing.");
+      model = tflite::FlatBufferModel::BuildFromFile (model_path);
+    }
+  }
   if (!model) {
     ml_loge ("Failed to mmap model\n");
     return -1;
@@ -397,18 +716,24 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate)
     case TFLITE_DELEGATE_XNNPACK:
     {
 #ifdef TFLITE_XNNPACK_DELEGATE_SUPPORTED
-      /* set xnnpack delegate */
+      /**
+       * set xnnpack delegate, the thread pool of delegate runs with the number of threads (NumThreads).
+       * The delegate is not shared, each interpreter of the core builds its own one with the divided threads.
+       */
       TfLiteXNNPackDelegateOptions xnnpack_options =
           TfLiteXNNPackDelegateOptionsDefault();
       xnnpack_options.num_threads = (num_threads > 1) ? num_threads : 0;
+      ml_logi ("Set XNNPACK delegate with %d threads", xnnpack_options.num_threads);
 
       xnnpack_delegate.reset (TfLiteXNNPackDelegateCreate (&xnnpack_options));
       setDelegate (xnnpack_delegate.get ());
       is_xnnpack_delegated = true;
+#ifndef TFLITE_CUSTOM_ALLOCATION_SUPPORTED
       ml_logw ("Output tensors should be memcpy-ed rather than explictly assigning its ptr when XNNPACK Delegate is used.");
       ml_logw ("This could cause performance degradation if sizes of output tensors are large");
+#endif
 #else
-      ml_logw ("XNNPACK delegate support is available only in Android with tflite v2.3.0 or higher and XNNPACK support should be enabled for tf-lite subplugin build.");
+      ml_logw ("XNNPACK delegate support is not enabled in this build. It requires tflite v2.3.0 or higher built with XNNPACK (meson option tflite2-xnnpack-delegate-support).");
 #endif
       break;
     }
@@ -601,6 +926,8 @@ int
 TFLiteInterpreter::setInputTensorsInfo (const GstTensorsInfo *info)
 {
   TfLiteStatus status = kTfLiteOk;
+  bool bound = (!inputBinding.empty () || !outputBinding.empty ());
+
   const std::vector<int> &input_idx_list = interpreter->inputs ();
 
   /** Cannot change the number of inputs */
@@ -648,9 +975,24 @@ TFLiteInterpreter::setInputTensorsInfo (const GstTensorsInfo *info)
   }
 
   status = interpreter->AllocateTensors ();
-  if (status != kTfLiteOk)
-    return -EPERM;
+  if (status != kTfLiteOk) {
+    /**
+     * The custom allocations cannot be released from the interpreter, and may be
+     * smaller than the resized tensors. Only in this case, build the interpreter
+     * again with the model.
+     */
+    if (!bound)
+      return -EPERM;
+
+    clearBinding ();
+    if (loadModel (load_num_threads, load_delegate, model) != 0)
+      return -EPERM;
 
+    return setInputTensorsInfo (info);
+  }
+
+  /* the tensors are bound again with the memory of new size */
+  clearBinding ();
   return 0;
 }
 
@@ -714,10 +1056,15 @@ fail_exit:
 TFLiteCore::TFLiteCore ()
 {
   num_threads = -1;
+  num_interpreters = 1;
+  num_output_slots = 0;
   accelerator = ACCL_NONE;
   delegate = TFLITE_DELEGATE_NONE;
   interpreter_sub = nullptr;
   interpreter = new TFLiteInterpreter ();
+
+  g_mutex_init (&pool_lock);
+  g_cond_init (&pool_cond);
 }
 
 /**
@@ -725,7 +1072,119 @@ TFLiteCore::TFLiteCore ()
  */
 TFLiteCore::~TFLiteCore ()
 {
+  logInterpreterStats ();
+
+  for (auto extra : extra_interpreters)
+    delete extra;
   delete interpreter;
+
+  g_mutex_clear (&pool_lock);
+  g_cond_clear (&pool_cond);
+}
+
+/**
+ * @brief	Build the interpreters sharing the model with the main interpreter.
+ * @return the interpreters, which may be less than requested if failed.
+ */
+std::vector<TFLiteInterpreter *>
+TFLiteCore::buildExtraInterpreters (TFLiteInterpreter *base)
+{
+  std::vector<TFLiteInterpreter *> extras;
+
+  for (int i = 1; i < num_interpreters; i++) {
+    TFLiteInterpreter *extra = new TFLiteInterpreter ();
+
+    extra->setModelPath (base->getModelPath ());
+    if (extra->loadModel (num_threads, delegate, base->getModel ()) != 0
+        || extra->setInputTensorProp () != 0 || extra->setOutputTensorProp () != 0
+        || extra->cacheInOutTensorPtr () != 0) {
+      ml_logw ("Failed to build the interpreter %d, use %d interpreters.", i, i);
+      delete extra;
+      break;
+    }
+
+    extras.push_back (extra);
+  }
+
+  return extras;
+}
+
+/**
+ * @brief	Call the function with each interpreter (the main one first), holding its lock.
+ * @return 0 if OK. The error of the function if failed.
+ */
+int
+TFLiteCore::forEachInterpreter (std::function<int (TFLiteInterpreter *)> func)
+{
+  int err;
+
+  g_mutex_lock (&pool_lock);
+  interpreter->lock ();
+  err = func (interpreter);
+  interpreter->unlock ();
+
+  for (auto extra : extra_interpreters) {
+    if (err != 0)
+      break;
+
+    extra->lock ();
+    err = func (extra);
+    extra->unlock ();
+  }
+  g_mutex_unlock (&pool_lock);
+
+  return err;
+}
+
+/**
+ * @brief	Print the latency and the number of zero-copy invokes of each interpreter.
+ */
+void
+TFLiteCore::logInterpreterStats ()
+{
+  unsigned int i;
+
+  g_mutex_lock (&pool_lock);
+  for (i = 0; i <= extra_interpreters.size (); i++) {
+    TFLiteInterpreter *it = (i == 0) ? interpreter : extra_interpreters[i - 1];
+    int64_t num = it->getInvokeNum ();
+
+    if (num == 0)
+      continue;
+
+    ml_logi ("Interpreter %u: %" G_GINT64_FORMAT " invokes (%" G_GINT64_FORMAT
+        " without copying the tensors), average latency %" G_GINT64_FORMAT " usec",
+        i, num, it->getZeroCopyNum (), it->getInvokeLatency () / num);
+  }
+  g_mutex_unlock (&pool_lock);
+}
+
+/**
+ * @brief	Get the invokes, the average latency (usec) and the zero-copy invokes of each interpreter.
+ * @return the newly allocated string, the caller should free it.
+ */
+gchar *
+TFLiteCore::getInterpreterStats ()
+{
+  GString *stats = g_string_new (NULL);
+  unsigned int idx = 0;
+
+  g_string_append_printf (stats, "threads=%d", num_threads);
+
+  forEachInterpreter ([&] (TFLiteInterpreter *it) {
+    int64_t num = it->getInvokeNum ();
+
+    g_string_append_printf (stats,
+        ",interpreter%u-invokes=%" G_GINT64_FORMAT
+        ",interpreter%u-avg-latency=%" G_GINT64_FORMAT
+        ",interpreter%u-zero-copy=%" G_GINT64_FORMAT,
+        idx, num, idx, (num > 0) ? it->getInvokeLatency () / num : 0,
+        idx, it->getZeroCopyNum ());
+    idx++;
+    return 0;
+  });
+
+  return g_string_free (stats, FALSE);
 }
 
 /**
@@ -769,6 +1228,18 @@ TFLiteCore::init (tflite_option_s *option)
 {
   interpreter->setModelPath (option->model_file);
   num_threads = option->num_threads;
+  num_interpreters = MAX (option->num_interpreters, 1);
+  num_output_slots = MAX (option->num_output_slots, 0);
+
+  /* the interpreters run at once, share the threads not to oversubscribe the cores */
+  if (num_interpreters > 1) {
+    int budget = (num_threads > 0) ?
+        num_threads : static_cast<int> (std::thread::hardware_concurrency ());
+
+    num_threads = MAX (budget / num_interpreters, 1);
+    ml_logi ("Set the number of threads (%d) for each of %d interpreters",
+        num_threads, num_interpreters);
+  }
 
   setAccelerator (option->accelerators, option->delegate);
   g_message ("accl = %s", get_accl_hw_str (accelerator));
@@ -789,6 +1260,20 @@ TFLiteCore::init (tflite_option_s *option)
     ml_loge ("Failed to cache input and output tensors storage\n");
     return -4;
   }
+
+  std::vector<TFLiteInterpreter *> extras = buildExtraInterpreters (interpreter);
+
+  g_mutex_lock (&pool_lock);
+  extra_interpreters = extras;
+  idle_interpreters.clear ();
+  idle_interpreters.push_back (interpreter);
+  idle_interpreters.insert (idle_interpreters.end (),
+      extra_interpreters.begin (), extra_interpreters.end ());
+  g_mutex_unlock (&pool_lock);
+
+  if (num_interpreters > 1)
+    ml_logi ("Use %zu interpreters sharing the model.", extras.size () + 1);
+
   return 0;
 }
 
@@ -832,13 +1317,8 @@ TFLiteCore::loadModel ()
 int
 TFLiteCore::setInputTensorProp ()
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->setInputTensorProp ();
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter (
+      [] (TFLiteInterpreter *it) { return it->setInputTensorProp (); });
 }
 
 /**
@@ -848,13 +1328,8 @@ TFLiteCore::setInputTensorProp ()
 int
 TFLiteCore::setOutputTensorProp ()
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->setOutputTensorProp ();
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter (
+      [] (TFLiteInterpreter *it) { return it->setOutputTensorProp (); });
 }
 
 /**
@@ -898,13 +1373,8 @@ TFLiteCore::getOutputTensorDim (GstTensorsInfo *info)
 int
 TFLiteCore::setInputTensorDim (const GstTensorsInfo *info)
 {
-  int err;
-
-  interpreter->lock ();
-  err = interpreter->setInputTensorsInfo (info);
-  interpreter->unlock ();
-
-  return err;
+  return forEachInterpreter (
+      [info] (TFLiteInterpreter *it) { return it->setInputTensorsInfo (info); });
 }
 
 /**
@@ -919,7 +1389,7 @@ int
 TFLiteCore::reloadModel (const char *_model_path)
 {
   int err;
-  TFLiteInterpreter * interpreter_temp = interpreter;
+  TFLiteInterpreter *interpreter_temp;
 
   if (!g_file_test (_model_path, G_FILE_TEST_IS_REGULAR)) {
     ml_loge ("The path of model file(s), %s, to reload is invalid.", _model_path);
@@ -963,9 +1433,27 @@ TFLiteCore::reloadModel (const char *_model_path)
     return err;
   }
 
-  interpreter_temp->lock ();
+  std::vector<TFLiteInterpreter *> extras_sub = buildExtraInterpreters (interpreter_sub);
+  std::vector<TFLiteInterpreter *> extras_temp;
+
+  /* wait until all interpreters are idle, then replace the pool */
+  g_mutex_lock (&pool_lock);
+  while (idle_interpreters.size () < extra_interpreters.size () + 1)
+    g_cond_wait (&pool_cond, &pool_lock);
+
+  interpreter_temp = interpreter;
+  extras_temp = extra_interpreters;
   interpreter = interpreter_sub;
-  interpreter_temp->unlock ();
+  extra_interpreters = extras_sub;
+
+  idle_interpreters.clear ();
+  idle_interpreters.push_back (interpreter);
+  idle_interpreters.insert (idle_interpreters.end (),
+      extra_interpreters.begin (), extra_interpreters.end ());
+  g_mutex_unlock (&pool_lock);
+
+  for (auto extra : extras_temp)
+    delete extra;
   delete interpreter_temp;
 
   return err;
@@ -980,11 +1468,25 @@ TFLiteCore::reloadModel (const char *_model_path)
 int
 TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
+  TFLiteInterpreter *it;
   int err;
 
-  interpreter->lock ();
-  err = interpreter->invoke (input, output);
-  interpreter->unlock ();
+  /* check out an idle interpreter, the pool is replaced while reloading the model */
+  g_mutex_lock (&pool_lock);
+  while (idle_interpreters.empty ())
+    g_cond_wait (&pool_cond, &pool_lock);
+  it = idle_interpreters.back ();
+  idle_interpreters.pop_back ();
+  g_mutex_unlock (&pool_lock);
+
+  it->lock ();
+  err = it->invoke (input, output);
+  it->unlock ();
+
+  g_mutex_lock (&pool_lock);
+  idle_interpreters.push_back (it);
+  g_cond_broadcast (&pool_cond);
+  g_mutex_unlock (&pool_lock);
 
   return err;
 }
@@ -995,13 +1497,82 @@ TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 int
 TFLiteCore::cacheInOutTensorPtr ()
 {
+  return forEachInterpreter (
+      [] (TFLiteInterpreter *it) { return it->cacheInOutTensorPtr (); });
+}
+
+/**
+ * @brief Free the output ring, called by tensor_filter when all slots are released.
+ */
+static void
+tflite_releaseOutputRing (void *ring_data)
+{
+  tflite_output_ring_s *ring = static_cast<tflite_output_ring_s *> (ring_data);
+
+  for (unsigned int i = 0; i < ring->num_slots * NNS_TENSOR_SIZE_LIMIT; i++)
+    free (ring->slots[i].data);
+
+  g_free (ring->slots);
+  g_free (ring);
+}
+
+/**
+ * @brief	Allocate the ring of output buffers with the output tensor info.
+ * @param[out] data The ring for GET_OUTPUT_RING event
+ * @return 0 if OK. -ENOENT if the ring is not enabled. Other negative value if failed.
+ * @note The slots are aligned, so that the output tensors are bound to them with the custom allocation.
+ *       The ring does not belong to this core, it is valid after the core is closed.
+ */
+int
+TFLiteCore::getOutputRing (GstTensorFilterFrameworkEventData *data)
+{
+#ifdef TFLITE_CUSTOM_ALLOCATION_SUPPORTED
+  tflite_output_ring_s *ring;
+  GstTensorMemory *t;
+  GstTensorsInfo info;
+  unsigned int n, i;
   int err;
 
-  interpreter->lock ();
-  err = interpreter->cacheInOutTensorPtr ();
-  interpreter->unlock ();
+  if (num_output_slots <= 0)
+    return -ENOENT;
+
+  gst_tensors_info_init (&info);
+  err = getOutputTensorDim (&info);
+  if (err != 0)
+    goto done;
+
+  ring = g_new0 (tflite_output_ring_s, 1);
+  ring->num_slots = num_output_slots;
+  ring->slots = g_new0 (GstTensorMemory, NNS_TENSOR_SIZE_LIMIT * ring->num_slots);
+
+  for (n = 0; n < ring->num_slots; n++) {
+    for (i = 0; i < info.num_tensors; i++) {
+      t = &ring->slots[n * NNS_TENSOR_SIZE_LIMIT + i];
+      t->size = gst_tensor_info_get_size (&info.info[i]);
+
+      if (posix_memalign (&t->data, TFLITE_TENSOR_ALIGNMENT, MAX (t->size, 1)) != 0) {
+        ml_loge ("Failed to allocate the output ring (slot %u, tensor %u).", n, i);
+        t->data = nullptr;
+        tflite_releaseOutputRing (ring);
+        err = -ENOMEM;
+        goto done;
+      }
+    }
+  }
+
+  data->num_slots = ring->num_slots;
+  data->slots = ring->slots;
+  data->release_slot = nullptr;
+  data->release_ring = tflite_releaseOutputRing;
+  data->ring_data = ring;
 
+done:
+  gst_tensors_info_free (&info);
   return err;
+#else
+  ml_logw ("The output ring requires the custom allocation of tflite v2.5.0 or higher.");
+  return -ENOENT;
+#endif
 }
 
 /**
@@ -1017,6 +1588,8 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
   option->accelerators = prop->accl_str;
   option->delegate = TFLITE_DELEGATE_NONE;
   option->num_threads = -1;
+  option->num_interpreters = 1;
+  option->num_output_slots = 0;
 
   if (prop->custom_properties) {
     gchar **strv;
@@ -1034,6 +1607,18 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
 
         if (g_ascii_strcasecmp (pair[0], "NumThreads") == 0) {
           option->num_threads = (int)g_ascii_strtoll (pair[1], NULL, 10);
+        } else if (g_ascii_strcasecmp (pair[0], "NumInterpreters") == 0) {
+          option->num_interpreters = (int)g_ascii_strtoll (pair[1], NULL, 10);
+          if (option->num_interpreters < 1) {
+            ml_logw ("Invalid number of interpreters (%s), use 1.", pair[1]);
+            option->num_interpreters = 1;
+          }
+        } else if (g_ascii_strcasecmp (pair[0], "OutputRing") == 0) {
+          option->num_output_slots = (int)g_ascii_strtoll (pair[1], NULL, 10);
+          if (option->num_output_slots < 0) {
+            ml_logw ("Invalid number of output slots (%s), the ring is disabled.", pair[1]);
+            option->num_output_slots = 0;
+          }
         } else if (g_ascii_strcasecmp (pair[0], "Delegate") == 0) {
           if (g_ascii_strcasecmp (pair[1], "NNAPI") == 0)
             option->delegate = TFLITE_DELEGATE_NNAPI;
@@ -1054,6 +1639,10 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
     g_strfreev (strv);
   }
 
+  /* use the cores assigned with cpu-affinity if the number of threads is not given */
+  if (option->num_threads < 0 && prop->num_cpus > 0)
+    option->num_threads = prop->num_cpus;
+
   return 0;
 }
 
@@ -1136,6 +1725,7 @@ tflite_open (const GstTensorFilterProperties *prop, void **private_data)
 
 /**
  * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the framework of the subplugin
  * @param prop property of tensor_filter instance
  * @param private_data : tensorflow lite plugin's private data
  * @param[in] input The array of input tensors
@@ -1143,10 +1733,11 @@ tflite_open (const GstTensorFilterProperties *prop, void **private_data)
  * @return 0 if OK. non-zero if error.
  */
 static int
-tflite_invoke (const GstTensorFilterProperties *prop, void **private_data,
+tflite_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
     const GstTensorMemory *input, GstTensorMemory *output)
 {
-  TFLiteCore *core = static_cast<TFLiteCore *> (*private_data);
+  TFLiteCore *core = static_cast<TFLiteCore *> (private_data);
   g_return_val_if_fail (core && input && output, -EINVAL);
 
   return core->invoke (input, output);
@@ -1281,58 +1872,128 @@ tflite_setInputDim (const GstTensorFilterProperties *prop, void **private_data,
 }
 
 /**
- * @brief The optional callback for GstTensorFilterFramework
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the framework of the subplugin
  * @param prop property of tensor_filter instance
  * @param private_data : tensorflow lite plugin's private data
- * @return 0 if OK. non-zero if error.
+ * @param ops the operation to get or set the tensor info
+ * @param in_info The dimesions and types of input tensors
+ * @param[out] out_info The dimesions and types of output tensors
+ * @return 0 if OK. non-zero if error. -ENOENT if the operation is not supported.
  */
 static int
-tflite_reloadModel (const GstTensorFilterProperties *prop, void **private_data)
+tflite_getModelInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info)
 {
-  TFLiteCore *core = static_cast<TFLiteCore *> (*private_data);
-  g_return_val_if_fail (core, -EINVAL);
+  int status;
 
-  if (prop->num_models != 1)
-    return -1;
+  switch (ops) {
+    case GET_IN_OUT_INFO:
+      status = tflite_getInputDim (prop, &private_data, in_info);
+      if (status == 0)
+        status = tflite_getOutputDim (prop, &private_data, out_info);
+      return status;
+    case SET_INPUT_INFO:
+      return tflite_setInputDim (prop, &private_data, in_info, out_info);
+    default:
+      break;
+  }
 
-  return core->reloadModel (prop->model_files[0]);
+  return -ENOENT;
 }
 
 /**
- * @brief The optional callback for GstTensorFilterFramework
- * @param[in] hw backend accelerator hardware
- * @return 0 if supported. -errno if not supported.
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the framework of the subplugin
+ * @param prop property of tensor_filter instance
+ * @param private_data : tensorflow lite plugin's private data
+ * @param ops the event to run
+ * @param[in/out] data the data of the event (can be NULL)
+ * @return 0 if OK. non-zero if error. -ENOENT if the event is not supported.
  */
 static int
-tflite_checkAvailability (accl_hw hw)
+tflite_eventHandler (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    event_ops ops, GstTensorFilterFrameworkEventData *data)
 {
-  if (g_strv_contains (tflite_accl_support, get_accl_hw_str (hw)))
-    return 0;
+  TFLiteCore *core = static_cast<TFLiteCore *> (private_data);
+
+  switch (ops) {
+    case RELOAD_MODEL:
+      /* tensor_filter checks if the model is updatable without the data */
+      if (!core || !data || data->num_models != 1)
+        return -EINVAL;
+
+      return core->reloadModel (data->model_files[0]);
+    case GET_STATISTICS:
+      if (!core || !data)
+        return -EINVAL;
+
+      data->stats = core->getInterpreterStats ();
+      return 0;
+    case GET_OUTPUT_RING:
+      if (!core || !data)
+        return -EINVAL;
+
+      return core->getOutputRing (data);
+    default:
+      break;
+  }
 
   return -ENOENT;
 }
 
 static gchar filter_subplugin_tensorflow_lite[] = TFLITE_SUBPLUGIN_NAME;
 
+/**
+ * @brief Possible accelerators (see tflite_accl_support).
+ */
+static const accl_hw tflite_hw_list[] = { ACCL_CPU_SIMD, ACCL_CPU, ACCL_GPU, ACCL_NPU };
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param self the framework of the subplugin
+ * @param prop property of tensor_filter instance
+ * @param private_data : tensorflow lite plugin's private data (can be NULL)
+ * @param[out] fw_info the information of the framework
+ * @return 0 if OK. non-zero if error.
+ */
+static int
+tflite_getFrameworkInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  fw_info->name = filter_subplugin_tensorflow_lite;
+  fw_info->allow_in_place = FALSE; /** @todo: support this to optimize performance later. */
+  fw_info->allocate_in_invoke = FALSE;
+  fw_info->run_without_model = FALSE;
+  fw_info->verify_model_path = TRUE;
+  fw_info->hw_list = tflite_hw_list;
+  fw_info->num_hw = G_N_ELEMENTS (tflite_hw_list);
+  fw_info->accl_auto = get_accl_hw_type (tflite_accl_auto);
+  fw_info->accl_default = get_accl_hw_type (tflite_accl_default);
+  fw_info->statistics = &tflite_internal_stats;
+#ifdef TFLITE_CUSTOM_ALLOCATION_SUPPORTED
+  /* the memory of tensor_filter is bound to the tensors if aligned */
+  fw_info->mem_align = TFLITE_TENSOR_ALIGNMENT;
+#else
+  fw_info->mem_align = 0;
+#endif
+
+  return 0;
+}
+
 static GstTensorFilterFramework NNS_support_tensorflow_lite
-    = { .version = GST_TENSOR_FILTER_FRAMEWORK_V0,
+    = { .version = GST_TENSOR_FILTER_FRAMEWORK_V1,
         .open = tflite_open,
         .close = tflite_close,
-        { .v0 = {
-              .name = filter_subplugin_tensorflow_lite,
-              .allow_in_place = FALSE, /** @todo: support this to optimize performance later. */
-              .allocate_in_invoke = FALSE,
-              .run_without_model = FALSE,
-              .verify_model_path = TRUE,
-              .statistics = &tflite_internal_stats,
-              .invoke_NN = tflite_invoke,
-              .getInputDimension = tflite_getInputDim,
-              .getOutputDimension = tflite_getOutputDim,
-              .setInputDimension = tflite_setInputDim,
-              .destroyNotify = nullptr,
-              .reloadModel = tflite_reloadModel,
-              .checkAvailability = tflite_checkAvailability,
-              .allocateInInvoke = nullptr,
+        { .v1 = {
+              .invoke = tflite_invoke,
+              .getFrameworkInfo = tflite_getFrameworkInfo,
+              .getModelInfo = tflite_getModelInfo,
+              .eventHandler = tflite_eventHandler,
+              .subplugin_data = nullptr,
           } } };
 
 /** @brief Initialize this object for tensor_filter subplugin runtime register */
@@ -1346,5 +2007,5 @@ init_filter_tflite (void)
 void
 fini_filter_tflite (void)
 {
-  nnstreamer_filter_exit (NNS_support_tensorflow_lite.v0.name);
+  nnstreamer_filter_exit (filter_subplugin_tensorflow_lite);
 }
@@ -62,7 +62,10 @@ namespace nnstreamer {
  *         For getInput/Output and setInput, return -EINVAL if you don't
  *        support it.
  *
- *         We support tensor_filter_subplugin V1 only. (NNStreamer 1.5.1 or higher)
+ *         The C wrapper is registered as tensor_filter_subplugin V2,
+ *        which has the same layout with V1. To support the batched invoke,
+ *        derive tensor_filter_subplugin_batch as well.
+ *        Asynchronous invoke (invoke_async) is not supported.
  **/
 class tensor_filter_subplugin {
   private: /** Derived classes should NEVER access these */
@@ -79,8 +82,9 @@ class tensor_filter_subplugin {
     static int cpp_getFrameworkInfo (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, GstTensorFilterFrameworkInfo *fw_info); /**< C V1 wrapper func, getFrameworkInfo */
     static int cpp_getModelInfo (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info); /**< C V1 wrapper func, getModelInfo */
     static int cpp_eventHandler (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, event_ops ops, GstTensorFilterFrameworkEventData *data); /**< C V1 wrapper func, eventHandler */
+    static int cpp_invoke_batch (const GstTensorFilterFramework *tf, const GstTensorFilterProperties *prop, void *private_data, unsigned int num_frames, const GstTensorMemory **input, GstTensorMemory **output); /**< C V2 wrapper func, invoke_batch */
 
-    GstTensorFilterFramework fwdesc; /**< Represents C/V1 wrapper for the derived class and its objects. Derived should not access this anyway; the base class will handle this with the C wrapper functions, base static-functions, and base constructors/destructors. */
+    GstTensorFilterFramework fwdesc; /**< Represents C/V2 wrapper for the derived class and its objects. Derived should not access this anyway; the base class will handle this with the C wrapper functions, base static-functions, and base constructors/destructors. */
 
   protected: /** Derived classes should call these at init/exit */
 /**
@@ -192,6 +196,30 @@ class tensor_filter_subplugin {
           */
 };
 
+/**
+ * @brief Optional interface of tensor_filter_subplugin for the batched invoke.
+ * @details A subplugin derives this together with tensor_filter_subplugin
+ *         to invoke several frames at once. This is separated from
+ *         tensor_filter_subplugin, so that the subplugins built with the
+ *         earlier version keep the same class layout.
+ **/
+class tensor_filter_subplugin_batch {
+  public:
+    virtual ~tensor_filter_subplugin_batch () {}
+
+    virtual int invoke_batch (unsigned int num_frames, const GstTensorMemory **input, GstTensorMemory **output) = 0;
+        /**< Invoke NN with num_frames frames at once.
+          *  input[n] and output[n] are the tensors of the n-th frame,
+          * each of them has the same layout with invoke().
+          *  If num_frames is 0, input and output are NULL. Return 0 if
+          * the opened model supports the batched invoke.
+          *  Return -ENOENT if not supported with the opened model, then
+          *                 the frames are invoked one by one with invoke().
+          *  Return -EINVAL if it is an invalid request.
+          *  Possible exceptions are same with invoke().
+          */
+};
+
 } /* namespace nnstreamer */
 
 #endif /* __cplusplus */
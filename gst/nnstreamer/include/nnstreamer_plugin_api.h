@@ -427,6 +427,40 @@ gst_tensor_get_format_string (tensor_format format);
  */
 extern void gst_tensor_alloc_init (gsize alignment);
 
+/**
+ * @brief Statistics of the pooled tensor allocator.
+ */
+typedef struct
+{
+  guint64 live_bytes; /**< bytes of the blocks in use */
+  guint64 peak_bytes; /**< max bytes of the blocks in use */
+  guint64 pooled_bytes; /**< bytes of the free blocks held in the pool */
+  guint64 trimmed_bytes; /**< bytes of the free blocks released by trimming */
+  guint64 hits; /**< number of allocations with the free block in the pool */
+  guint64 misses; /**< number of allocations with new block */
+} GstTensorAllocStats;
+
+/**
+ * @brief Enable or disable the pooled mode of default tensor allocator.
+ * The pooled allocator keeps the free lists of aligned blocks for each size class.
+ * @param enable TRUE to enable the pooled mode
+ * @param max_bytes max bytes of the free blocks held in the pool
+ * @param low_watermark the pool is trimmed to this size if exceeding max bytes
+ * @param hugepage_threshold min size of the block backed by huge pages (0 to disable)
+ */
+extern void gst_tensor_alloc_set_pool (gboolean enable, gsize max_bytes, gsize low_watermark, gsize hugepage_threshold);
+
+/**
+ * @brief Free all blocks in the free lists of the pooled tensor allocator.
+ */
+extern void gst_tensor_alloc_trim (void);
+
+/**
+ * @brief Get the statistics of the pooled tensor allocator.
+ * @param stats the statistics to be filled
+ */
+extern void gst_tensor_alloc_get_stats (GstTensorAllocStats * stats);
+
 /**
  * @brief Find the index value of the given key string array
  * @return Corresponding index
@@ -517,11 +551,49 @@ gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header);
 extern gboolean
 gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Memory flag to indicate that the area for the header of flexible tensor is reserved in front of the data.
+ */
+#define GST_TENSOR_MEMORY_FLAG_HEADER_ROOM (GST_MEMORY_FLAG_LAST << 0)
+
+/**
+ * @brief Allocate new memory for static tensor, reserving the area for the header of flexible tensor.
+ * @param[in] size the data size
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note gst_tensor_meta_info_append_header() writes the header into the reserved area without copying the data.
+ */
+extern GstMemory *
+gst_tensor_alloc_with_header_room (gsize size);
+
+/**
+ * @brief Allocate new memory for static tensor with given allocator and parameters, reserving the area for the header of flexible tensor.
+ * @param[in] size the data size
+ * @param[in] allocator the allocator to be used (NULL to use the default allocator)
+ * @param[in] params the allocation parameters (e.g., alignment negotiated with allocation query). NULL for default.
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ */
+extern GstMemory *
+gst_tensor_alloc_with_header_room_full (gsize size, GstAllocator * allocator,
+    const GstAllocationParams * params);
+
+/**
+ * @brief Get new memory block from the buffer pool.
+ * @param[in] pool the buffer pool (should be activated)
+ * @param[in] size the data size
+ * @param[in] prefix the size of the area reserved in front of the data, which is configured in the pool
+ * @return Newly wrapped GstMemory, NULL if the pool is exhausted or the size of the pooled buffer is different. The buffer goes back to the pool when the memory is freed.
+ * @note This does not wait for the buffer, caller should allocate new memory if this returns NULL.
+ */
+extern GstMemory *
+gst_tensor_buffer_pool_alloc_memory (GstBufferPool * pool, gsize size,
+    gsize prefix);
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
  * @param[in] mem pointer to GstMemory
  * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note If the area for the header is reserved in front of the data (see gst_tensor_alloc_with_header_room()), this writes the header and shares the memory without copying the data.
  */
 extern GstMemory *
 gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem);
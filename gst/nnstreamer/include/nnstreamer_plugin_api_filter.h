@@ -36,10 +36,11 @@
 #define GST_TENSOR_FILTER_FRAMEWORK_BASE (0xDEAFDEAD00000000ULL)
 #define GST_TENSOR_FILTER_FRAMEWORK_V0 (GST_TENSOR_FILTER_FRAMEWORK_BASE)
 #define GST_TENSOR_FILTER_FRAMEWORK_V1 (GST_TENSOR_FILTER_FRAMEWORK_BASE | 0x10000ULL)
+#define GST_TENSOR_FILTER_FRAMEWORK_V2 (GST_TENSOR_FILTER_FRAMEWORK_BASE | 0x20000ULL)
 
 #define GST_TENSOR_FILTER_API_VERSION_DEFINED (1)
 #define GST_TENSOR_FILTER_API_VERSION_MIN (0)	/* The minimum API version supported (could be obsolete) */
-#define GST_TENSOR_FILTER_API_VERSION_MAX (1)	/* The maximum API version supported (recommended) */
+#define GST_TENSOR_FILTER_API_VERSION_MAX (2)	/* The maximum API version supported (recommended) */
 
 /**
  * @brief Check the value of the version field of GstTensorFilterFramework
@@ -161,6 +162,8 @@ typedef struct _GstTensorFilterProperties
 
   int latency; /**< The average latency over the recent 10 inferences in microseconds */
   int throughput; /**< The average throughput in the number of outputs per second */
+
+  int num_cpus; /**< The number of CPU cores assigned to invoke with cpu-affinity (0 if not assigned). Subplugins may use it as the number of threads. */
 } GstTensorFilterProperties;
 
 /**
@@ -182,7 +185,7 @@ typedef struct _GstTensorFilterFrameworkStatistics
 typedef struct _GstTensorFilterFrameworkInfo
 {
   const char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property. Subplugin is supposed to allocate/deallocate. */
-  int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+  int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. If the input and output sizes are the same and the input buffer is writable, the output tensors point to the input tensors when invoking. */
   int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
   int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
   int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -191,6 +194,7 @@ typedef struct _GstTensorFilterFrameworkInfo
   accl_hw accl_auto;  /**< accelerator to be used in auto mode (acceleration to be used but accelerator is not specified for the filter) - default -1 implies use first entry from hw_list */
   accl_hw accl_default;   /**< accelerator to be used by default (valid user input is not provided) - default -1 implies use first entry from hw_list*/
   const GstTensorFilterFrameworkStatistics *statistics;  /**< usage statistics by the framework. This is shared across all opened instances of this framework */
+  unsigned int mem_align; /**< The alignment (in bytes, power of 2) of the input and output memory for the framework to use it without copying. 0 if not required. Tensor_filter allocates the output and proposes the allocation of the input to upstream with the alignment. */
 } GstTensorFilterFrameworkInfo;
 
 /**
@@ -206,6 +210,8 @@ typedef enum
   SET_INPUT_PROP,   /**< Update input tensor info and layout */
   SET_OUTPUT_PROP,  /**< Update output tensor info and layout */
   SET_ACCELERATOR,  /**< Update accelerator of the subplugin to be used as backend */
+  GET_OUTPUT_RING,  /**< Get the ring of output buffers owned by the subplugin */
+  GET_STATISTICS,   /**< Get the statistics of the subplugin in string */
 } event_ops;
 
 /**
@@ -251,11 +257,32 @@ typedef struct _GstTensorFilterFrameworkEventData
       accl_hw *hw_list;   /**< accelerators supported by framework intersected with the new user provided accelerator preference */
       int num_hw;         /**< number of hardare accelerators in the hw_list supported by the framework */
     };
+
+    /** for GET_OUTPUT_RING event */
+    struct {
+      unsigned int num_slots;   /**< The number of slots in the ring */
+      const GstTensorMemory *slots;   /**< The output tensors of each slot. The i-th output tensor of the n-th slot is slots[n * NNS_TENSOR_SIZE_LIMIT + i]. */
+      void (*release_slot) (void *ring_data, unsigned int slot);  /**< Optional. Called when downstream releases all output tensors of the slot. This may be called in any thread. */
+      void (*release_ring) (void *ring_data);   /**< Optional. Called when tensor_filter does not use the ring anymore and all slots are released. The subplugin may free the slots here. */
+      void *ring_data;          /**< The data to be passed to the callbacks */
+    };
+
+    /** for GET_STATISTICS event */
+    struct {
+      char *stats;  /**< The statistics in string (e.g., key=value pairs separated by comma), allocated by the subplugin with g_malloc. The caller frees it with g_free. */
+    };
   };
 } GstTensorFilterFrameworkEventData;
 
 typedef struct _GstTensorFilterFramework GstTensorFilterFramework;
 
+/**
+ * @brief Callback to notify the completion of asynchronous invoke (API version 2).
+ * @param[in] user_data The user data given with invoke_async.
+ * @param[in] status 0 if OK. > 0 to drop the output. < 0 if error.
+ */
+typedef void (*GstTensorFilterInvokeCallback) (void *user_data, int status);
+
 /**
  * @brief Tensor_Filter Subplugin definition
  *
@@ -268,7 +295,8 @@ struct _GstTensorFilterFramework
   uint64_t version;
   /**< Version of the struct
    * | 32bit (validity check) | 16bit (API version) | 16bit (Subplugin's internal version. Tensor_filter does not case) |
-   * API version will be 0x0 (earlier version (_GstTensorFilterFramework_v0)) or 0x1 (newer version (_GstTensorFilterFramework_v1))
+   * API version will be 0x0 (earlier version (_GstTensorFilterFramework_v0)), 0x1 (newer version (_GstTensorFilterFramework_v1))
+   * or 0x2 (_GstTensorFilterFramework_v1 with the callbacks for version 2)
    */
 
   int (*open) (const GstTensorFilterProperties * prop, void **private_data);
@@ -299,7 +327,7 @@ struct _GstTensorFilterFramework
     struct /** _GstTensorFilterFramework_v0 */
     {
       char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property */
-      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. If the input and output sizes are the same and the input buffer is writable, the output tensors point to the input tensors when invoking. */
       int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
       int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
       int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -459,6 +487,8 @@ struct _GstTensorFilterFramework
        * If ops == SET_INPUT_PROP: tensor_filter will call to update the property of the subplugin. This function will take tensor info and layout as the argument. This operation can update input tensor shape, type, name and layout.
        * If ops == SET_OUTPUT_PROP: tensor_filter will call to update the property of the subplugin. This function will take tensor info and layout as the argument. This operation can update output tensor shape, type, name and layout.
        * If ops == SET_ACCELERATOR: tensor_filter will call to update the property of the subplugin. This function will take accelerator list as the argument. This operation will update the backend to be used by the corresponding subplugin.
+       * If ops == GET_OUTPUT_RING: tensor_filter will call to get the ring of output buffers owned by the subplugin, after the output tensor info is configured. Each slot of the ring has the memory blocks of all output tensors. Tensor_filter hands out a free slot to each invoke (the output tensors point to the slot), wraps the memory blocks without copying, and returns the slot when downstream releases them. If all slots are in use, tensor_filter waits for downstream to release a slot. The slots should be valid until release_ring is called, even if the subplugin is closed. The ring is not used with invoke-cache, parallel instances or the shared model. This is an extension point for the subplugins owning the output memory (e.g., DMA buffers of an accelerator). Tensorflow-lite provides the ring of aligned buffers with the custom option 'OutputRing:N', so that the interpreter writes the output into the slot.
+       * If ops == GET_STATISTICS: tensor_filter will call to get the statistics of the subplugin (e.g., the latency of each interpreter), which are shown with the property 'framework-stats'. The subplugin allocates the string and tensor_filter frees it.
        * List of operations to be supported are optional.
        * Note: In these operations, the argument 'prop' will not contain the updated information, but will be updated after the corresponding operation is succeeded.
        *
@@ -469,6 +499,46 @@ struct _GstTensorFilterFramework
        * @return 0 if OK. non-zero if error. -ENOENT if operation is not supported. -EINVAL if operation is supported but provided arguments are invalid.
        */
       void *subplugin_data; /**< This is used by tensor_filter infrastructure. Subplugin authors should NEVER update this. Only the files in /gst/nnstreamer/tensor_filter/ are allowed to access this. */
+
+      /**
+       * The callbacks below are available with API version 2 (GST_TENSOR_FILTER_FRAMEWORK_V2).
+       * Tensor_filter does not access these with version 0 and 1.
+       */
+      int (*invoke_async) (const GstTensorFilterFramework * self,
+          const GstTensorFilterProperties * prop, void *private_data,
+          const GstTensorMemory * input, GstTensorMemory * output,
+          GstTensorFilterInvokeCallback callback, void *user_data);
+      /**< Optional (v2). Set NULL if not supported. Invoke the given network model asynchronously.
+       * This should return without waiting for the inference, and call the callback with user_data when the output is ready. The callback can be called in any thread, but must be called once for each successful call.
+       * The input and output tensors are valid until the callback is called. Tensor_filter keeps several frames in flight (see the property 'max-inflight') and pushes the output in the order of the input.
+       * Note that 'invoke' is still mandatory for the synchronous case (e.g., single-shot).
+       *
+       * @param[in] prop read-only property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] input The array of input tensors. Allocated and filled by tensor_filter/main
+       * @param[out] output The array of output tensors. Allocated by tensor_filter/main and to be filled by the subplugin. If allocate_in_invoke is TRUE, sub-plugin should allocate the memory block for output tensor. (data in GstTensorMemory)
+       * @param[in] callback The callback to notify the completion of the invoke.
+       * @param[in] user_data The data to be passed to the callback.
+       * @return 0 if the invoke is started. non-zero if error, and the callback will not be called.
+       */
+
+      int (*invoke_batch) (const GstTensorFilterFramework * self,
+          const GstTensorFilterProperties * prop, void *private_data,
+          unsigned int num_frames, const GstTensorMemory ** input,
+          GstTensorMemory ** output);
+      /**< Optional (v2). Set NULL if not supported. Invoke the given network model with several frames at once.
+       * Tensor_filter calls this when micro-batching is enabled (see the property 'batch-size') and the single-shot API calls this when more than one frame is ready, so that the subplugin may amortize the per-call overhead.
+       * Each frame has the tensor info in prop (input_meta and output_meta), the frames are not concatenated.
+       * If num_frames is 0, input and output are NULL and the subplugin should return 0 if it supports the batched invoke with the opened model.
+       * Return -ENOENT if the batched invoke is not supported, then tensor_filter invokes the frames one by one.
+       *
+       * @param[in] prop read-only property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] num_frames The number of frames.
+       * @param[in] input The array of num_frames input tensor sets. input[n] is the array of input tensors of the n-th frame. Allocated and filled by tensor_filter/main
+       * @param[out] output The array of num_frames output tensor sets. output[n] is the array of output tensors of the n-th frame. Allocated by tensor_filter/main and to be filled by the subplugin. If allocate_in_invoke is TRUE, sub-plugin should allocate the memory block for output tensor. (data in GstTensorMemory)
+       * @return 0 if OK. Non-zero if error. -ENOENT if the batched invoke is not supported.
+       */
     }
 #ifdef NO_ANONYMOUS_NESTED_STRUCT
         v1
@@ -509,6 +579,31 @@ nnstreamer_filter_find (const char *name);
 extern void
 nnstreamer_filter_set_custom_property_desc (const char *name, const char *prop, ...);
 
+/**
+ * @brief Map the model file read-only and share the mapping in the process.
+ * @param[in] path The path of the model file.
+ * @param[out] size The size of the mapped data.
+ * @return The mapped data, NULL if the file cannot be mapped. Caller should call nnstreamer_filter_model_file_unref() to release it.
+ * @note The mapping is shared with the key of the path, the file (device and inode), the size and the modified time, so the updated or replaced file is mapped again.
+ *       The sub-plugin which can load the model from the buffer (e.g., flatbuffers) may use this to share the model among the instances.
+ */
+extern const void *
+nnstreamer_filter_model_file_ref (const char *path, size_t *size);
+
+/**
+ * @brief Release the model file mapped with nnstreamer_filter_model_file_ref().
+ * @param[in] data The mapped data.
+ */
+extern void
+nnstreamer_filter_model_file_unref (const void *data);
+
+/**
+ * @brief Get the statistics of the mapped model files.
+ * @return Newly allocated string. Caller should free the returned string.
+ */
+extern char *
+nnstreamer_filter_model_file_stats (void);
+
 /**
  * @brief return accl_hw type from string
  */
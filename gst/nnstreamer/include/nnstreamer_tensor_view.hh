@@ -0,0 +1,305 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer, typed tensor views for C++ filters and elements.
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	nnstreamer_tensor_view.hh
+ * @date	16 Oct 2026
+ * @brief	Header-only typed views of tensor memory with compile-time type dispatch.
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * @details
+ *    C++ filters receive the tensors as raw GstTensorMemory and the element
+ *    type is known only at runtime (tensor_type). Instead of switching on the
+ *    type for each element, dispatch the type once with dispatch_type() and
+ *    write the loop with tensor_view<T, Rank>, so that the compiler generates
+ *    the specialized (and vectorizable) kernel for each type.
+ *
+ *    The dimension is in the order of nnstreamer, the index 0 is the
+ *    innermost dimension (e.g., channel of video, "3:224:224:1").
+ *
+ * @details Usage example
+ *
+ *          int myfilter::invoke (const GstTensorMemory *in, GstTensorMemory *out)
+ *          {
+ *            return nnstreamer::dispatch_type (prop->input_meta.info[0].type,
+ *                [&] (auto tag) {
+ *                  using T = typename decltype (tag)::type;
+ *                  nnstreamer::tensor_view<const T> src (in[0], prop->input_meta.info[0]);
+ *                  nnstreamer::tensor_view<T> dst (out[0], prop->output_meta.info[0]);
+ *
+ *                  for (size_t i = 0; i < src.size (); i++)
+ *                    dst[i] = src[i] * 2;
+ *                  return 0;
+ *                });
+ *          }
+ *
+ * To Packagers:
+ *
+ * This is to be exposed with "nnstreamer-c++-dev"
+ */
+#ifndef __NNS_TENSOR_VIEW_HH__
+#define __NNS_TENSOR_VIEW_HH__
+#ifdef __cplusplus
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdexcept>
+#include <type_traits>
+#include <tensor_typedef.h>
+
+namespace nnstreamer {
+
+/**
+ * @brief Element type of the tensor for given tensor_type.
+ * @detail tensor_type_traits<_NNS_FLOAT32>::type is float.
+ */
+template <tensor_type TT> struct tensor_type_traits;
+
+/**
+ * @brief tensor_type of given element type.
+ * @detail tensor_type_of<float>::value is _NNS_FLOAT32.
+ */
+template <typename T> struct tensor_type_of;
+
+#define NNS_TENSOR_TYPE_TRAITS(tt, ctype) \
+  template <> struct tensor_type_traits<tt> { \
+    typedef ctype type; \
+  }; \
+  template <> struct tensor_type_of<ctype> \
+      : std::integral_constant<tensor_type, tt> { \
+  }
+
+NNS_TENSOR_TYPE_TRAITS (_NNS_INT32, int32_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_UINT32, uint32_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_INT16, int16_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_UINT16, uint16_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_INT8, int8_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_UINT8, uint8_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_FLOAT64, double);
+NNS_TENSOR_TYPE_TRAITS (_NNS_FLOAT32, float);
+NNS_TENSOR_TYPE_TRAITS (_NNS_INT64, int64_t);
+NNS_TENSOR_TYPE_TRAITS (_NNS_UINT64, uint64_t);
+
+#undef NNS_TENSOR_TYPE_TRAITS
+
+/**
+ * @brief Type tag passed to the function of dispatch_type().
+ */
+template <typename T> struct type_tag {
+  typedef T type; /**< element type of the tensor */
+};
+
+/**
+ * @brief Call the function with the type tag of given tensor_type.
+ * @param type the element type of the tensor
+ * @param func the function (e.g., generic lambda) to be called with type_tag<T>
+ * @return the value returned by the function
+ * @exception std::invalid_argument if the type is invalid
+ * @detail The function is instantiated once for each type, so the loop in
+ *         the function is compiled without the type switch per element.
+ */
+template <typename F>
+auto
+dispatch_type (tensor_type type, F &&func)
+    -> decltype (func (type_tag<uint8_t> ()))
+{
+  switch (type) {
+    case _NNS_INT32:
+      return func (type_tag<int32_t> ());
+    case _NNS_UINT32:
+      return func (type_tag<uint32_t> ());
+    case _NNS_INT16:
+      return func (type_tag<int16_t> ());
+    case _NNS_UINT16:
+      return func (type_tag<uint16_t> ());
+    case _NNS_INT8:
+      return func (type_tag<int8_t> ());
+    case _NNS_UINT8:
+      return func (type_tag<uint8_t> ());
+    case _NNS_FLOAT64:
+      return func (type_tag<double> ());
+    case _NNS_FLOAT32:
+      return func (type_tag<float> ());
+    case _NNS_INT64:
+      return func (type_tag<int64_t> ());
+    case _NNS_UINT64:
+      return func (type_tag<uint64_t> ());
+    default:
+      break;
+  }
+
+  throw std::invalid_argument ("Invalid tensor type.");
+}
+
+/**
+ * @brief Typed view of the tensor memory with strides. This does not own the data.
+ * @param T the element type (const-qualified for read-only view)
+ * @param Rank the number of dimensions (up to NNS_TENSOR_RANK_LIMIT)
+ * @detail The strides are in the number of elements. The view of a packed
+ *         tensor has the stride 1 for the innermost dimension, and the
+ *         stride of the dimension i is the product of the dimensions in front of i.
+ */
+template <typename T, unsigned int Rank = NNS_TENSOR_RANK_LIMIT>
+class tensor_view
+{
+  static_assert (Rank > 0 && Rank <= NNS_TENSOR_RANK_LIMIT,
+      "Rank should be in the range of 1 to NNS_TENSOR_RANK_LIMIT.");
+  static_assert (std::is_arithmetic<T>::value,
+      "Element type of tensor should be arithmetic.");
+
+  public:
+  typedef T value_type; /**< element type */
+  static const unsigned int rank = Rank; /**< number of dimensions */
+
+  /**
+   * @brief Create the view of the packed tensor.
+   * @param data the pointer to the first element
+   * @param dim the dimension, the index 0 is the innermost
+   */
+  tensor_view (T *data, const uint32_t (&dim)[Rank]) : data_ (data)
+  {
+    size_t stride = 1;
+
+    for (unsigned int i = 0; i < Rank; i++) {
+      dim_[i] = dim[i];
+      stride_[i] = stride;
+      stride *= dim[i];
+    }
+  }
+
+  /**
+   * @brief Create the view of the tensor with given strides (e.g., padded rows).
+   * @param data the pointer to the first element
+   * @param dim the dimension, the index 0 is the innermost
+   * @param stride the stride of each dimension in the number of elements
+   */
+  tensor_view (T *data, const uint32_t (&dim)[Rank], const size_t (&stride)[Rank])
+      : data_ (data)
+  {
+    for (unsigned int i = 0; i < Rank; i++) {
+      dim_[i] = dim[i];
+      stride_[i] = stride[i];
+    }
+  }
+
+  /**
+   * @brief Create the view of the packed tensor from the tensor memory and info.
+   * @exception std::invalid_argument if the element type is different, the
+   *            dimensions beyond Rank are not 1, or the memory is smaller than the tensor.
+   */
+  tensor_view (const GstTensorMemory &mem, const GstTensorInfo &info)
+      : data_ (static_cast<T *> (mem.data))
+  {
+    size_t stride = 1;
+    unsigned int i;
+
+    if (info.type != tensor_type_of<typename std::remove_cv<T>::type>::value)
+      throw std::invalid_argument ("The element type of tensor is different.");
+
+    for (i = 0; i < Rank; i++) {
+      dim_[i] = info.dimension[i];
+      stride_[i] = stride;
+      stride *= info.dimension[i];
+    }
+
+    for (; i < NNS_TENSOR_RANK_LIMIT; i++) {
+      if (info.dimension[i] > 1)
+        throw std::invalid_argument ("The rank of tensor exceeds the view.");
+    }
+
+    if (mem.data == nullptr || mem.size < stride * sizeof (T))
+      throw std::invalid_argument ("The tensor memory is smaller than the tensor.");
+  }
+
+  /** @brief Get the pointer to the first element. */
+  T *data () const
+  {
+    return data_;
+  }
+
+  /** @brief Get the dimension of given index. */
+  uint32_t dim (unsigned int i) const
+  {
+    return dim_[i];
+  }
+
+  /** @brief Get the stride (in the number of elements) of given index. */
+  size_t stride (unsigned int i) const
+  {
+    return stride_[i];
+  }
+
+  /** @brief Get the number of elements. */
+  size_t size () const
+  {
+    size_t n = 1;
+
+    for (unsigned int i = 0; i < Rank; i++)
+      n *= dim_[i];
+    return n;
+  }
+
+  /** @brief Check the elements are packed without the gap. */
+  bool is_contiguous () const
+  {
+    size_t stride = 1;
+
+    for (unsigned int i = 0; i < Rank; i++) {
+      if (dim_[i] > 1 && stride_[i] != stride)
+        return false;
+      stride *= dim_[i];
+    }
+    return true;
+  }
+
+  /**
+   * @brief Access the element with the flat index.
+   * @note This is valid only for contiguous view.
+   */
+  T &operator[] (size_t index) const
+  {
+    return data_[index];
+  }
+
+  /**
+   * @brief Access the element with the index of each dimension (innermost first).
+   * @detail The number of indices should be same with Rank, e.g., view (c, x, y, b).
+   */
+  template <typename... Idx> T &operator() (Idx... idx) const
+  {
+    static_assert (sizeof...(Idx) == Rank, "The number of indices should be same with Rank.");
+    const size_t index[] = { static_cast<size_t> (idx)... };
+    size_t offset = 0;
+
+    for (unsigned int i = 0; i < Rank; i++)
+      offset += index[i] * stride_[i];
+    return data_[offset];
+  }
+
+  /** @brief Iterator to the first element of contiguous view. */
+  T *begin () const
+  {
+    return data_;
+  }
+
+  /** @brief Iterator to the end of contiguous view. */
+  T *end () const
+  {
+    return data_ + size ();
+  }
+
+  private:
+  T *data_; /**< the pointer to the first element */
+  uint32_t dim_[Rank]; /**< dimension, the index 0 is the innermost */
+  size_t stride_[Rank]; /**< stride of each dimension in the number of elements */
+};
+
+template <typename T, unsigned int Rank> const unsigned int tensor_view<T, Rank>::rank;
+
+} /* namespace nnstreamer */
+
+#endif /* __cplusplus */
+#endif /* __NNS_TENSOR_VIEW_HH__ */
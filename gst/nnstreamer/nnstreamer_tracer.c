@@ -0,0 +1,679 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer tracer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	nnstreamer_tracer.c
+ * @date	16 Oct 2026
+ * @brief	GstTracer to record processing time and copy accounting of the elements
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * The tracer records below for each tensor element (or all elements with 'all=true').
+ * - processing time per buffer, excluding the time in downstream elements
+ * - bytes allocated (GstMemory, GStreamer 1.18 or higher)
+ * - bytes copied with nns_memcpy() and gst_tensor_meta_info_append_header()
+ * - waiting time in the queue (queue, queue2, multiqueue) in front of the element
+ *
+ * The work of a pad task (e.g., the source loop) out of the chain functions is recorded to the element owning the task.
+ * The summary table is printed when the pipeline posts EOS and when the tracer is finalized.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <glib/gstdio.h>
+
+#include "nnstreamer_log.h"
+#include "nnstreamer_tracer.h"
+#include "nnstreamer_plugin_api.h"
+
+/**
+ * @brief Flag to check the nnstreamer tracer is active.
+ */
+gint nnstreamer_tracer_active = 0;
+
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+
+GST_DEBUG_CATEGORY_STATIC (gst_nnstreamer_tracer_debug);
+#define GST_CAT_DEFAULT gst_nnstreamer_tracer_debug
+
+#define GST_NNSTREAMER_TRACER(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj), GST_TYPE_NNSTREAMER_TRACER, GstNNStreamerTracer))
+
+/**
+ * @brief Statistics of the element.
+ */
+typedef struct
+{
+  GMutex lock; /**< lock for the statistics of the element */
+  gchar *name; /**< element name */
+  gboolean ignored; /**< TRUE if the element is not recorded */
+  guint64 buffers; /**< number of processed buffers */
+  GstClockTime proc_time; /**< accumulated processing time */
+  GstClockTime proc_max; /**< max processing time */
+  guint64 alloc_bytes; /**< bytes allocated */
+  guint64 copy_bytes; /**< bytes copied */
+  guint64 queue_num; /**< number of buffers waited in the queue */
+  GstClockTime queue_wait; /**< accumulated waiting time in the queue */
+} GstNNStreamerTracerStat;
+
+/**
+ * @brief Processing frame of current thread (a stack of chain functions).
+ */
+typedef struct
+{
+  GstNNStreamerTracerStat *stat; /**< statistics of the element processing the buffer */
+  GstClockTime start; /**< the time when the buffer is pushed into the element */
+  GstClockTime child; /**< the time spent in downstream elements */
+} GstNNStreamerTracerFrame;
+
+/**
+ * @brief NNStreamer tracer.
+ */
+typedef struct
+{
+  GstTracer parent;
+
+  GMutex lock; /**< lock for the list of statistics, each element has its own lock for the statistics */
+  GPtrArray *stats; /**< statistics of the elements */
+  GstNNStreamerTracerStat *other; /**< statistics out of the element (e.g., application thread) */
+  gchar *output; /**< file path to append the summary */
+  gboolean all; /**< TRUE to record all elements */
+  gint dirty; /**< TRUE if updated after the summary (atomic) */
+} GstNNStreamerTracer;
+
+/**
+ * @brief NNStreamer tracer class.
+ */
+typedef struct
+{
+  GstTracerClass parent_class;
+} GstNNStreamerTracerClass;
+
+G_DEFINE_TYPE (GstNNStreamerTracer, gst_nnstreamer_tracer, GST_TYPE_TRACER);
+
+/**
+ * @brief The active tracer instance (single instance per process).
+ */
+static GstNNStreamerTracer *_nns_tracer = NULL;
+
+/**
+ * @brief Processing frames of the thread.
+ */
+static GPrivate _nns_tracer_frames = G_PRIVATE_INIT ((GDestroyNotify) g_array_unref);
+
+/**
+ * @brief Statistics of the element owning the pad task of the thread.
+ */
+static GPrivate _nns_tracer_task_stat = G_PRIVATE_INIT (NULL);
+
+/**
+ * @brief Quark to attach the statistics to the element.
+ */
+static GQuark _nns_tracer_quark = 0;
+
+/**
+ * @brief Quark to attach the time entered the queue to the buffer.
+ */
+static GQuark _nns_tracer_queued_quark = 0;
+
+/**
+ * @brief Create new statistics.
+ */
+static GstNNStreamerTracerStat *
+gst_nnstreamer_tracer_stat_new (gchar * name, gboolean ignored)
+{
+  GstNNStreamerTracerStat *stat = g_new0 (GstNNStreamerTracerStat, 1);
+
+  g_mutex_init (&stat->lock);
+  stat->name = name;
+  stat->ignored = ignored;
+  return stat;
+}
+
+/**
+ * @brief Free the statistics.
+ */
+static void
+gst_nnstreamer_tracer_stat_free (GstNNStreamerTracerStat * stat)
+{
+  g_mutex_clear (&stat->lock);
+  g_free (stat->name);
+  g_free (stat);
+}
+
+/**
+ * @brief Get the element of the pad (skip the proxy pad of the ghost pad).
+ */
+static GstElement *
+gst_nnstreamer_tracer_get_pad_parent (GstPad * pad)
+{
+  GstObject *parent;
+
+  if (!pad)
+    return NULL;
+
+  parent = GST_OBJECT_PARENT (pad);
+
+  /* if parent of pad is a ghost pad, then pad is a proxy pad */
+  if (parent && GST_IS_GHOST_PAD (parent)) {
+    pad = GST_PAD_CAST (parent);
+    parent = GST_OBJECT_PARENT (pad);
+  }
+
+  return (parent && GST_IS_ELEMENT (parent)) ? GST_ELEMENT_CAST (parent) : NULL;
+}
+
+/**
+ * @brief Check the element is a queue.
+ */
+static gboolean
+gst_nnstreamer_tracer_is_queue (GstElement * element)
+{
+  const gchar *type_name;
+
+  if (!element)
+    return FALSE;
+
+  type_name = G_OBJECT_TYPE_NAME (element);
+  return (g_str_equal (type_name, "GstQueue") ||
+      g_str_equal (type_name, "GstQueue2") ||
+      g_str_equal (type_name, "GstMultiQueue"));
+}
+
+/**
+ * @brief Get the statistics of the element. The tracer lock is taken only when the statistics is created.
+ */
+static GstNNStreamerTracerStat *
+gst_nnstreamer_tracer_get_stat (GstNNStreamerTracer * self,
+    GstElement * element)
+{
+  GstNNStreamerTracerStat *stat;
+  GstElementFactory *factory;
+  const gchar *factory_name = NULL;
+  gboolean ignored;
+
+  if (!element)
+    return NULL;
+
+  stat = g_object_get_qdata (G_OBJECT (element), _nns_tracer_quark);
+  if (stat)
+    return stat;
+
+  g_mutex_lock (&self->lock);
+
+  /* check again, other thread may create it */
+  stat = g_object_get_qdata (G_OBJECT (element), _nns_tracer_quark);
+  if (stat == NULL) {
+    factory = gst_element_get_factory (element);
+    if (factory)
+      factory_name = GST_OBJECT_NAME (factory);
+
+    ignored = GST_IS_BIN (element) ||
+        (!self->all && !(factory_name && g_str_has_prefix (factory_name,
+                    "tensor_")));
+    stat = gst_nnstreamer_tracer_stat_new (gst_object_get_name (GST_OBJECT_CAST
+            (element)), ignored);
+
+    g_ptr_array_add (self->stats, stat);
+    g_object_set_qdata (G_OBJECT (element), _nns_tracer_quark, stat);
+  }
+
+  g_mutex_unlock (&self->lock);
+  return stat;
+}
+
+/**
+ * @brief Get the statistics of the element processing the buffer in current thread.
+ * @details Out of the chain functions, the element owning the pad task of the thread is returned.
+ */
+static GstNNStreamerTracerStat *
+gst_nnstreamer_tracer_get_current_stat (GstNNStreamerTracer * self)
+{
+  GArray *frames = g_private_get (&_nns_tracer_frames);
+  GstNNStreamerTracerStat *stat;
+
+  if (frames && frames->len > 0)
+    return g_array_index (frames, GstNNStreamerTracerFrame,
+        frames->len - 1).stat;
+
+  stat = g_private_get (&_nns_tracer_task_stat);
+  return stat ? stat : self->other;
+}
+
+/**
+ * @brief Print the summary table.
+ */
+static void
+gst_nnstreamer_tracer_print_summary (GstNNStreamerTracer * self)
+{
+  FILE *fp = NULL;
+  GstTensorAllocStats alloc_stats;
+  guint i;
+
+  g_mutex_lock (&self->lock);
+
+  if (self->output) {
+    fp = g_fopen (self->output, "a");
+    if (!fp)
+      nns_logw ("Failed to open %s to write the tracer summary.", self->output);
+  }
+
+  if (!fp)
+    fp = stderr;
+
+  fprintf (fp, "[nnstreamer tracer summary]\n");
+  fprintf (fp, "%-32s %10s %14s %14s %16s %16s %14s\n", "element", "buffers",
+      "avg-proc(us)", "max-proc(us)", "alloc(bytes)", "memcpy(bytes)",
+      "avg-queue(us)");
+
+  for (i = 0; i <= self->stats->len; i++) {
+    GstNNStreamerTracerStat *stat;
+
+    stat = (i < self->stats->len) ?
+        g_ptr_array_index (self->stats, i) : self->other;
+
+    if (stat->ignored)
+      continue;
+
+    g_mutex_lock (&stat->lock);
+    if (stat->buffers > 0 || stat->alloc_bytes > 0 || stat->copy_bytes > 0) {
+      fprintf (fp, "%-32s %10" G_GUINT64_FORMAT " %14.3f %14.3f %16"
+          G_GUINT64_FORMAT " %16" G_GUINT64_FORMAT " %14.3f\n", stat->name,
+          stat->buffers,
+          (stat->buffers > 0) ? (stat->proc_time / 1000.0) / stat->buffers :
+          0.0, stat->proc_max / 1000.0, stat->alloc_bytes, stat->copy_bytes,
+          (stat->queue_num > 0) ?
+          (stat->queue_wait / 1000.0) / stat->queue_num : 0.0);
+    }
+    g_mutex_unlock (&stat->lock);
+  }
+
+  /* pooled tensor allocator */
+  gst_tensor_alloc_get_stats (&alloc_stats);
+  if (alloc_stats.hits + alloc_stats.misses > 0) {
+    fprintf (fp, "[tensor allocator pool] live %" G_GUINT64_FORMAT
+        " bytes, peak %" G_GUINT64_FORMAT " bytes, pooled %" G_GUINT64_FORMAT
+        " bytes, trimmed %" G_GUINT64_FORMAT " bytes, hit rate %.2f%%\n",
+        alloc_stats.live_bytes, alloc_stats.peak_bytes,
+        alloc_stats.pooled_bytes, alloc_stats.trimmed_bytes,
+        (alloc_stats.hits * 100.0) / (alloc_stats.hits + alloc_stats.misses));
+  }
+
+  fflush (fp);
+  if (fp != stderr)
+    fclose (fp);
+
+  g_atomic_int_set (&self->dirty, FALSE);
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Record the waiting time of the buffer in the queue.
+ * @details The time entered the queue is attached to the buffer, so that it is released with the buffer dropped in the queue.
+ */
+static void
+gst_nnstreamer_tracer_account_queue (GstNNStreamerTracer * self,
+    GstNNStreamerTracerStat * stat, GstClockTime ts, gboolean from_queue,
+    gboolean to_queue, GstBuffer * buffer)
+{
+  GstMiniObject *obj = GST_MINI_OBJECT_CAST (buffer);
+  GstClockTime *entered;
+
+  /* buffer is out of the queue, the element waited for this buffer */
+  if (from_queue &&
+      (entered = gst_mini_object_get_qdata (obj, _nns_tracer_queued_quark))) {
+    if (stat && !stat->ignored && ts > *entered) {
+      g_mutex_lock (&stat->lock);
+      stat->queue_num++;
+      stat->queue_wait += ts - *entered;
+      g_mutex_unlock (&stat->lock);
+      g_atomic_int_set (&self->dirty, TRUE);
+    }
+
+    gst_mini_object_set_qdata (obj, _nns_tracer_queued_quark, NULL, NULL);
+  }
+
+  if (to_queue) {
+    entered = g_new (GstClockTime, 1);
+    *entered = ts;
+    gst_mini_object_set_qdata (obj, _nns_tracer_queued_quark, entered, g_free);
+  }
+}
+
+/**
+ * @brief Push the processing frame of the element in current thread.
+ */
+static void
+gst_nnstreamer_tracer_push_frame (GstNNStreamerTracer * self,
+    GstClockTime ts, GstPad * pad, GstBuffer * buffer, GstBufferList * list)
+{
+  GstNNStreamerTracerFrame frame;
+  GArray *frames;
+  GstElement *element, *upstream;
+  gboolean from_queue, to_queue;
+  GstPad *peer;
+  guint i, len;
+
+  peer = gst_pad_get_peer (pad);
+  element = gst_nnstreamer_tracer_get_pad_parent (peer);
+  upstream = gst_nnstreamer_tracer_get_pad_parent (pad);
+
+  frame.stat = gst_nnstreamer_tracer_get_stat (self, element);
+  frame.start = ts;
+  frame.child = 0;
+
+  from_queue = gst_nnstreamer_tracer_is_queue (upstream);
+  to_queue = gst_nnstreamer_tracer_is_queue (element);
+
+  if (from_queue || to_queue) {
+    if (buffer) {
+      gst_nnstreamer_tracer_account_queue (self, frame.stat, ts, from_queue,
+          to_queue, buffer);
+    } else if (list) {
+      len = gst_buffer_list_length (list);
+      for (i = 0; i < len; i++) {
+        gst_nnstreamer_tracer_account_queue (self, frame.stat, ts, from_queue,
+            to_queue, gst_buffer_list_get (list, i));
+      }
+    }
+  }
+
+  if (peer)
+    gst_object_unref (peer);
+
+  frames = g_private_get (&_nns_tracer_frames);
+  if (!frames) {
+    frames = g_array_new (FALSE, FALSE, sizeof (GstNNStreamerTracerFrame));
+    g_private_set (&_nns_tracer_frames, frames);
+  }
+
+  g_array_append_val (frames, frame);
+}
+
+/**
+ * @brief Pop the processing frame of the element and record the processing time.
+ */
+static void
+gst_nnstreamer_tracer_pop_frame (GstNNStreamerTracer * self, GstClockTime ts)
+{
+  GstNNStreamerTracerFrame *frame;
+  GArray *frames;
+  GstClockTime elapsed, proc;
+
+  frames = g_private_get (&_nns_tracer_frames);
+  if (!frames || frames->len == 0)
+    return;
+
+  frame = &g_array_index (frames, GstNNStreamerTracerFrame, frames->len - 1);
+  elapsed = (ts > frame->start) ? (ts - frame->start) : 0;
+  proc = (elapsed > frame->child) ? (elapsed - frame->child) : 0;
+
+  if (frame->stat && !frame->stat->ignored) {
+    g_mutex_lock (&frame->stat->lock);
+    frame->stat->buffers++;
+    frame->stat->proc_time += proc;
+    if (proc > frame->stat->proc_max)
+      frame->stat->proc_max = proc;
+    g_mutex_unlock (&frame->stat->lock);
+    g_atomic_int_set (&self->dirty, TRUE);
+  }
+
+  g_array_set_size (frames, frames->len - 1);
+
+  /* the time in downstream is excluded from the upstream element */
+  if (frames->len > 0)
+    g_array_index (frames, GstNNStreamerTracerFrame,
+        frames->len - 1).child += elapsed;
+}
+
+/**
+ * @brief Hook for pad-push-pre.
+ */
+static void
+gst_nnstreamer_tracer_pad_push_pre (GObject * object, GstClockTime ts,
+    GstPad * pad, GstBuffer * buffer)
+{
+  gst_nnstreamer_tracer_push_frame (GST_NNSTREAMER_TRACER (object), ts, pad,
+      buffer, NULL);
+}
+
+/**
+ * @brief Hook for pad-push-list-pre.
+ */
+static void
+gst_nnstreamer_tracer_pad_push_list_pre (GObject * object, GstClockTime ts,
+    GstPad * pad, GstBufferList * list)
+{
+  gst_nnstreamer_tracer_push_frame (GST_NNSTREAMER_TRACER (object), ts, pad,
+      NULL, list);
+}
+
+/**
+ * @brief Hook for pad-push-post and pad-push-list-post.
+ */
+static void
+gst_nnstreamer_tracer_pad_push_post (GObject * object, GstClockTime ts,
+    GstPad * pad, GstFlowReturn res)
+{
+  gst_nnstreamer_tracer_pop_frame (GST_NNSTREAMER_TRACER (object), ts);
+}
+
+/**
+ * @brief Set the element owning the pad task of current thread.
+ * @details The pad task posts the stream-status message in its own thread when it enters and leaves the thread.
+ */
+static void
+gst_nnstreamer_tracer_stream_status (GstNNStreamerTracer * self,
+    GstMessage * message)
+{
+  GstStreamStatusType type;
+  GstElement *owner = NULL;
+
+  gst_message_parse_stream_status (message, &type, &owner);
+
+  if (type == GST_STREAM_STATUS_TYPE_ENTER) {
+    g_private_set (&_nns_tracer_task_stat,
+        gst_nnstreamer_tracer_get_stat (self, owner));
+  } else if (type == GST_STREAM_STATUS_TYPE_LEAVE) {
+    g_private_set (&_nns_tracer_task_stat, NULL);
+  }
+}
+
+/**
+ * @brief Hook for element-post-message-pre, print the summary at EOS and track the pad task.
+ */
+static void
+gst_nnstreamer_tracer_element_post_message_pre (GObject * object,
+    GstClockTime ts, GstElement * element, GstMessage * message)
+{
+  GstNNStreamerTracer *self = GST_NNSTREAMER_TRACER (object);
+
+  switch (GST_MESSAGE_TYPE (message)) {
+    case GST_MESSAGE_EOS:
+      if (GST_IS_PIPELINE (element))
+        gst_nnstreamer_tracer_print_summary (self);
+      break;
+    case GST_MESSAGE_STREAM_STATUS:
+      gst_nnstreamer_tracer_stream_status (self, message);
+      break;
+    default:
+      break;
+  }
+}
+
+#if GST_CHECK_VERSION(1, 18, 0)
+/**
+ * @brief Hook for memory-init, record the bytes allocated.
+ */
+static void
+gst_nnstreamer_tracer_memory_init (GObject * object, GstClockTime ts,
+    GstMemory * memory)
+{
+  GstNNStreamerTracer *self = GST_NNSTREAMER_TRACER (object);
+  GstNNStreamerTracerStat *stat;
+
+  /* shared memory is not an allocation */
+  if (memory->parent)
+    return;
+
+  stat = gst_nnstreamer_tracer_get_current_stat (self);
+  if (stat && !stat->ignored) {
+    g_mutex_lock (&stat->lock);
+    stat->alloc_bytes += memory->maxsize;
+    g_mutex_unlock (&stat->lock);
+    g_atomic_int_set (&self->dirty, TRUE);
+  }
+}
+#endif
+
+/**
+ * @brief Parse the parameters of the tracer.
+ */
+static void
+gst_nnstreamer_tracer_parse_params (GstNNStreamerTracer * self)
+{
+  GstStructure *params = NULL;
+  gchar *str = NULL, *tmp;
+
+  g_object_get (self, "params", &str, NULL);
+  if (!str)
+    return;
+
+  tmp = g_strdup_printf ("nnstreamer,%s", str);
+  params = gst_structure_from_string (tmp, NULL);
+  g_free (tmp);
+
+  if (params) {
+    const gchar *output = gst_structure_get_string (params, "file");
+
+    if (output)
+      self->output = g_strdup (output);
+    gst_structure_get_boolean (params, "all", &self->all);
+
+    gst_structure_free (params);
+  } else {
+    nns_logw ("Failed to parse the tracer params '%s'.", str);
+  }
+
+  g_free (str);
+}
+
+/**
+ * @brief Constructed callback of the tracer.
+ */
+static void
+gst_nnstreamer_tracer_constructed (GObject * object)
+{
+  GstNNStreamerTracer *self = GST_NNSTREAMER_TRACER (object);
+
+  G_OBJECT_CLASS (gst_nnstreamer_tracer_parent_class)->constructed (object);
+
+  gst_nnstreamer_tracer_parse_params (self);
+
+  if (g_atomic_pointer_compare_and_exchange (&_nns_tracer, NULL, self)) {
+    g_atomic_int_set (&nnstreamer_tracer_active, 1);
+  } else {
+    GST_WARNING_OBJECT (self, "The nnstreamer tracer is already running.");
+  }
+}
+
+/**
+ * @brief Finalize the tracer.
+ */
+static void
+gst_nnstreamer_tracer_finalize (GObject * object)
+{
+  GstNNStreamerTracer *self = GST_NNSTREAMER_TRACER (object);
+
+  if (g_atomic_pointer_compare_and_exchange (&_nns_tracer, self, NULL))
+    g_atomic_int_set (&nnstreamer_tracer_active, 0);
+
+  if (g_atomic_int_get (&self->dirty))
+    gst_nnstreamer_tracer_print_summary (self);
+
+  g_ptr_array_free (self->stats, TRUE);
+  gst_nnstreamer_tracer_stat_free (self->other);
+  g_free (self->output);
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (gst_nnstreamer_tracer_parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the tracer class.
+ */
+static void
+gst_nnstreamer_tracer_class_init (GstNNStreamerTracerClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (gst_nnstreamer_tracer_debug, "nnstreamer_tracer",
+      0, "NNStreamer tracer for processing time and copy accounting");
+
+  gobject_class->constructed = gst_nnstreamer_tracer_constructed;
+  gobject_class->finalize = gst_nnstreamer_tracer_finalize;
+
+  _nns_tracer_quark = g_quark_from_static_string ("nnstreamer-tracer-stat");
+  _nns_tracer_queued_quark =
+      g_quark_from_static_string ("nnstreamer-tracer-queued");
+}
+
+/**
+ * @brief Initialize the tracer.
+ */
+static void
+gst_nnstreamer_tracer_init (GstNNStreamerTracer * self)
+{
+  GstTracer *tracer = GST_TRACER (self);
+
+  g_mutex_init (&self->lock);
+  self->stats = g_ptr_array_new_with_free_func ((GDestroyNotify)
+      gst_nnstreamer_tracer_stat_free);
+  self->other =
+      gst_nnstreamer_tracer_stat_new (g_strdup ("(other threads)"), FALSE);
+  self->output = NULL;
+  self->all = FALSE;
+  self->dirty = FALSE;
+
+  gst_tracing_register_hook (tracer, "pad-push-pre",
+      G_CALLBACK (gst_nnstreamer_tracer_pad_push_pre));
+  gst_tracing_register_hook (tracer, "pad-push-post",
+      G_CALLBACK (gst_nnstreamer_tracer_pad_push_post));
+  gst_tracing_register_hook (tracer, "pad-push-list-pre",
+      G_CALLBACK (gst_nnstreamer_tracer_pad_push_list_pre));
+  gst_tracing_register_hook (tracer, "pad-push-list-post",
+      G_CALLBACK (gst_nnstreamer_tracer_pad_push_post));
+  gst_tracing_register_hook (tracer, "element-post-message-pre",
+      G_CALLBACK (gst_nnstreamer_tracer_element_post_message_pre));
+#if GST_CHECK_VERSION(1, 18, 0)
+  gst_tracing_register_hook (tracer, "memory-init",
+      G_CALLBACK (gst_nnstreamer_tracer_memory_init));
+#endif
+}
+
+#endif /* GST_DISABLE_GST_TRACER_HOOKS */
+
+/**
+ * @brief Account the bytes copied by the element in current thread.
+ */
+void
+nnstreamer_tracer_record_copy (gsize size)
+{
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  GstNNStreamerTracer *self = g_atomic_pointer_get (&_nns_tracer);
+  GstNNStreamerTracerStat *stat;
+
+  if (!self || size == 0)
+    return;
+
+  stat = gst_nnstreamer_tracer_get_current_stat (self);
+  if (stat && !stat->ignored) {
+    g_mutex_lock (&stat->lock);
+    stat->copy_bytes += size;
+    g_mutex_unlock (&stat->lock);
+    g_atomic_int_set (&self->dirty, TRUE);
+  }
+#endif
+}
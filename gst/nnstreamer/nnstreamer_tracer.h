@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer tracer
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	nnstreamer_tracer.h
+ * @date	16 Oct 2026
+ * @brief	GstTracer to record processing time and copy accounting of the elements
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * Usage: GST_TRACERS="nnstreamer" or GST_TRACERS="nnstreamer(file=/tmp/nns.log,all=true)"
+ * - file: the path to append the summary table (default: stderr)
+ * - all: TRUE to record all elements (default: FALSE, tensor elements only)
+ */
+
+#ifndef __NNSTREAMER_TRACER_H__
+#define __NNSTREAMER_TRACER_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <gst/gsttracer.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Flag to check the nnstreamer tracer is active. Do not update this outside of the tracer.
+ */
+extern gint nnstreamer_tracer_active;
+
+/**
+ * @brief Account the bytes copied by the element in current thread.
+ * @param[in] size The size of copied data (bytes)
+ */
+extern void
+nnstreamer_tracer_record_copy (gsize size);
+
+/**
+ * @brief Account the bytes copied (no-op if the nnstreamer tracer is inactive).
+ */
+#define nns_trace_memcpy(n) do { \
+    if (G_UNLIKELY (nnstreamer_tracer_active)) \
+      nnstreamer_tracer_record_copy ((gsize) (n)); \
+  } while (0)
+
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+/**
+ * @brief Get the type of nnstreamer tracer.
+ */
+extern GType
+gst_nnstreamer_tracer_get_type (void);
+
+#define GST_TYPE_NNSTREAMER_TRACER (gst_nnstreamer_tracer_get_type ())
+#endif /* GST_DISABLE_GST_TRACER_HOOKS */
+
+G_END_DECLS
+#endif /* __NNSTREAMER_TRACER_H__ */
@@ -65,6 +65,8 @@
 #include <tensor_transform/tensor_transform.h>
 #include <tensor_if/gsttensorif.h>
 #include <tensor_rate/gsttensorrate.h>
+#include <nnstreamer_tracer.h>
+#include <tensor_common.h>
 
 #define NNSTREAMER_INIT(plugin,name,type) \
   do { \
@@ -102,6 +104,15 @@ gst_nnstreamer_init (GstPlugin * plugin)
   NNSTREAMER_INIT (plugin, src_iio, SRC_IIO);
 #endif
 #endif /* __gnu_linux__ && !__ANDROID__ */
+  /* pooled tensor allocator configured in nnstreamer.ini */
+  gst_tensor_alloc_load_conf ();
+
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  if (!gst_tracer_register (plugin, "nnstreamer", GST_TYPE_NNSTREAMER_TRACER)) {
+    GST_ERROR ("Failed to register nnstreamer tracer");
+    return FALSE;
+  }
+#endif
   return TRUE;
 }
 
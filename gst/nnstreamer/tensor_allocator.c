@@ -9,15 +9,78 @@
  * @see     http://github.com/nnstreamer/nnstreamer
  * @bug     No known bugs
  *
+ * In pooled mode, the allocator keeps the free lists of aligned blocks for each size class.
+ * The blocks are reused for the next allocation of the same size class, instead of new malloc.
+ * The large blocks can be backed by huge pages (MAP_HUGETLB or transparent huge pages).
+ * The pooled mode is configured with nnstreamer.ini or envvar:
+ *   [allocator]
+ *   pool=true
+ *   pool_max_bytes=268435456 (max bytes of the free blocks held in the pool)
+ *   pool_low_watermark=134217728 (the pool is trimmed to this size if exceeding the max)
+ *   hugepage_threshold=2097152 (min size of the block backed by huge pages, 0 to disable)
  */
 
+#include <stdlib.h>
+#include <string.h>
 #include <gst/gst.h>
+#include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
+#include "nnstreamer_conf.h"
+#include "tensor_common.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 #define GST_TENSOR_ALLOCATOR "GstTensorAllocator"
 
 static gsize gst_tensor_allocator_alignment = 0;
 
+/**
+ * @brief Definitions for the size classes of the pool.
+ * The size classes are 2^n and 1.5 * 2^n bytes from 256 bytes to 1GB, so the waste of a block is less than 1/3.
+ */
+#define POOL_MIN_SHIFT (8)
+#define POOL_MAX_SHIFT (30)
+#define POOL_NUM_CLASSES (2 * (POOL_MAX_SHIFT - POOL_MIN_SHIFT) + 1)
+#define POOL_BLOCK_ALIGN (64)
+#define POOL_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+#define DEFAULT_POOL_MAX_BYTES (256 * 1024 * 1024)
+
+/**
+ * @brief Data structure for the block allocated by the pool.
+ */
+typedef struct _GstTensorPoolBlock
+{
+  struct _GstTensorPoolBlock *next; /**< next free block in the same size class */
+  gpointer data; /**< the aligned memory */
+  gsize size; /**< the size of the block (size class) */
+  gsize mapped; /**< the length of the mapped memory (0 if allocated with malloc) */
+  guint index; /**< the index of the size class */
+} GstTensorPoolBlock;
+
+/**
+ * @brief Data structure for the pooled mode of tensor allocator.
+ */
+typedef struct
+{
+  GMutex lock; /**< lock for the free lists and statistics */
+  gboolean enabled; /**< TRUE if the pooled mode is enabled */
+  gsize max_bytes; /**< max bytes of the free blocks */
+  gsize low_watermark; /**< the pool is trimmed to this size if exceeding max bytes */
+  gsize hugepage_threshold; /**< min size of the block backed by huge pages (0 to disable) */
+  GstTensorPoolBlock *free_list[POOL_NUM_CLASSES]; /**< free blocks of each size class */
+  GstTensorAllocStats stats; /**< statistics of the pool */
+} GstTensorAllocPool;
+
+static GstTensorAllocPool tensor_pool = {
+  .enabled = FALSE,
+  .max_bytes = DEFAULT_POOL_MAX_BYTES,
+  .low_watermark = DEFAULT_POOL_MAX_BYTES / 2,
+  .hugepage_threshold = 0,
+};
+
 /**
  * @brief struct for type GstTensorAllocator
  */
@@ -38,6 +101,211 @@ typedef struct
 static GType gst_tensor_allocator_get_type (void);
 G_DEFINE_TYPE (GstTensorAllocator, gst_tensor_allocator, GST_TYPE_ALLOCATOR);
 
+/**
+ * @brief Get the index of the size class for given size.
+ * @return The index of the size class, or -1 if the size is too large to be pooled.
+ */
+static gint
+_pool_get_class (gsize size, gsize * class_size)
+{
+  guint shift;
+
+  if (size <= (1U << POOL_MIN_SHIFT)) {
+    *class_size = 1U << POOL_MIN_SHIFT;
+    return 0;
+  }
+
+  /* 2^(shift - 1) < size <= 2^shift */
+  shift = g_bit_storage (size - 1);
+  if (shift > POOL_MAX_SHIFT)
+    return -1;
+
+  if (size <= ((gsize) 3 << (shift - 2))) {
+    *class_size = (gsize) 3 << (shift - 2);
+    return 2 * (shift - POOL_MIN_SHIFT) - 1;
+  }
+
+  *class_size = (gsize) 1 << shift;
+  return 2 * (shift - POOL_MIN_SHIFT);
+}
+
+/**
+ * @brief Allocate new block, backed by huge pages if the block is large.
+ */
+static GstTensorPoolBlock *
+_pool_block_new (gsize size, guint index)
+{
+  GstTensorPoolBlock *block;
+
+  block = g_new0 (GstTensorPoolBlock, 1);
+  block->size = size;
+  block->index = index;
+
+#if defined(__linux__)
+  if (tensor_pool.hugepage_threshold > 0 &&
+      size >= tensor_pool.hugepage_threshold) {
+    gsize len = GST_ROUND_UP_N (size, POOL_HUGEPAGE_SIZE);
+    gpointer data = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+    data = mmap (NULL, len, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    /* no reserved huge pages, fallback to transparent huge pages */
+    if (data == MAP_FAILED) {
+      data = mmap (NULL, len, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+      if (data != MAP_FAILED)
+        madvise (data, len, MADV_HUGEPAGE);
+#endif
+    }
+
+    if (data != MAP_FAILED) {
+      block->data = data;
+      block->mapped = len;
+      return block;
+    }
+  }
+#endif
+
+  if (posix_memalign (&block->data, POOL_BLOCK_ALIGN, size) != 0) {
+    g_free (block);
+    return NULL;
+  }
+
+  return block;
+}
+
+/**
+ * @brief Free the memory of the block.
+ */
+static void
+_pool_block_free (GstTensorPoolBlock * block)
+{
+#if defined(__linux__)
+  if (block->mapped > 0)
+    munmap (block->data, block->mapped);
+  else
+#endif
+    free (block->data);
+
+  g_free (block);
+}
+
+/**
+ * @brief Free the blocks in the free lists until the pool is less than given size. Caller should hold the lock.
+ */
+static void
+_pool_trim_locked (gsize watermark)
+{
+  gint i;
+
+  /* free the large blocks first */
+  for (i = POOL_NUM_CLASSES - 1; i >= 0; i--) {
+    while (tensor_pool.free_list[i] &&
+        tensor_pool.stats.pooled_bytes > watermark) {
+      GstTensorPoolBlock *block = tensor_pool.free_list[i];
+
+      tensor_pool.free_list[i] = block->next;
+      tensor_pool.stats.pooled_bytes -= block->size;
+      tensor_pool.stats.trimmed_bytes += block->size;
+      _pool_block_free (block);
+    }
+  }
+}
+
+/**
+ * @brief Return the block to the free list when the memory is freed.
+ */
+static void
+_pool_block_release (gpointer user_data)
+{
+  GstTensorPoolBlock *block = (GstTensorPoolBlock *) user_data;
+
+  g_mutex_lock (&tensor_pool.lock);
+  tensor_pool.stats.live_bytes -= block->size;
+
+  if (!tensor_pool.enabled || block->size > tensor_pool.max_bytes) {
+    _pool_block_free (block);
+  } else {
+    if (tensor_pool.stats.pooled_bytes + block->size > tensor_pool.max_bytes) {
+      nns_logd ("Trim the tensor allocator pool (%" G_GUINT64_FORMAT
+          " bytes).", tensor_pool.stats.pooled_bytes);
+      _pool_trim_locked (MIN (tensor_pool.low_watermark,
+              tensor_pool.max_bytes - block->size));
+    }
+
+    block->next = tensor_pool.free_list[block->index];
+    tensor_pool.free_list[block->index] = block;
+    tensor_pool.stats.pooled_bytes += block->size;
+  }
+
+  g_mutex_unlock (&tensor_pool.lock);
+}
+
+/**
+ * @brief Allocate the memory with the block in the pool.
+ * @return Newly allocated memory, or NULL if the size cannot be pooled.
+ */
+static GstMemory *
+_pool_alloc (gsize size, GstAllocationParams * params)
+{
+  GstTensorPoolBlock *block;
+  GstMemory *mem;
+  gsize maxsize, class_size = 0;
+  gint index;
+
+  /* the blocks are aligned to POOL_BLOCK_ALIGN */
+  if (params->align >= POOL_BLOCK_ALIGN ||
+      gst_tensor_allocator_alignment >= POOL_BLOCK_ALIGN)
+    return NULL;
+
+  maxsize = size + params->prefix + params->padding;
+  index = _pool_get_class (maxsize, &class_size);
+  if (index < 0)
+    return NULL;
+
+  g_mutex_lock (&tensor_pool.lock);
+  block = tensor_pool.free_list[index];
+  if (block) {
+    tensor_pool.free_list[index] = block->next;
+    tensor_pool.stats.pooled_bytes -= block->size;
+    tensor_pool.stats.hits++;
+  } else {
+    tensor_pool.stats.misses++;
+  }
+  g_mutex_unlock (&tensor_pool.lock);
+
+  if (block == NULL) {
+    block = _pool_block_new (class_size, (guint) index);
+    if (block == NULL)
+      return NULL;
+  }
+
+  block->next = NULL;
+
+  g_mutex_lock (&tensor_pool.lock);
+  tensor_pool.stats.live_bytes += block->size;
+  if (tensor_pool.stats.live_bytes > tensor_pool.stats.peak_bytes)
+    tensor_pool.stats.peak_bytes = tensor_pool.stats.live_bytes;
+  g_mutex_unlock (&tensor_pool.lock);
+
+  if (params->prefix > 0 && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED))
+    memset (block->data, 0, params->prefix);
+  if (params->padding > 0 && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED))
+    memset ((guint8 *) block->data + params->prefix + size, 0,
+        params->padding);
+
+  mem = gst_memory_new_wrapped (params->flags, block->data, maxsize,
+      params->prefix, size, block, _pool_block_release);
+
+  if (mem == NULL)
+    _pool_block_release (block);
+
+  return mem;
+}
+
 /**
  * @brief   allocation wrapper that binds alignment parameter
  */
@@ -49,10 +317,17 @@ _alloc (GstAllocator * allocator, gsize size, GstAllocationParams * params)
   GstAllocationParams *_params;
   GstMemory *mem;
 
+  if (tensor_pool.enabled) {
+    mem = _pool_alloc (size, params);
+    if (mem)
+      return mem;
+  }
+
   sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
   sysmem_aclass = GST_ALLOCATOR_GET_CLASS (sysmem_alloc);
   _params = gst_allocation_params_copy (params);
-  _params->align = gst_tensor_allocator_alignment;
+  /* keep the alignment requested by the caller (e.g., negotiated with allocation query) */
+  _params->align = MAX (params->align, gst_tensor_allocator_alignment);
 
   mem = sysmem_aclass->alloc (allocator, size, _params);
 
@@ -113,7 +388,7 @@ gst_tensor_alloc_init (gsize alignment)
   gst_tensor_allocator_alignment = alignment;
 
   /* no alignment */
-  if (alignment == 0) {
+  if (alignment == 0 && !tensor_pool.enabled) {
     gst_allocator_set_default (gst_allocator_find (GST_ALLOCATOR_SYSMEM));
     return;
   }
@@ -126,3 +401,94 @@ gst_tensor_alloc_init (gsize alignment)
   }
   gst_allocator_set_default (allocator);
 }
+
+/**
+ * @brief Enable or disable the pooled mode of default tensor allocator.
+ */
+void
+gst_tensor_alloc_set_pool (gboolean enable, gsize max_bytes,
+    gsize low_watermark, gsize hugepage_threshold)
+{
+  g_mutex_lock (&tensor_pool.lock);
+  tensor_pool.enabled = enable;
+  tensor_pool.max_bytes = max_bytes;
+  tensor_pool.low_watermark = MIN (low_watermark, max_bytes);
+  tensor_pool.hugepage_threshold = hugepage_threshold;
+
+  if (!enable)
+    _pool_trim_locked (0);
+  else if (tensor_pool.stats.pooled_bytes > max_bytes)
+    _pool_trim_locked (tensor_pool.low_watermark);
+  g_mutex_unlock (&tensor_pool.lock);
+
+  /* set default allocator */
+  gst_tensor_alloc_init (gst_tensor_allocator_alignment);
+}
+
+/**
+ * @brief Free all blocks in the free lists of the pool.
+ */
+void
+gst_tensor_alloc_trim (void)
+{
+  g_mutex_lock (&tensor_pool.lock);
+  _pool_trim_locked (0);
+  g_mutex_unlock (&tensor_pool.lock);
+}
+
+/**
+ * @brief Get the statistics of the pooled tensor allocator.
+ */
+void
+gst_tensor_alloc_get_stats (GstTensorAllocStats * stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  g_mutex_lock (&tensor_pool.lock);
+  memcpy (stats, &tensor_pool.stats, sizeof (GstTensorAllocStats));
+  g_mutex_unlock (&tensor_pool.lock);
+}
+
+/**
+ * @brief Get the size value from nnstreamer configuration.
+ */
+static gsize
+_conf_get_size (const gchar * key, gsize def)
+{
+  gchar *str;
+  gsize value = def;
+
+  str = nnsconf_get_custom_value_string ("allocator", key);
+  if (str) {
+    gchar *end = NULL;
+    guint64 val = g_ascii_strtoull (str, &end, 10);
+
+    if (end != str)
+      value = (gsize) val;
+    else
+      nns_logw ("Invalid value %s of [allocator] %s.", str, key);
+
+    g_free (str);
+  }
+
+  return value;
+}
+
+/**
+ * @brief Enable the pooled mode of tensor allocator with nnstreamer configuration.
+ */
+void
+gst_tensor_alloc_load_conf (void)
+{
+  gsize max_bytes, low_watermark, hugepage_threshold;
+
+  if (!nnsconf_get_custom_value_bool ("allocator", "pool", FALSE))
+    return;
+
+  max_bytes = _conf_get_size ("pool_max_bytes", DEFAULT_POOL_MAX_BYTES);
+  low_watermark = _conf_get_size ("pool_low_watermark", max_bytes / 2);
+  hugepage_threshold = _conf_get_size ("hugepage_threshold", 0);
+
+  gst_tensor_alloc_set_pool (TRUE, max_bytes, low_watermark,
+      hugepage_threshold);
+}
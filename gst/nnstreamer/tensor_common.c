@@ -1841,11 +1841,196 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem)
   return ret;
 }
 
+/**
+ * @brief Allocate new memory for static tensor, reserving the area for the header of flexible tensor.
+ * @param[in] size the data size
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ */
+GstMemory *
+gst_tensor_alloc_with_header_room (gsize size)
+{
+  return gst_tensor_alloc_with_header_room_full (size, NULL, NULL);
+}
+
+/**
+ * @brief Allocate new memory for static tensor with given allocator and parameters, reserving the area for the header of flexible tensor.
+ * @param[in] size the data size
+ * @param[in] allocator the allocator to be used (NULL to use the default allocator)
+ * @param[in] params the allocation parameters. NULL for default.
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ */
+GstMemory *
+gst_tensor_alloc_with_header_room_full (gsize size, GstAllocator * allocator,
+    const GstAllocationParams * params)
+{
+  GstTensorMetaInfo meta;
+  GstAllocationParams _params;
+
+  gst_tensor_meta_info_init (&meta);
+
+  if (params)
+    _params = *params;
+  else
+    gst_allocation_params_init (&_params);
+
+  _params.prefix = gst_tensor_meta_info_get_header_size (&meta);
+
+  /* the data follows the header, do not reserve the area if it breaks the alignment */
+  if (_params.prefix & _params.align)
+    _params.prefix = 0;
+  else
+    _params.flags |= GST_TENSOR_MEMORY_FLAG_HEADER_ROOM;
+
+  return gst_allocator_alloc (allocator, size, &_params);
+}
+
+/**
+ * @brief Data to return the memory to the buffer pool.
+ */
+typedef struct
+{
+  GstBuffer *buffer; /**< the buffer acquired from the buffer pool */
+  GstMapInfo map; /**< map info of the buffer */
+} GstTensorPoolMemData;
+
+/**
+ * @brief Release the pooled buffer when the wrapped memory is freed.
+ */
+static void
+_gst_tensor_pool_mem_data_free (gpointer data)
+{
+  GstTensorPoolMemData *pdata = (GstTensorPoolMemData *) data;
+
+  gst_buffer_unmap (pdata->buffer, &pdata->map);
+  /* the buffer goes back to the pool */
+  gst_buffer_unref (pdata->buffer);
+  g_free (pdata);
+}
+
+/**
+ * @brief Get new memory block from the buffer pool.
+ * @param[in] pool the buffer pool (should be activated)
+ * @param[in] size the data size
+ * @param[in] prefix the size of the area reserved in front of the data, which is configured in the pool
+ * @return Newly wrapped GstMemory, NULL if the pool is exhausted or the size of the pooled buffer is different.
+ */
+GstMemory *
+gst_tensor_buffer_pool_alloc_memory (GstBufferPool * pool, gsize size,
+    gsize prefix)
+{
+  GstBufferPoolAcquireParams params = { 0, };
+  GstTensorPoolMemData *pdata;
+  GstBuffer *buffer;
+
+  g_return_val_if_fail (GST_IS_BUFFER_POOL (pool), NULL);
+
+  /* do not wait for the buffer, caller allocates new one if the pool is exhausted */
+  params.flags = GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT;
+
+  if (gst_buffer_pool_acquire_buffer (pool, &buffer, &params) != GST_FLOW_OK)
+    return NULL;
+
+  pdata = g_new0 (GstTensorPoolMemData, 1);
+  pdata->buffer = buffer;
+
+  if (gst_buffer_n_memory (buffer) != 1 ||
+      !gst_buffer_map (buffer, &pdata->map, GST_MAP_READWRITE)) {
+    gst_buffer_unref (buffer);
+    g_free (pdata);
+    return NULL;
+  }
+
+  if (pdata->map.size != size) {
+    _gst_tensor_pool_mem_data_free (pdata);
+    return NULL;
+  }
+
+  /* the map covers whole memory block including the reserved area */
+  return gst_memory_new_wrapped (prefix > 0 ?
+      GST_TENSOR_MEMORY_FLAG_HEADER_ROOM : 0, pdata->map.data - prefix,
+      pdata->map.size + prefix, prefix, size, pdata,
+      _gst_tensor_pool_mem_data_free);
+}
+
+/**
+ * @brief Configure and activate the buffer pool proposed by downstream.
+ * @param pool the buffer pool
+ * @param caps the caps of the buffers in the pool
+ * @param size the size of the tensor to be acquired from the pool
+ * @param min the minimum number of buffers
+ * @param max the maximum number of buffers
+ * @param[out] prefix the size of the area reserved in front of the data, which is configured by downstream
+ * @return TRUE if the pool is activated and the size of its buffer is same with given size.
+ */
+gboolean
+gst_tensor_buffer_pool_setup (GstBufferPool * pool, GstCaps * caps,
+    gsize size, guint min, guint max, gsize * prefix)
+{
+  GstStructure *config;
+  GstAllocationParams params;
+  guint pool_size = 0;
+  gboolean ret;
+
+  g_return_val_if_fail (GST_IS_BUFFER_POOL (pool), FALSE);
+  g_return_val_if_fail (prefix != NULL, FALSE);
+
+  /* the pool may be already activated by the other element */
+  if (!gst_buffer_pool_is_active (pool)) {
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, caps, size, min, max);
+
+    if (!gst_buffer_pool_set_config (pool, config) ||
+        !gst_buffer_pool_set_active (pool, TRUE)) {
+      nns_logw ("Failed to activate the buffer pool.");
+      return FALSE;
+    }
+  }
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_allocation_params_init (&params);
+  gst_buffer_pool_config_get_allocator (config, NULL, &params);
+  ret = gst_buffer_pool_config_get_params (config, NULL, &pool_size,
+      NULL, NULL);
+  gst_structure_free (config);
+
+  *prefix = params.prefix;
+  return (ret && pool_size == size);
+}
+
+/**
+ * @brief Internal function to write the header into the reserved area of the memory.
+ * @return Newly shared GstMemory including the header, NULL if the memory does not have the reserved area or cannot be written.
+ */
+static GstMemory *
+_gst_tensor_meta_info_share_header (GstTensorMetaInfo * meta, GstMemory * mem,
+    gsize hsize)
+{
+  GstMapInfo map;
+
+  if (!GST_MEMORY_FLAG_IS_SET (mem, GST_TENSOR_MEMORY_FLAG_HEADER_ROOM) ||
+      GST_MEMORY_FLAG_IS_SET (mem, GST_MEMORY_FLAG_NO_SHARE) ||
+      mem->offset != hsize)
+    return NULL;
+
+  /**
+   * Writable map fails if the memory is shared with others (e.g., the header is already appended).
+   * The map covers whole memory block, so that the header area is just in front of the data.
+   */
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE))
+    return NULL;
+
+  gst_tensor_meta_info_update_header (meta, map.data - hsize);
+  gst_memory_unmap (mem, &map);
+
+  return gst_memory_share (mem, -((gssize) hsize), hsize + mem->size);
+}
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
  * @param[in] mem pointer to GstMemory
  * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note If the area for the header is reserved in front of the data (see gst_tensor_alloc_with_header_room()), this writes the header and shares the memory without copying the data.
  */
 GstMemory *
 gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
@@ -1857,13 +2042,18 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
   g_return_val_if_fail (mem != NULL, NULL);
   g_return_val_if_fail (gst_tensor_meta_info_validate (meta), NULL);
 
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  new_mem = _gst_tensor_meta_info_share_header (meta, mem, hsize);
+  if (new_mem)
+    return new_mem;
+
   if (!gst_memory_map (mem, &old_map, GST_MAP_READ)) {
     nns_loge ("Failed to append header, cannot map the old memory.");
     return NULL;
   }
 
   /* memory size (header + old memory) */
-  hsize = gst_tensor_meta_info_get_header_size (meta);
   msize = hsize + old_map.size;
 
   new_mem = gst_allocator_alloc (NULL, msize, NULL);
@@ -1876,7 +2066,7 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
 
   /* set header and copy old data */
   gst_tensor_meta_info_update_header (meta, new_map.data);
-  memcpy (new_map.data + hsize, old_map.data, old_map.size);
+  nns_memcpy (new_map.data + hsize, old_map.data, old_map.size);
 
   gst_memory_unmap (mem, &old_map);
   gst_memory_unmap (new_mem, &new_map);
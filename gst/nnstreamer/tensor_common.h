@@ -37,18 +37,26 @@
 #include "tensor_typedef.h"
 #include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
+#include "nnstreamer_tracer.h"
 
 #ifdef HAVE_ORC
 #include <orc/orcfunctions.h>
 
 #define nns_memcpy(d,s,n) do { \
-    if ((n) > 100) orc_memcpy ((d), (s), (n)); \
-    else memcpy ((d), (s), (n)); \
+    const gsize _nns_n = (n); \
+    nns_trace_memcpy (_nns_n); \
+    if (_nns_n > 100) orc_memcpy ((d), (s), _nns_n); \
+    else memcpy ((d), (s), _nns_n); \
   } while (0)
 
 #define nns_memset orc_memset
 #else
-#define nns_memcpy memcpy
+#define nns_memcpy(d,s,n) do { \
+    const gsize _nns_n = (n); \
+    nns_trace_memcpy (_nns_n); \
+    memcpy ((d), (s), _nns_n); \
+  } while (0)
+
 #define nns_memset memset
 #endif
 
@@ -195,5 +203,25 @@ gst_tensor_pad_possible_caps_from_config (GstPad * pad, const GstTensorsConfig *
 extern gboolean
 gst_tensor_pad_caps_is_flexible (GstPad * pad);
 
+/**
+ * @brief Enable the pooled mode of tensor allocator if it is configured ([allocator] pool in nnstreamer.ini).
+ */
+extern void
+gst_tensor_alloc_load_conf (void);
+
+/**
+ * @brief Configure and activate the buffer pool proposed by downstream.
+ * @param pool the buffer pool
+ * @param caps the caps of the buffers in the pool
+ * @param size the size of the tensor to be acquired from the pool
+ * @param min the minimum number of buffers
+ * @param max the maximum number of buffers
+ * @param[out] prefix the size of the area reserved in front of the data, which is configured by downstream
+ * @return TRUE if the pool is activated and the size of its buffer is same with given size.
+ */
+extern gboolean
+gst_tensor_buffer_pool_setup (GstBufferPool * pool, GstCaps * caps,
+    gsize size, guint min, guint max, gsize * prefix);
+
 G_END_DECLS
 #endif /* __GST_TENSOR_COMMON_H__ */
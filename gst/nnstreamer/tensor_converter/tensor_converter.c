@@ -185,6 +185,12 @@ static GstCaps *gst_tensor_converter_query_caps (GstTensorConverter * self,
 static gboolean gst_tensor_converter_parse_caps (GstTensorConverter * self,
     const GstCaps * caps);
 static void gst_tensor_converter_update_caps (GstTensorConverter * self);
+static void gst_tensor_converter_decide_allocation (GstTensorConverter *
+    self, GstCaps * caps);
+static void gst_tensor_converter_clear_allocation (GstTensorConverter *
+    self);
+static GstMemory *gst_tensor_converter_alloc_frame (GstTensorConverter *
+    self, gsize size);
 static const NNStreamerExternalConverter *findExternalConverter (const char
     *media_type_name);
 
@@ -382,6 +388,10 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->mode_option = NULL;
   self->custom.func = NULL;
   self->custom.data = NULL;
+  self->allocator = NULL;
+  gst_allocation_params_init (&self->params);
+  self->pool = NULL;
+  self->pool_prefix = 0;
 
   gst_tensors_info_init (&self->tensors_info);
   gst_tensors_config_init (&self->tensors_config);
@@ -402,6 +412,7 @@ gst_tensor_converter_finalize (GObject * object)
   self = GST_TENSOR_CONVERTER (object);
 
   gst_tensor_converter_reset (self);
+  gst_tensor_converter_clear_allocation (self);
 
   gst_tensors_config_free (&self->tensors_config);
   gst_tensors_info_free (&self->tensors_info);
@@ -707,6 +718,21 @@ gst_tensor_converter_sink_query (GstPad * pad, GstObject * parent,
       gst_query_set_accept_caps_result (query, res);
       return TRUE;
     }
+    case GST_QUERY_ALLOCATION:
+    {
+      /**
+       * The caps of incoming media are different from the output tensor.
+       * Propose the allocation parameters (e.g., alignment) negotiated with downstream,
+       * so that the buffer is pushed to downstream without realigning the data.
+       * The buffer pool of downstream is not proposed because the size of the buffer may be different.
+       */
+      if (self->tensors_configured) {
+        gst_query_add_allocation_param (query, self->allocator,
+            &self->params);
+        return TRUE;
+      }
+      break;
+    }
     default:
       break;
   }
@@ -1064,7 +1090,9 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        inbuf = gst_buffer_new_and_alloc (frame_size);
+        inbuf = gst_buffer_new ();
+        gst_buffer_append_memory (inbuf,
+            gst_tensor_converter_alloc_frame (self, frame_size));
         gst_buffer_memset (inbuf, 0, 0, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf ("Cannot map dest buffer at tensor_converter/video.\n");
@@ -1113,7 +1141,9 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        inbuf = gst_buffer_new_and_alloc (frame_size);
+        inbuf = gst_buffer_new ();
+        gst_buffer_append_memory (inbuf,
+            gst_tensor_converter_alloc_frame (self, frame_size));
         gst_buffer_memset (inbuf, 0, 0, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf ("Cannot map dest buffer at tensor_converter/text.\n");
@@ -1277,6 +1307,7 @@ gst_tensor_converter_change_state (GstElement * element,
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_tensor_converter_reset (self);
+      gst_tensor_converter_clear_allocation (self);
       break;
     default:
       break;
@@ -2038,7 +2069,8 @@ gst_tensor_converter_update_caps (GstTensorConverter * self)
   curr_caps = gst_pad_get_current_caps (self->srcpad);
   if (curr_caps == NULL || !gst_caps_is_equal (curr_caps, out_caps)) {
     silent_debug_caps (out_caps, "set out-caps");
-    gst_pad_set_caps (self->srcpad, out_caps);
+    if (gst_pad_set_caps (self->srcpad, out_caps))
+      gst_tensor_converter_decide_allocation (self, out_caps);
   }
 
   if (curr_caps)
@@ -2047,6 +2079,98 @@ gst_tensor_converter_update_caps (GstTensorConverter * self)
   gst_caps_unref (out_caps);
 }
 
+/**
+ * @brief Release the allocator and buffer pool negotiated with downstream.
+ */
+static void
+gst_tensor_converter_clear_allocation (GstTensorConverter * self)
+{
+  if (self->allocator) {
+    gst_object_unref (self->allocator);
+    self->allocator = NULL;
+  }
+
+  gst_allocation_params_init (&self->params);
+
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+  }
+
+  self->pool_prefix = 0;
+}
+
+/**
+ * @brief Query the allocation to downstream, and keep the allocation parameters and buffer pool.
+ * @details The buffer pool is used only when the converter copies the frame (e.g., removing the padding of video frame).
+ */
+static void
+gst_tensor_converter_decide_allocation (GstTensorConverter * self,
+    GstCaps * caps)
+{
+  GstTensorsConfig *config;
+  GstQuery *query;
+  GstBufferPool *pool = NULL;
+  guint size, min, max;
+  gboolean need_pool;
+
+  gst_tensor_converter_clear_allocation (self);
+
+  config = &self->tensors_config;
+  need_pool = (config->info.num_tensors == 1 &&
+      (self->remove_padding || self->in_media_type == _NNS_TEXT));
+
+  query = gst_query_new_allocation (caps, need_pool);
+  if (!gst_pad_peer_query (self->srcpad, query)) {
+    GST_DEBUG_OBJECT (self, "Failed to query the allocation to downstream.");
+    goto done;
+  }
+
+  if (gst_query_get_n_allocation_params (query) > 0)
+    gst_query_parse_nth_allocation_param (query, 0, &self->allocator,
+        &self->params);
+
+  if (need_pool && gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+
+    if (pool) {
+      if (gst_tensor_buffer_pool_setup (pool, caps,
+              gst_tensors_info_get_size (&config->info, 0), min, max,
+              &self->pool_prefix))
+        self->pool = pool;
+      else
+        gst_object_unref (pool);
+    }
+  }
+
+  silent_debug ("Decided allocation: align %zu, pool %s", self->params.align,
+      self->pool ? "downstream" : "none");
+
+done:
+  gst_query_unref (query);
+}
+
+/**
+ * @brief Allocate the memory to copy the frame, with the buffer pool or the allocation parameters negotiated with downstream.
+ */
+static GstMemory *
+gst_tensor_converter_alloc_frame (GstTensorConverter * self, gsize size)
+{
+  GstMemory *mem = NULL;
+
+  if (self->pool)
+    mem = gst_tensor_buffer_pool_alloc_memory (self->pool, size,
+        self->pool_prefix);
+
+  /* reserve the header area for flexible tensor downstream */
+  if (mem == NULL)
+    mem = gst_tensor_alloc_with_header_room_full (size, self->allocator,
+        &self->params);
+
+  return mem;
+}
+
 /**
  * @brief Find converter sub-plugin with the name.
  * @param[in] name The name of converter sub-plugin.
@@ -106,6 +106,11 @@ struct _GstTensorConverter
   gchar *ext_fw; /**< tensor converter custom mode framework */
   converter_custom_cb_s custom;
 
+  GstAllocator *allocator; /**< allocator negotiated with downstream (NULL for default) */
+  GstAllocationParams params; /**< allocation parameters negotiated with downstream */
+  GstBufferPool *pool; /**< buffer pool proposed by downstream, used when the converter copies the frame */
+  gsize pool_prefix; /**< size of the area reserved in front of the data in the buffer pool */
+
   void *priv_data; /**< plugin's private data */
 };
 
@@ -61,6 +61,13 @@
  * with more tight QoS requirement. Lastly, 'tensor_filter' also sends QoS events to
  * upstream elements (e.g., tensor_converter, tensor_src) to possibly reduce incoming
  * framerates, which is a better solution than dropping framerates.
+ *
+ * With the property 'deadline', each buffer has a deadline (running-time of the buffer
+ * timestamp + deadline budget) on the pipeline clock. 'tensor_filter' predicts the time
+ * to complete the invoke with recent latencies and the frames in flight, and drops the
+ * frame before invoking if it would finish late (e.g., the buffers in a backlogged queue).
+ * Then it sends a QoS underflow event to upstream elements and posts a QoS message.
+ * The QoS events from downstream sinks are also handled in this mode.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -147,9 +154,15 @@ static void gst_tensor_filter_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_filter_finalize (GObject * object);
 
+/* GstElement vmethod implementations */
+static GstStateChangeReturn gst_tensor_filter_change_state (GstElement *
+    element, GstStateChange transition);
+
 /* GstBaseTransform vmethod implementations */
 static GstFlowReturn gst_tensor_filter_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_tensor_filter_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
 static GstCaps *gst_tensor_filter_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
@@ -159,6 +172,8 @@ static gboolean gst_tensor_filter_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensor_filter_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensor_filter_propose_allocation (GstBaseTransform *
+    trans, GstQuery * decide_query, GstQuery * query);
 static gboolean gst_tensor_filter_start (GstBaseTransform * trans);
 static gboolean gst_tensor_filter_stop (GstBaseTransform * trans);
 static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
@@ -166,6 +181,34 @@ static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
 static gboolean gst_tensor_filter_src_event (GstBaseTransform * trans,
     GstEvent * event);
 
+/* internal functions for output buffer pools */
+static void gst_tensor_filter_release_pools (GstTensorFilter * self);
+
+/* internal functions for asynchronous invoke */
+static inline gboolean gst_tensor_filter_async_enabled (GstTensorFilter * self);
+static void gst_tensor_filter_async_drain (GstTensorFilter * self);
+static void gst_tensor_filter_async_clear (GstTensorFilter * self);
+static void gst_tensor_filter_async_stop (GstTensorFilter * self);
+static void gst_tensor_filter_workers_stop (GstTensorFilter * self);
+
+/* internal functions for micro-batching */
+static void gst_tensor_filter_batch_clear (GstTensorFilter * self);
+static void gst_tensor_filter_batch_flush (GstTensorFilter * self);
+static void gst_tensor_filter_batch_stop (GstTensorFilter * self);
+static void gst_tensor_filter_reset_latency (GstTensorFilter * self);
+
+/* internal functions for invoke cache */
+static void gst_tensor_filter_cache_clear (GstTensorFilter * self);
+
+/* internal functions for output ring */
+static gboolean gst_tensor_filter_ring_active (GstTensorFilter * self);
+static void gst_tensor_filter_ring_release (GstTensorFilter * self);
+
+/* internal functions for model hot swap */
+static gboolean gst_tensor_filter_swap_request (GstTensorFilter * self,
+    const gchar * model_files);
+static void gst_tensor_filter_swap_stop (GstTensorFilter * self);
+
 /**
  * @brief initialize the tensor_filter's class
  */
@@ -189,6 +232,19 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   gst_tensor_filter_install_properties (gobject_class);
 
+  /**
+   * GstTensorFilter::reset-latency:
+   *
+   * Action signal to reset the latency histogram (latency-p50, p90, p99 and max).
+   */
+  g_signal_new_class_handler ("reset-latency", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_CALLBACK (gst_tensor_filter_reset_latency), NULL, NULL, NULL,
+      G_TYPE_NONE, 0);
+
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_change_state);
+
   gst_element_class_set_details_simple (gstelement_class,
       "TensorFilter",
       "Filter/Tensor",
@@ -205,6 +261,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_filter_transform);
+  trans_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_ip);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -215,6 +273,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_size);
+  trans_class->propose_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_propose_allocation);
 
   /* setup events */
   trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_filter_sink_event);
@@ -239,6 +299,46 @@ gst_tensor_filter_init (GstTensorFilter * self)
   priv = &self->priv;
 
   gst_tensor_filter_common_init_property (priv);
+
+  g_mutex_init (&self->async_lock);
+  g_cond_init (&self->async_cond);
+  g_queue_init (&self->async_frames);
+  self->async_flushing = FALSE;
+  self->async_flow = GST_FLOW_OK;
+
+  g_mutex_init (&self->batch_lock);
+  g_cond_init (&self->batch_cond);
+  self->batch_thread = NULL;
+  self->batch_running = FALSE;
+  self->batch_frames =
+      g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  memset (self->batch_in_mem, 0, sizeof (self->batch_in_mem));
+  self->batch_deadline = 0;
+  self->batch_flow = GST_FLOW_OK;
+  self->batch_push_next = 0;
+  self->batch_push_turn = 0;
+
+  self->workers = NULL;
+  self->num_workers = 0;
+  self->worker_seq = 0;
+
+  self->in_place = FALSE;
+
+  self->loader_thread = NULL;
+
+  self->out_ring = NULL;
+  self->out_ring_checked = FALSE;
+
+  g_mutex_init (&self->cache_lock);
+  g_queue_init (&self->cache_lru);
+  self->cache_table = g_hash_table_new (g_int64_hash, g_int64_equal);
+  self->cache_used = 0;
+
+  g_mutex_init (&self->swap_lock);
+  self->swap_thread = NULL;
+  self->swap_running = FALSE;
+  self->swap_pending = NULL;
+  self->swap_ready = NULL;
 }
 
 /**
@@ -253,12 +353,332 @@ gst_tensor_filter_finalize (GObject * object)
   self = GST_TENSOR_FILTER (object);
   priv = &self->priv;
 
+  gst_tensor_filter_async_clear (self);
+  gst_tensor_filter_workers_stop (self);
+  gst_tensor_filter_batch_stop (self);
+  gst_tensor_filter_swap_stop (self);
+  gst_tensor_filter_release_pools (self);
+  gst_tensor_filter_ring_release (self);
+  gst_tensor_filter_cache_clear (self);
   gst_tensor_filter_common_close_fw (priv);
   gst_tensor_filter_common_free_property (priv);
 
+  g_mutex_clear (&self->async_lock);
+  g_cond_clear (&self->async_cond);
+
+  g_ptr_array_free (self->batch_frames, TRUE);
+  g_mutex_clear (&self->batch_lock);
+  g_cond_clear (&self->batch_cond);
+
+  g_hash_table_destroy (self->cache_table);
+  g_mutex_clear (&self->cache_lock);
+
+  g_mutex_clear (&self->swap_lock);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief The thread to open the framework in background. The warm-up runs when the element starts.
+ */
+static gpointer
+gst_tensor_filter_loader_func (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+
+  gst_tensor_filter_common_open_fw (&self->priv);
+
+  return NULL;
+}
+
+/**
+ * @brief Start the background thread to open the framework if preload is enabled.
+ */
+static void
+gst_tensor_filter_loader_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  if (!priv->preload || priv->fw == NULL || priv->prop.fw_opened)
+    return;
+
+  GST_OBJECT_LOCK (self);
+  if (self->loader_thread == NULL) {
+    self->loader_thread = g_thread_new ("tensor_filter_loader",
+        gst_tensor_filter_loader_func, self);
+  }
+  GST_OBJECT_UNLOCK (self);
+}
+
+/**
+ * @brief Wait for the background thread opening the framework.
+ * @return TRUE if the framework is opened.
+ * @note The error of opening the framework is reported when the element starts.
+ */
+static gboolean
+gst_tensor_filter_loader_wait (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GThread *thread;
+
+  GST_OBJECT_LOCK (self);
+  thread = self->loader_thread;
+  self->loader_thread = NULL;
+  GST_OBJECT_UNLOCK (self);
+
+  if (thread)
+    g_thread_join (thread);
+
+  return priv->prop.fw_opened;
+}
+
+/**
+ * @brief Check the property is used to open the framework, which should not be updated while opening it in background.
+ */
+static gboolean
+gst_tensor_filter_loader_uses_property (guint prop_id)
+{
+  switch (prop_id) {
+    case PROP_FRAMEWORK:
+    case PROP_MODEL:
+    case PROP_INPUT:
+    case PROP_INPUTTYPE:
+    case PROP_INPUTNAME:
+    case PROP_INPUTLAYOUT:
+    case PROP_INPUTRANKS:
+    case PROP_OUTPUT:
+    case PROP_OUTPUTTYPE:
+    case PROP_OUTPUTNAME:
+    case PROP_OUTPUTLAYOUT:
+    case PROP_OUTPUTRANKS:
+    case PROP_CUSTOM:
+    case PROP_ACCELERATOR:
+    case PROP_IS_UPDATABLE:
+    case PROP_SHARED_TENSOR_FILTER_KEY:
+    case PROP_SHARED_POOL_SIZE:
+      return TRUE;
+    default:
+      break;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief The thread to load new model in background. The latest requested model is loaded if the model is updated while loading.
+ */
+static gpointer
+gst_tensor_filter_swap_func (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterModelSwap *swap, *replaced;
+  gchar *model_files;
+
+  while (TRUE) {
+    g_mutex_lock (&self->swap_lock);
+    model_files = self->swap_pending;
+    self->swap_pending = NULL;
+    if (model_files == NULL)
+      self->swap_running = FALSE;
+    g_mutex_unlock (&self->swap_lock);
+
+    if (model_files == NULL)
+      break;
+
+    GST_INFO_OBJECT (self, "Loading new model %s in background.", model_files);
+    swap = gst_tensor_filter_common_swap_prepare (priv, model_files,
+        priv->hot_swap_validate);
+
+    if (swap) {
+      g_mutex_lock (&self->swap_lock);
+      /* replace the model not swapped yet */
+      replaced = self->swap_ready;
+      g_atomic_pointer_set (&self->swap_ready, swap);
+      g_mutex_unlock (&self->swap_lock);
+
+      /* close the replaced model out of the lock */
+      gst_tensor_filter_common_swap_free (priv, replaced);
+    } else {
+      GST_ELEMENT_WARNING (self, RESOURCE, OPEN_READ,
+          ("Failed to load the model %s, keep the running model.",
+              model_files), (NULL));
+    }
+
+    g_free (model_files);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Request to load new model in background if hot swap is available.
+ * @return TRUE if new model will be swapped at a frame boundary. FALSE to update the model with the common property handler, which reloads it only if is-updatable is set.
+ */
+static gboolean
+gst_tensor_filter_swap_request (GstTensorFilter * self,
+    const gchar * model_files)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GThread *finished = NULL;
+
+  /* same as the model update with the event, the model should be updatable */
+  if (!priv->hot_swap || !priv->is_updatable || model_files == NULL)
+    return FALSE;
+
+  /* the model should be opened, and parallel or batched contexts cannot be swapped */
+  if (!priv->prop.fw_opened || priv->fw == NULL || priv->shared_model ||
+      priv->num_instances > 1 || priv->batch_configured > 1)
+    return FALSE;
+
+  /**
+   * The output allocated by the subplugin is released with the running context,
+   * which may be downstream after swapping. Reload the model synchronously.
+   */
+  if (gst_tensor_filter_allocate_in_invoke (priv))
+    return FALSE;
+
+  g_mutex_lock (&self->swap_lock);
+  g_free (self->swap_pending);
+  self->swap_pending = g_strdup (model_files);
+
+  if (!self->swap_running) {
+    finished = self->swap_thread;
+    self->swap_running = TRUE;
+    self->swap_thread = g_thread_new ("tensor_filter_swap",
+        gst_tensor_filter_swap_func, self);
+  }
+  g_mutex_unlock (&self->swap_lock);
+
+  if (finished)
+    g_thread_join (finished);
+
+  return TRUE;
+}
+
+/**
+ * @brief Swap the model loaded in background at a frame boundary, and post the element message with the swap time.
+ */
+static void
+gst_tensor_filter_swap_commit (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterModelSwap *swap;
+  GstStructure *s;
+  gchar *model_files;
+  gint64 start_time, load_time, swap_time;
+  gboolean validated;
+
+  if (G_LIKELY (g_atomic_pointer_get (&self->swap_ready) == NULL))
+    return;
+
+  g_mutex_lock (&self->swap_lock);
+  swap = self->swap_ready;
+  self->swap_ready = NULL;
+  g_mutex_unlock (&self->swap_lock);
+
+  if (swap == NULL)
+    return;
+
+  start_time = g_get_monotonic_time ();
+
+  /* the frames in flight are invoked with the running model */
+  gst_tensor_filter_async_drain (self);
+
+  model_files = g_strjoinv (",", (gchar **) swap->model_files);
+  load_time = swap->load_time;
+  validated = swap->validated;
+
+  /* the output ring belongs to the running model */
+  gst_tensor_filter_ring_release (self);
+
+  /* get-property reads the model files with the object lock */
+  GST_OBJECT_LOCK (self);
+  gst_tensor_filter_common_swap_commit (priv, swap);
+  GST_OBJECT_UNLOCK (self);
+
+  /* the old model is closed and freed */
+  gst_tensor_filter_common_swap_free (priv, swap);
+  gst_tensor_filter_cache_clear (self);
+
+  swap_time = g_get_monotonic_time () - start_time;
+  GST_INFO_OBJECT (self, "Swapped the model %s (load %" G_GINT64_FORMAT
+      " usec, swap %" G_GINT64_FORMAT " usec).", model_files, load_time,
+      swap_time);
+
+  s = gst_structure_new ("nnstreamer-model-swap",
+      "model", G_TYPE_STRING, model_files,
+      "load-time", G_TYPE_INT64, load_time,
+      "swap-time", G_TYPE_INT64, swap_time,
+      "validated", G_TYPE_BOOLEAN, validated, NULL);
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+
+  g_free (model_files);
+}
+
+/**
+ * @brief Stop loading new model and free the model not swapped yet.
+ */
+static void
+gst_tensor_filter_swap_stop (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GThread *thread;
+
+  g_mutex_lock (&self->swap_lock);
+  g_free (self->swap_pending);
+  self->swap_pending = NULL;
+  thread = self->swap_thread;
+  self->swap_thread = NULL;
+  g_mutex_unlock (&self->swap_lock);
+
+  if (thread)
+    g_thread_join (thread);
+
+  g_mutex_lock (&self->swap_lock);
+  gst_tensor_filter_common_swap_free (priv, self->swap_ready);
+  self->swap_ready = NULL;
+  g_mutex_unlock (&self->swap_lock);
+}
+
+/**
+ * @brief Handle the state change. Stop the output task before deactivating the pads.
+ */
+static GstStateChangeReturn
+gst_tensor_filter_change_state (GstElement * element, GstStateChange transition)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER (element);
+  GstStateChangeReturn ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_NULL_TO_READY:
+      /* overlap loading the model with the state change of other elements */
+      gst_tensor_filter_loader_start (self);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_tensor_filter_async_stop (self);
+      gst_tensor_filter_batch_stop (self);
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_NULL:
+      /* the framework may be opened in background but the element is not started */
+      gst_tensor_filter_loader_wait (self);
+      gst_tensor_filter_common_close_fw (&self->priv);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
 /**
  * @brief Calculate tensor buffer size.
  * @param self "this" pointer
@@ -299,8 +719,53 @@ gst_tensor_filter_set_property (GObject * object, guint prop_id,
 
   silent_debug ("Setting property for prop %d.\n", prop_id);
 
-  if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
+  /* do not update the properties used to open the framework while opening it */
+  if (gst_tensor_filter_loader_uses_property (prop_id))
+    gst_tensor_filter_loader_wait (self);
+
+  if (prop_id == PROP_INVOKE_CACHE && g_value_get_boolean (value)) {
+    /* the cached outputs would hold the slots of the output ring */
+    if (gst_tensor_filter_ring_active (self)) {
+      GST_WARNING_OBJECT (self,
+          "Cannot enable invoke-cache, the subplugin provides the output ring.");
+      return;
+    }
+
+    /* the frames are not looked up in the cache in the other paths */
+    if (gst_tensor_filter_cache_bypassed (self)) {
+      GST_WARNING_OBJECT (self,
+          "Cannot enable invoke-cache with asynchronous invoke, micro-batching or in-place invoke.");
+      return;
+    }
+  }
+
+  /* load new model in background, the running model keeps invoking the frames */
+  if (prop_id == PROP_MODEL &&
+      gst_tensor_filter_swap_request (self, g_value_get_string (value)))
+    return;
+
+  if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec)) {
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    return;
+  }
+
+  switch (prop_id) {
+    case PROP_MODEL:
+    case PROP_INVOKE_CACHE:
+    case PROP_INVOKE_CACHE_SIZE:
+      /* the cached outputs are invalid with new model */
+      gst_tensor_filter_cache_clear (self);
+      break;
+    case PROP_MAX_INFLIGHT:
+    case PROP_NUM_INSTANCES:
+    case PROP_BATCH_SIZE:
+      if (priv->invoke_cache && gst_tensor_filter_cache_bypassed (self))
+        GST_WARNING_OBJECT (self,
+            "The invoke-cache is not used with asynchronous invoke or micro-batching.");
+      break;
+    default:
+      break;
+  }
 }
 
 /**
@@ -318,8 +783,15 @@ gst_tensor_filter_get_property (GObject * object, guint prop_id,
 
   silent_debug ("Getting property for prop %d.\n", prop_id);
 
+  /* the model files are replaced with the object lock when swapping the model */
+  if (prop_id == PROP_MODEL)
+    GST_OBJECT_LOCK (self);
+
   if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+
+  if (prop_id == PROP_MODEL)
+    GST_OBJECT_UNLOCK (self);
 }
 
 /**
@@ -357,226 +829,2513 @@ gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self, gpointer data,
 }
 
 /**
- * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
+ * @brief Release the output buffer pools.
+ * @note The buffers in use are freed when downstream releases them.
  */
 static void
-prepare_statistics (GstTensorFilterPrivate * priv)
+gst_tensor_filter_release_pools (GstTensorFilter * self)
 {
-  priv->stat.latest_invoke_time = g_get_real_time ();
+  GstTensorFilterPrivate *priv = &self->priv;
+  guint i;
+
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (priv->out_pool[i]) {
+      gst_buffer_pool_set_active (priv->out_pool[i], FALSE);
+      gst_object_unref (priv->out_pool[i]);
+      priv->out_pool[i] = NULL;
+    }
+
+    if (priv->batch_out_pool[i]) {
+      gst_buffer_pool_set_active (priv->batch_out_pool[i], FALSE);
+      gst_object_unref (priv->batch_out_pool[i]);
+      priv->batch_out_pool[i] = NULL;
+    }
+  }
 }
 
 /**
- * @brief Helper function to accumulate latencies
+ * @brief Entry of the invoke cache.
  */
-static void
-accumulate_latency (void *data, void *user_data)
+typedef struct
 {
-  gint64 *latency = data;
-  gint64 *total_latency = user_data;
+  guint64 key; /**< the hash of the input tensors */
+  guint num_inputs; /**< number of the input memories */
+  GstMemory *inputs[NNS_TENSOR_SIZE_LIMIT]; /**< the input memories compared with new input of the same hash (locked exclusively, so that upstream cannot write) */
+  guint num_mems; /**< number of the output memories */
+  GstMemory *mems[NNS_TENSOR_SIZE_LIMIT]; /**< the output memories shared with downstream (locked exclusively, so that downstream cannot write) */
+  gsize size; /**< the size of the input and output memories held by the entry */
+} GstTensorFilterCacheEntry;
 
-  *total_latency += *latency;
+/**
+ * @brief Hold the memory in the entry of the invoke cache.
+ */
+static inline GstMemory *
+gst_tensor_filter_cache_hold_memory (GstMemory * mem)
+{
+  gst_memory_ref (mem);
+  gst_memory_lock (mem, GST_LOCK_FLAG_EXCLUSIVE);
+  return mem;
 }
 
-#define THRESHOLD_DROP_OLD  (2000)
-#define THRESHOLD_CACHE_OLD (1000)
+/**
+ * @brief Release the memory held in the entry of the invoke cache.
+ */
+static inline void
+gst_tensor_filter_cache_release_memory (GstMemory * mem)
+{
+  gst_memory_unlock (mem, GST_LOCK_FLAG_EXCLUSIVE);
+  gst_memory_unref (mem);
+}
 
 /**
- * @brief Record statistics for performance profiling (e.g, latency, throughput)
+ * @brief Free the entry of the invoke cache.
  */
 static void
-record_statistics (GstTensorFilterPrivate * priv)
+gst_tensor_filter_cache_entry_free (GstTensorFilterCacheEntry * entry)
 {
-  gint64 end_time = g_get_real_time ();
-  gint64 *latency = g_new (gint64, 1);
-  GQueue *recent_latencies = priv->stat.recent_latencies;
-
-  *latency = end_time - priv->stat.latest_invoke_time;
-  priv->stat.total_invoke_latency += *latency;
-  priv->stat.total_invoke_num += 1;
+  guint i;
 
-  if (g_queue_get_length (recent_latencies) == GST_TF_STAT_MAX_RECENT)
-    g_free (g_queue_pop_head (recent_latencies));
-  g_queue_push_tail (recent_latencies, latency);
+  for (i = 0; i < entry->num_inputs; i++)
+    gst_tensor_filter_cache_release_memory (entry->inputs[i]);
 
-  /* the queue should have at least one element */
-  g_assert (g_queue_get_length (recent_latencies) != 0);
+  for (i = 0; i < entry->num_mems; i++)
+    gst_tensor_filter_cache_release_memory (entry->mems[i]);
 
-  if (priv->latency_mode > 0) {
-    gint64 avg_latency = 0;
+  g_free (entry);
+}
 
-    g_queue_foreach (recent_latencies, accumulate_latency, &avg_latency);
-    avg_latency /= g_queue_get_length (recent_latencies);
+/**
+ * @brief Check the input tensors are same as the input of cached entry.
+ * This is called only if the hash is same, to compare the data of the input memories.
+ */
+static gboolean
+gst_tensor_filter_cache_entry_match (GstTensorFilterCacheEntry * entry,
+    GstBuffer * inbuf)
+{
+  GstMemory *mem;
+  GstMapInfo map, cached;
+  gboolean matched = TRUE;
+  guint i;
 
-    /* check integer overflow */
-    if (avg_latency <= INT32_MAX)
-      priv->prop.latency = (gint) avg_latency;
-    else
-      priv->prop.latency = -1;
+  if (gst_buffer_n_memory (inbuf) != entry->num_inputs)
+    return FALSE;
 
-    ml_logi ("[%s] Invoke took %.3f ms", priv->prop.model_files[0],
-        (*latency) / 1000.0);
-  }
+  for (i = 0; i < entry->num_inputs && matched; i++) {
+    mem = gst_buffer_peek_memory (inbuf, i);
 
-  if (priv->throughput_mode > 0) {
-    gint throughput_int = -1;
+    /* same memory block, which cannot be written while the entry holds it */
+    if (mem == entry->inputs[i])
+      continue;
 
-    if (priv->stat.total_invoke_latency != 0) {
-      gdouble throughput =
-          (gdouble) (priv->stat.total_invoke_num * G_USEC_PER_SEC * 1000) /
-          priv->stat.total_invoke_latency;
+    if (!gst_memory_map (mem, &map, GST_MAP_READ))
+      return FALSE;
 
-      /* check integer overflow */
-      if (throughput <= INT32_MAX)
-        throughput_int = (gint) throughput;
+    if (!gst_memory_map (entry->inputs[i], &cached, GST_MAP_READ)) {
+      gst_memory_unmap (mem, &map);
+      return FALSE;
     }
 
-    /* note that it's a 1000x larger value than actual throughput */
-    priv->prop.throughput = throughput_int;
-
-    ml_logi ("[%s] Throughput: %.2f FPS", priv->prop.model_files[0],
-        throughput_int / 1000.0);
+    matched = (map.size == cached.size &&
+        memcmp (cached.data, map.data, map.size) == 0);
+    gst_memory_unmap (entry->inputs[i], &cached);
+    gst_memory_unmap (mem, &map);
   }
 
-  /**
-   * statistics values are monotonously increasing.
-   * to avoid potential overflow, let's cache old values and subtract them
-   * from the statistics if some threshold is exceeded.
-   */
-  if (priv->stat.total_invoke_num > THRESHOLD_DROP_OLD) {
-    priv->stat.total_invoke_latency -= priv->stat.old_total_invoke_latency;
-    priv->stat.total_invoke_num -= priv->stat.old_total_invoke_num;
-    /* drop cached values */
-    priv->stat.old_total_invoke_latency = 0;
-    priv->stat.old_total_invoke_num = 0;
-  } else if (priv->stat.total_invoke_num > THRESHOLD_CACHE_OLD) {
-    /* cache old values if they are not yet set */
-    if (priv->stat.old_total_invoke_num == 0) {
-      priv->stat.old_total_invoke_latency = priv->stat.total_invoke_latency;
-      priv->stat.old_total_invoke_num = priv->stat.total_invoke_num;
-    }
-  }
+  return matched;
 }
 
 /**
- * @brief Check throttling delay and send qos overflow event to upstream elements
+ * @brief Remove the entry from the cache. Caller should hold the cache lock.
  */
-static gboolean
-gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
-    GstBuffer * inbuf)
+static void
+gst_tensor_filter_cache_remove (GstTensorFilter * self, GList * link)
 {
-  GstTensorFilter *self;
-  GstTensorFilterPrivate *priv;
+  GstTensorFilterCacheEntry *entry = link->data;
 
-  self = GST_TENSOR_FILTER_CAST (trans);
-  priv = &self->priv;
+  g_hash_table_remove (self->cache_table, &entry->key);
+  g_queue_delete_link (&self->cache_lru, link);
+  self->cache_used -= entry->size;
+  gst_tensor_filter_cache_entry_free (entry);
+}
 
-  GST_OBJECT_LOCK (trans);
+/**
+ * @brief Remove all cached outputs.
+ */
+static void
+gst_tensor_filter_cache_clear (GstTensorFilter * self)
+{
+  GstTensorFilterCacheEntry *entry;
 
-  if (priv->throttling_delay != 0) {
-    GstClockTime curr_ts = GST_BUFFER_PTS (inbuf);
-    GstClockTime prev_ts = priv->prev_ts;
+  g_mutex_lock (&self->cache_lock);
 
-    priv->prev_ts = curr_ts;
+  g_hash_table_remove_all (self->cache_table);
+  while ((entry = g_queue_pop_head (&self->cache_lru)) != NULL)
+    gst_tensor_filter_cache_entry_free (entry);
+  self->cache_used = 0;
 
-    if (GST_CLOCK_TIME_IS_VALID (prev_ts)) {
-      GstClockTimeDiff diff = curr_ts - prev_ts;
-      GstClockTimeDiff delay;
+  g_mutex_unlock (&self->cache_lock);
+}
 
-      priv->throttling_accum += diff;
+/**
+ * @brief Check whether the frames are invoked in the paths without the invoke cache (asynchronous invoke, micro-batching and in-place invoke).
+ */
+static gboolean
+gst_tensor_filter_cache_bypassed (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
 
-      /* check whether the average latency is longer than throttling delay */
-      delay = MAX (priv->prop.latency * 1000, priv->throttling_delay);
+  return (self->in_place || priv->batch_size > 1 ||
+      priv->batch_configured > 1 || gst_tensor_filter_async_enabled (self));
+}
 
-      if (priv->throttling_accum < delay) {
-        GstClockTimeDiff duration = GST_BUFFER_DURATION (inbuf);        /* original */
-        gdouble avg_rate = gst_guint64_to_gdouble (duration) /
-            gst_guint64_to_gdouble (delay);
+/**
+ * @brief Check whether the invoke cache is available.
+ * The cache keeps the model output only, so this is not available if the input tensors are appended to the output.
+ */
+static inline gboolean
+gst_tensor_filter_cache_enabled (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
 
-        /**
-         * Send qos overflow event to upstream elements.
-         * Upstream elements (e.g., tensor_src, tensor_converter) may handle this.
+  return (priv->invoke_cache && priv->invoke_cache_size > 0 &&
+      !priv->combi.out_combi_i_defined &&
+      !gst_tensor_filter_cache_bypassed (self));
+}
+
+#define GST_TF_HASH_PRIME1 G_GUINT64_CONSTANT (0x9E3779B185EBCA87)
+#define GST_TF_HASH_PRIME2 G_GUINT64_CONSTANT (0xC2B2AE3D27D4EB4F)
+#define GST_TF_HASH_ROTL(x,r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+/**
+ * @brief Get the 64-bit hash of the input tensors.
+ * @return TRUE if all memories are mapped and hashed.
+ */
+static gboolean
+gst_tensor_filter_cache_hash (GstBuffer * inbuf, guint64 * hash)
+{
+  GstMemory *mem;
+  GstMapInfo map;
+  guint64 h, k;
+  guint i, num_mems;
+  gsize j;
+
+  num_mems = gst_buffer_n_memory (inbuf);
+  h = GST_TF_HASH_PRIME2 ^ num_mems;
+
+  for (i = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (inbuf, i);
+    if (!gst_memory_map (mem, &map, GST_MAP_READ))
+      return FALSE;
+
+    /* 8 bytes at a time, then the remaining bytes */
+    for (j = 0; j + 8 <= map.size; j += 8) {
+      memcpy (&k, map.data + j, 8);
+      k *= GST_TF_HASH_PRIME2;
+      k = GST_TF_HASH_ROTL (k, 31) * GST_TF_HASH_PRIME1;
+      h ^= k;
+      h = GST_TF_HASH_ROTL (h, 27) * GST_TF_HASH_PRIME1 + 0x52DCE729;
+    }
+
+    for (; j < map.size; j++) {
+      h ^= map.data[j] * GST_TF_HASH_PRIME1;
+      h = GST_TF_HASH_ROTL (h, 11) * GST_TF_HASH_PRIME2;
+    }
+
+    h ^= (guint64) map.size;
+    gst_memory_unmap (mem, &map);
+  }
+
+  /* final mix */
+  h ^= h >> 33;
+  h *= GST_TF_HASH_PRIME2;
+  h ^= h >> 29;
+  h *= GST_TF_HASH_PRIME1;
+  h ^= h >> 32;
+
+  *hash = h;
+  return TRUE;
+}
+
+/**
+ * @brief Find the cached output and append the output memories to the buffer.
+ * @return TRUE if the output is found.
+ */
+static gboolean
+gst_tensor_filter_cache_lookup (GstTensorFilter * self, guint64 key,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilterCacheEntry *entry;
+  GList *link;
+  guint i;
+
+  g_mutex_lock (&self->cache_lock);
+
+  link = g_hash_table_lookup (self->cache_table, &key);
+
+  /* the hash may collide, compare the input tensors */
+  if (link && !gst_tensor_filter_cache_entry_match (link->data, inbuf))
+    link = NULL;
+
+  if (link) {
+    entry = link->data;
+
+    for (i = 0; i < entry->num_mems; i++)
+      gst_buffer_append_memory (outbuf, gst_memory_ref (entry->mems[i]));
+
+    /* the most recently used */
+    g_queue_unlink (&self->cache_lru, link);
+    g_queue_push_head_link (&self->cache_lru, link);
+  }
+
+  g_mutex_unlock (&self->cache_lock);
+  return (link != NULL);
+}
+
+/**
+ * @brief Add the output memories to the cache, and evict the least recently used outputs if the cache is full.
+ * @note The cache holds the input and output memories without copying them, the memory from the output pool is returned to the pool when the entry is evicted.
+ */
+static void
+gst_tensor_filter_cache_insert (GstTensorFilter * self, guint64 key,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterCacheEntry *entry;
+  GList *link;
+  guint i, num_inputs, num_mems;
+  gsize size;
+
+  num_inputs = gst_buffer_n_memory (inbuf);
+  num_mems = gst_buffer_n_memory (outbuf);
+  size = gst_buffer_get_size (outbuf) + gst_buffer_get_size (inbuf);
+
+  if (num_mems == 0 || num_mems > NNS_TENSOR_SIZE_LIMIT ||
+      num_inputs > NNS_TENSOR_SIZE_LIMIT || size > priv->invoke_cache_size)
+    return;
+
+  entry = g_new0 (GstTensorFilterCacheEntry, 1);
+  entry->key = key;
+  entry->size = size;
+
+  for (i = 0; i < num_inputs; i++) {
+    entry->inputs[i] = gst_tensor_filter_cache_hold_memory
+        (gst_buffer_peek_memory (inbuf, i));
+    entry->num_inputs++;
+  }
+
+  for (i = 0; i < num_mems; i++) {
+    entry->mems[i] = gst_tensor_filter_cache_hold_memory
+        (gst_buffer_peek_memory (outbuf, i));
+    entry->num_mems++;
+  }
+
+  g_mutex_lock (&self->cache_lock);
+
+  link = g_hash_table_lookup (self->cache_table, &key);
+  if (link) {
+    if (gst_tensor_filter_cache_entry_match (link->data, inbuf)) {
+      g_mutex_unlock (&self->cache_lock);
+      gst_tensor_filter_cache_entry_free (entry);
+      return;
+    }
+
+    /* hash collision, keep the recent input */
+    gst_tensor_filter_cache_remove (self, link);
+  }
+
+  /* evict the least recently used outputs */
+  while (self->cache_used + size > priv->invoke_cache_size &&
+      !g_queue_is_empty (&self->cache_lru))
+    gst_tensor_filter_cache_remove (self, g_queue_peek_tail_link
+        (&self->cache_lru));
+
+  g_queue_push_head (&self->cache_lru, entry);
+  g_hash_table_insert (self->cache_table, &entry->key,
+      g_queue_peek_head_link (&self->cache_lru));
+  self->cache_used += size;
+
+  g_mutex_unlock (&self->cache_lock);
+}
+
+/**
+ * @brief Initialize the allocation parameters of the output tensor, with the memory alignment required by the framework.
+ */
+static void
+gst_tensor_filter_init_output_params (GstTensorFilterPrivate * priv,
+    GstAllocationParams * params)
+{
+  gst_allocation_params_init (params);
+  if (priv->info.mem_align > 0)
+    params->align = priv->info.mem_align - 1;
+}
+
+/**
+ * @brief Create new buffer pool for the output tensor.
+ * @details The pool uses the default allocator, which is the tensor allocator
+ *          if it is registered, to keep the memory alignment.
+ */
+static GstBufferPool *
+gst_tensor_filter_create_pool (GstTensorFilter * self, gsize size,
+    gsize prefix)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstAllocationParams params;
+  guint min_buffers;
+
+  min_buffers = MIN (priv->pool_min_buffers, priv->pool_size);
+
+  gst_tensor_filter_init_output_params (priv, &params);
+  if (prefix > 0) {
+    params.flags = GST_TENSOR_MEMORY_FLAG_HEADER_ROOM;
+    params.prefix = prefix;
+  }
+
+  pool = gst_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, NULL, size, min_buffers,
+      priv->pool_size);
+  gst_buffer_pool_config_set_allocator (config, NULL, &params);
+
+  if (!gst_buffer_pool_set_config (pool, config) ||
+      !gst_buffer_pool_set_active (pool, TRUE)) {
+    GST_WARNING_OBJECT (self, "Failed to activate the output buffer pool.");
+    gst_object_unref (pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+/**
+ * @brief Get new memory block from the buffer pool, the pool is created with the size of the first request.
+ * @details The memory is recycled from the buffer pool if available. Otherwise (pool is disabled or exhausted), allocate new memory block.
+ * @param header_room TRUE to reserve the area for the header of flexible tensor
+ */
+static GstMemory *
+gst_tensor_filter_alloc_pooled_mem (GstTensorFilter * self,
+    GstBufferPool ** pool, gsize size, gboolean header_room)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorMetaInfo meta;
+  GstAllocationParams params;
+  GstMemory *mem;
+  gsize prefix = 0;
+
+  gst_tensor_filter_init_output_params (priv, &params);
+
+  if (header_room) {
+    gst_tensor_meta_info_init (&meta);
+    prefix = gst_tensor_meta_info_get_header_size (&meta);
+
+    /* the data follows the header, do not reserve the area if it breaks the alignment */
+    if (prefix & params.align)
+      prefix = 0;
+  }
+
+  if (priv->pool_size > 0) {
+    if (*pool == NULL)
+      *pool = gst_tensor_filter_create_pool (self, size, prefix);
+
+    /* do not wait for the buffer, allocate new one if the pool is exhausted */
+    if (*pool) {
+      mem = gst_tensor_buffer_pool_alloc_memory (*pool, size, prefix);
+      if (mem) {
+        __atomic_fetch_add (&priv->stat.pool_hits, 1, __ATOMIC_RELAXED);
+        return mem;
+      }
+    }
+  }
+
+  __atomic_fetch_add (&priv->stat.pool_misses, 1, __ATOMIC_RELAXED);
+  if (prefix > 0)
+    return gst_tensor_alloc_with_header_room_full (size, NULL, &params);
+
+  return gst_allocator_alloc (NULL, size, &params);
+}
+
+/**
+ * @brief Get new memory block for the output tensor.
+ * @details For static output, the area for the header of flexible tensor is reserved, so that downstream may convert it to flexible tensor without copying the data.
+ */
+static GstMemory *
+gst_tensor_filter_alloc_output_mem (GstTensorFilter * self, guint index,
+    gsize size, gboolean flexible)
+{
+  return gst_tensor_filter_alloc_pooled_mem (self,
+      &self->priv.out_pool[index], size, !flexible);
+}
+
+/**
+ * @brief Check whether the invoke latency should be recorded.
+ * The deadline mode predicts the completion time with recent latencies, and the latency of the first frame is always recorded.
+ */
+static inline gboolean
+gst_tensor_filter_need_profiling (GstTensorFilterPrivate * priv)
+{
+  return (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->deadline > 0 || priv->stat.first_frame_latency < 0);
+}
+
+/**
+ * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
+ */
+static void
+prepare_statistics (GstTensorFilterPrivate * priv)
+{
+  priv->stat.latest_invoke_time = g_get_real_time ();
+}
+
+#define THRESHOLD_DROP_OLD  (2000)
+#define THRESHOLD_CACHE_OLD (1000)
+
+/**
+ * @brief Record statistics for performance profiling (e.g, latency, throughput) of the invoke started at the given time.
+ * @param[out] report The latency report to be posted with post_statistics() (NULL if not reported), caller should post it after releasing its locks.
+ */
+static void
+record_statistics_since (GstTensorFilter * self, gint64 start_time,
+    GstStructure ** report)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  gint64 end_time = g_get_real_time ();
+  gint64 latency;
+  guint i;
+
+  *report = NULL;
+
+  g_mutex_lock (&priv->stat_lock);
+
+  priv->stat.latest_invoke_time = start_time;
+  latency = end_time - start_time;
+  if (priv->stat.first_frame_latency < 0)
+    priv->stat.first_frame_latency = latency;
+
+  priv->stat.total_invoke_latency += latency;
+  priv->stat.total_invoke_num += 1;
+
+  /* ring buffer of recent latencies, no allocation per frame */
+  priv->stat.recent_latencies[priv->stat.recent_idx] = latency;
+  priv->stat.recent_idx = (priv->stat.recent_idx + 1) % GST_TF_STAT_MAX_RECENT;
+  if (priv->stat.recent_num < GST_TF_STAT_MAX_RECENT)
+    priv->stat.recent_num++;
+
+  gst_tensor_filter_histogram_record (&priv->stat.latency_hist, latency);
+
+  if (priv->latency_mode > 0) {
+    gint64 avg_latency = 0;
+
+    for (i = 0; i < priv->stat.recent_num; i++)
+      avg_latency += priv->stat.recent_latencies[i];
+    avg_latency /= priv->stat.recent_num;
+
+    /* check integer overflow */
+    if (avg_latency <= INT32_MAX)
+      priv->prop.latency = (gint) avg_latency;
+    else
+      priv->prop.latency = -1;
+
+    ml_logi ("[%s] Invoke took %.3f ms", priv->prop.model_files[0],
+        latency / 1000.0);
+  }
+
+  if (priv->throughput_mode > 0) {
+    gint throughput_int = -1;
+
+    if (priv->stat.total_invoke_latency != 0) {
+      gdouble throughput =
+          (gdouble) (priv->stat.total_invoke_num * G_USEC_PER_SEC * 1000) /
+          priv->stat.total_invoke_latency;
+
+      /* check integer overflow */
+      if (throughput <= INT32_MAX)
+        throughput_int = (gint) throughput;
+    }
+
+    /* note that it's a 1000x larger value than actual throughput */
+    priv->prop.throughput = throughput_int;
+
+    ml_logi ("[%s] Throughput: %.2f FPS", priv->prop.model_files[0],
+        throughput_int / 1000.0);
+  }
+
+  /**
+   * statistics values are monotonously increasing.
+   * to avoid potential overflow, let's cache old values and subtract them
+   * from the statistics if some threshold is exceeded.
+   */
+  if (priv->stat.total_invoke_num > THRESHOLD_DROP_OLD) {
+    priv->stat.total_invoke_latency -= priv->stat.old_total_invoke_latency;
+    priv->stat.total_invoke_num -= priv->stat.old_total_invoke_num;
+    /* drop cached values */
+    priv->stat.old_total_invoke_latency = 0;
+    priv->stat.old_total_invoke_num = 0;
+  } else if (priv->stat.total_invoke_num > THRESHOLD_CACHE_OLD) {
+    /* cache old values if they are not yet set */
+    if (priv->stat.old_total_invoke_num == 0) {
+      priv->stat.old_total_invoke_latency = priv->stat.total_invoke_latency;
+      priv->stat.old_total_invoke_num = priv->stat.total_invoke_num;
+    }
+  }
+
+  /* post the latency percentiles periodically */
+  if (priv->latency_report_interval > 0) {
+    if (priv->stat.latest_report_time == 0) {
+      priv->stat.latest_report_time = end_time;
+    } else if (end_time - priv->stat.latest_report_time >=
+        (gint64) priv->latency_report_interval * 1000) {
+      GstTensorFilterHistogram *hist = &priv->stat.latency_hist;
+
+      priv->stat.latest_report_time = end_time;
+
+      *report = gst_structure_new ("nnstreamer-latency",
+          "p50", G_TYPE_INT64,
+          gst_tensor_filter_histogram_get_percentile (hist, 50.0),
+          "p90", G_TYPE_INT64,
+          gst_tensor_filter_histogram_get_percentile (hist, 90.0),
+          "p99", G_TYPE_INT64,
+          gst_tensor_filter_histogram_get_percentile (hist, 99.0),
+          "max", G_TYPE_INT64, hist->max,
+          "count", G_TYPE_UINT64, hist->total, NULL);
+    }
+  }
+
+  g_mutex_unlock (&priv->stat_lock);
+}
+
+/**
+ * @brief Post the latency report given by record_statistics_since(). Do not call this with the locks of tensor-filter.
+ */
+static void
+post_statistics (GstTensorFilter * self, GstStructure * report)
+{
+  if (report) {
+    gst_element_post_message (GST_ELEMENT_CAST (self),
+        gst_message_new_element (GST_OBJECT_CAST (self), report));
+  }
+}
+
+/**
+ * @brief Record statistics for performance profiling (e.g, latency, throughput)
+ */
+static void
+record_statistics (GstTensorFilter * self)
+{
+  GstStructure *report;
+
+  record_statistics_since (self, self->priv.stat.latest_invoke_time, &report);
+  post_statistics (self, report);
+}
+
+/**
+ * @brief Action signal handler to reset the latency histogram.
+ */
+static void
+gst_tensor_filter_reset_latency (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  g_mutex_lock (&priv->stat_lock);
+  gst_tensor_filter_histogram_reset (&priv->stat.latency_hist);
+  g_mutex_unlock (&priv->stat_lock);
+}
+
+/**
+ * @brief Check throttling delay and send qos overflow event to upstream elements
+ */
+static gboolean
+gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
+    GstBuffer * inbuf)
+{
+  GstTensorFilter *self;
+  GstTensorFilterPrivate *priv;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+  priv = &self->priv;
+
+  GST_OBJECT_LOCK (trans);
+
+  if (priv->throttling_delay != 0) {
+    GstClockTime curr_ts = GST_BUFFER_PTS (inbuf);
+    GstClockTime prev_ts = priv->prev_ts;
+
+    priv->prev_ts = curr_ts;
+
+    if (GST_CLOCK_TIME_IS_VALID (prev_ts)) {
+      GstClockTimeDiff diff = curr_ts - prev_ts;
+      GstClockTimeDiff delay;
+
+      priv->throttling_accum += diff;
+
+      /* check whether the average latency is longer than throttling delay */
+      delay = MAX (priv->prop.latency * 1000, priv->throttling_delay);
+
+      if (priv->throttling_accum < delay) {
+        GstClockTimeDiff duration = GST_BUFFER_DURATION (inbuf);        /* original */
+        gdouble avg_rate = gst_guint64_to_gdouble (duration) /
+            gst_guint64_to_gdouble (delay);
+
+        /**
+         * Send qos overflow event to upstream elements.
+         * Upstream elements (e.g., tensor_src, tensor_converter) may handle this.
          */
         GstPad *sinkpad = GST_BASE_TRANSFORM_SINK_PAD (&self->element);
         GstEvent *event = gst_event_new_qos (GST_QOS_TYPE_OVERFLOW,
             avg_rate, (priv->throttling_accum - delay), curr_ts);
 
-        gst_pad_push_event (sinkpad, event);
+        gst_pad_push_event (sinkpad, event);
+
+        GST_OBJECT_UNLOCK (trans);
+        return TRUE;
+      }
+
+      priv->throttling_accum = 0;
+    }
+  }
+
+  GST_OBJECT_UNLOCK (trans);
+  return FALSE;
+}
+
+/**
+ * @brief Predict the time to complete the invoke of new frame, with recent latencies and the frames in flight.
+ * @return The predicted time in nanoseconds, 0 if no latency is recorded.
+ */
+static GstClockTime
+gst_tensor_filter_predict_latency (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  gint64 avg_latency = 0;
+  guint i, num, inflight;
+
+  /* the latencies are recorded in other threads with asynchronous invoke */
+  g_mutex_lock (&priv->stat_lock);
+  num = priv->stat.recent_num;
+  for (i = 0; i < num; i++)
+    avg_latency += priv->stat.recent_latencies[i];
+  g_mutex_unlock (&priv->stat_lock);
+
+  if (num == 0)
+    return 0;
+
+  avg_latency /= num;
+
+  /* the frames in flight are invoked before new frame */
+  g_mutex_lock (&self->async_lock);
+  inflight = g_queue_get_length (&self->async_frames);
+  g_mutex_unlock (&self->async_lock);
+
+  if (self->num_workers > 1)
+    inflight /= self->num_workers;
+
+  return (GstClockTime) avg_latency * GST_USECOND * (inflight + 1);
+}
+
+/**
+ * @brief Check the deadline of the buffer (PTS + deadline budget). Drop the buffer and send qos event to upstream elements if it would finish late.
+ * @return TRUE to drop the buffer.
+ */
+static gboolean
+gst_tensor_filter_check_deadline (GstBaseTransform * trans, GstBuffer * inbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstClock *clock;
+  GstClockTime pts, running_time, deadline, now, predicted;
+  GstClockTimeDiff diff;
+  guint64 dropped;
+  gboolean late = FALSE;
+
+  if (priv->deadline == 0)
+    return FALSE;
+
+  pts = GST_BUFFER_PTS (inbuf);
+  if (!GST_CLOCK_TIME_IS_VALID (pts))
+    return FALSE;
+
+  GST_OBJECT_LOCK (trans);
+  running_time = gst_segment_to_running_time (&trans->segment,
+      GST_FORMAT_TIME, pts);
+  GST_OBJECT_UNLOCK (trans);
+
+  if (!GST_CLOCK_TIME_IS_VALID (running_time))
+    return FALSE;
+
+  /* the deadline is checked with the pipeline clock (PLAYING state) */
+  clock = gst_element_get_clock (GST_ELEMENT_CAST (self));
+  if (!clock)
+    return FALSE;
+
+  now = gst_clock_get_time (clock);
+  gst_object_unref (clock);
+
+  deadline = gst_element_get_base_time (GST_ELEMENT_CAST (self)) +
+      running_time + priv->deadline * GST_MSECOND;
+  predicted = gst_tensor_filter_predict_latency (self);
+
+  /* the frames in the backlogged queue are already late, drop without invoke */
+  diff = GST_CLOCK_DIFF (deadline, now + predicted);
+  if (diff > 0) {
+    GstPad *sinkpad = GST_BASE_TRANSFORM_SINK_PAD (trans);
+    GstClockTime duration = GST_BUFFER_DURATION (inbuf);
+    gdouble proportion = 1.0;
+    GstMessage *msg;
+
+    late = TRUE;
+    dropped = __atomic_add_fetch (&priv->stat.deadline_dropped, 1,
+        __ATOMIC_RELAXED);
+
+    GST_DEBUG_OBJECT (self, "Drop the frame %" GST_TIME_FORMAT
+        ", it would finish %" GST_STIME_FORMAT " late.",
+        GST_TIME_ARGS (pts), GST_STIME_ARGS (diff));
+
+    /* ratio of the processing time to the frame duration */
+    if (GST_CLOCK_TIME_IS_VALID (duration) && duration > 0 && predicted > 0)
+      proportion = gst_guint64_to_gdouble (predicted) /
+          gst_guint64_to_gdouble (duration);
+
+    /**
+     * Send qos underflow event to upstream elements, the frames before
+     * running-time + diff would be late. Upstream elements may skip them.
+     */
+    gst_pad_push_event (sinkpad, gst_event_new_qos (GST_QOS_TYPE_UNDERFLOW,
+            proportion, diff, running_time));
+
+    msg = gst_message_new_qos (GST_OBJECT_CAST (self), TRUE, running_time,
+        GST_CLOCK_TIME_NONE, pts, duration);
+    gst_message_set_qos_values (msg, diff, proportion, 1000000);
+    gst_message_set_qos_stats (msg, GST_FORMAT_BUFFERS,
+        priv->stat.total_invoke_num, dropped);
+    gst_element_post_message (GST_ELEMENT_CAST (self), msg);
+  }
+
+  return late;
+}
+
+/**
+ * @brief Check input paramters for gst_tensor_filter_transform ();
+ */
+static GstFlowReturn
+_gst_tensor_filter_transform_validate (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+
+  if (G_UNLIKELY (!priv->configured)) {
+    GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL), ("unknown format"));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+  if (G_UNLIKELY (!priv->fw)) {
+    /**
+      * This is fatal; if framework is not configured until this stage,
+      * it means that an extension is missing or not configured.
+      * We need readable messages for non-developers
+      */
+    g_error
+        ("\nA nnstreamer extension is not installed or framework property of tensor_filter is incorrect: [%s] is not found.\n\n",
+        prop->fwname);
+    GST_ELEMENT_ERROR (self, LIBRARY, FAILED,
+        ("framework (filter subplugin) is not found or not configured"),
+        ("framework not configured"));
+    return GST_FLOW_ERROR;
+  }
+  if (G_UNLIKELY (!priv->fw->run_without_model) &&
+      G_UNLIKELY (!(prop->model_files &&
+              prop->num_models > 0 && prop->model_files[0]))) {
+    GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
+        ("model filepath not configured"));
+    return GST_FLOW_ERROR;
+  }
+  if ((GST_TF_FW_V0 (priv->fw) && G_UNLIKELY (!priv->fw->invoke_NN)) ||
+      (GST_TF_FW_V1 (priv->fw) && G_UNLIKELY (!priv->fw->invoke))) {
+    GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
+        ("invoke function is not defined"));
+    return GST_FLOW_ERROR;
+  }
+
+  /* the model loaded in background is swapped at a frame boundary */
+  gst_tensor_filter_swap_commit (self);
+
+  /* pin the streaming thread invoking the model, once for each thread */
+  gst_tensor_filter_common_apply_thread_policy (priv);
+
+  silent_debug ("Invoking %s with %s model\n", priv->fw->name,
+      GST_STR_NULL (prop->model_files[0]));
+
+  /* skip input data when throttling delay is set */
+  if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+
+  /* skip input data which would miss the deadline */
+  if (gst_tensor_filter_check_deadline (trans, inbuf))
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+
+  /* in-place transform, the model writes the output into the input buffer */
+  if (outbuf == inbuf)
+    return GST_FLOW_OK;
+
+  if (!outbuf) {
+    GST_ELEMENT_ERROR (self, RESOURCE, FAILED, ("outbuf is null."),
+        ("%s:%s:%d", __FILE__, __func__, __LINE__));
+    return GST_FLOW_ERROR;
+  }
+  if (gst_buffer_get_size (outbuf) != 0) {
+    GST_ELEMENT_ERROR (self, RESOURCE, FAILED, ("outbuf size is not zero."),
+        ("%s:%s:%d. size = %zu", __FILE__, __func__, __LINE__,
+            gst_buffer_get_size (outbuf)));
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Check whether the frames are invoked in parallel with multiple instances of NN framework.
+ * The output allocated in invoke should be released with the instance, so this is not available in that case.
+ */
+static inline gboolean
+gst_tensor_filter_parallel_enabled (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  /* the shared model invokes with the contexts in its own pool */
+  return (priv->num_instances > 1 && !priv->shared_model &&
+      !gst_tensor_filter_allocate_in_invoke (priv));
+}
+
+/**
+ * @brief The ring of output buffers owned by the subplugin (see GET_OUTPUT_RING).
+ */
+struct _GstTensorFilterRing
+{
+  gint refcount; /**< The element and the slots in use hold the ring */
+  GMutex lock; /**< Lock for the free slots */
+  GCond cond; /**< Condition to wait for a free slot */
+  gboolean flushing; /**< TRUE to stop waiting for a free slot */
+
+  guint num_slots; /**< The number of slots */
+  guint num_tensors; /**< The number of output tensors in each slot */
+  GstTensorMemory *slots; /**< The output tensors of each slot */
+  guint *slot_mems; /**< The number of memory blocks of each slot held by downstream */
+  GQueue free_slots; /**< The indices of free slots */
+
+  void (*release_slot) (void *ring_data, unsigned int slot); /**< Callback to return the slot to the subplugin */
+  void (*release_ring) (void *ring_data); /**< Callback to return the ring to the subplugin */
+  void *ring_data; /**< The data for the callbacks */
+};
+
+/**
+ * @brief The memory block of the output tensor in the slot.
+ */
+typedef struct
+{
+  GstTensorFilterRing *ring; /**< The ring */
+  guint slot; /**< The index of the slot */
+} GstTensorFilterRingMem;
+
+/**
+ * @brief Release the reference of the output ring. The subplugin gets the ring back when the last reference is released.
+ */
+static void
+gst_tensor_filter_ring_unref (GstTensorFilterRing * ring)
+{
+  if (!g_atomic_int_dec_and_test (&ring->refcount))
+    return;
+
+  if (ring->release_ring)
+    ring->release_ring (ring->ring_data);
+
+  g_queue_clear (&ring->free_slots);
+  g_mutex_clear (&ring->lock);
+  g_cond_clear (&ring->cond);
+  g_free (ring->slots);
+  g_free (ring->slot_mems);
+  g_free (ring);
+}
+
+/**
+ * @brief Return the slot when downstream releases all memory blocks of the slot.
+ */
+static void
+gst_tensor_filter_ring_mem_free (gpointer data)
+{
+  GstTensorFilterRingMem *rmem = (GstTensorFilterRingMem *) data;
+  GstTensorFilterRing *ring = rmem->ring;
+  gboolean released;
+
+  g_mutex_lock (&ring->lock);
+  released = (--ring->slot_mems[rmem->slot] == 0);
+  if (released) {
+    g_queue_push_tail (&ring->free_slots, GUINT_TO_POINTER (rmem->slot));
+    g_cond_signal (&ring->cond);
+  }
+  g_mutex_unlock (&ring->lock);
+
+  if (released && ring->release_slot)
+    ring->release_slot (ring->ring_data, rmem->slot);
+
+  gst_tensor_filter_ring_unref (ring);
+  g_free (rmem);
+}
+
+/**
+ * @brief Get the ring of output buffers from the subplugin.
+ * @return The output ring, or NULL if the subplugin does not provide it.
+ */
+static GstTensorFilterRing *
+gst_tensor_filter_ring_new (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterFrameworkEventData data;
+  GstTensorFilterRing *ring;
+  guint i, n;
+
+  /* the slots belong to the context of the subplugin */
+  if (!prop->fw_opened || GST_TF_FW_V0 (priv->fw) || priv->shared_model ||
+      gst_tensor_filter_parallel_enabled (self))
+    return NULL;
+
+  /* the cached outputs would hold the slots */
+  if (gst_tensor_filter_cache_enabled (self))
+    return NULL;
+
+  memset (&data, 0, sizeof (data));
+  if (priv->fw->eventHandler (priv->fw, prop, priv->privateData,
+          GET_OUTPUT_RING, &data) != 0)
+    return NULL;
+
+  if (data.num_slots == 0 || data.slots == NULL) {
+    GST_WARNING_OBJECT (self, "The output ring of subplugin is empty.");
+    goto invalid;
+  }
+
+  for (n = 0; n < data.num_slots; n++) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      const GstTensorMemory *t = &data.slots[n * NNS_TENSOR_SIZE_LIMIT + i];
+
+      if (t->data == NULL ||
+          t->size < gst_tensor_filter_get_tensor_size (self, i, FALSE)) {
+        GST_WARNING_OBJECT (self,
+            "The output ring has invalid memory block (slot %u, tensor %u).",
+            n, i);
+        goto invalid;
+      }
+    }
+  }
+
+  ring = g_new0 (GstTensorFilterRing, 1);
+  ring->refcount = 1;
+  g_mutex_init (&ring->lock);
+  g_cond_init (&ring->cond);
+  g_queue_init (&ring->free_slots);
+
+  ring->num_slots = data.num_slots;
+  ring->num_tensors = prop->output_meta.num_tensors;
+  ring->slots = g_new (GstTensorMemory,
+      NNS_TENSOR_SIZE_LIMIT * data.num_slots);
+  memcpy (ring->slots, data.slots,
+      sizeof (GstTensorMemory) * NNS_TENSOR_SIZE_LIMIT * data.num_slots);
+  ring->slot_mems = g_new0 (guint, data.num_slots);
+  ring->release_slot = data.release_slot;
+  ring->release_ring = data.release_ring;
+  ring->ring_data = data.ring_data;
+
+  for (n = 0; n < ring->num_slots; n++)
+    g_queue_push_tail (&ring->free_slots, GUINT_TO_POINTER (n));
+
+  GST_INFO_OBJECT (self, "The subplugin provides the output ring (%u slots).",
+      ring->num_slots);
+  return ring;
+
+invalid:
+  if (data.release_ring)
+    data.release_ring (data.ring_data);
+  return NULL;
+}
+
+/**
+ * @brief Get the output ring, asking the subplugin once after the output is configured.
+ */
+static GstTensorFilterRing *
+gst_tensor_filter_ring_get (GstTensorFilter * self)
+{
+  GstTensorFilterRing *ring;
+
+  if (G_UNLIKELY (!self->out_ring_checked)) {
+    ring = gst_tensor_filter_ring_new (self);
+
+    /* flush-start and set-property read the ring with the object lock */
+    GST_OBJECT_LOCK (self);
+    self->out_ring_checked = TRUE;
+    self->out_ring = ring;
+    GST_OBJECT_UNLOCK (self);
+  }
+
+  return self->out_ring;
+}
+
+/**
+ * @brief Check the subplugin provides the output ring.
+ */
+static gboolean
+gst_tensor_filter_ring_active (GstTensorFilter * self)
+{
+  gboolean active;
+
+  GST_OBJECT_LOCK (self);
+  active = (self->out_ring != NULL);
+  GST_OBJECT_UNLOCK (self);
+
+  return active;
+}
+
+/**
+ * @brief Hand out a free slot of the ring, waiting for downstream to release one if all slots are in use.
+ * @param mems The memory blocks of the output tensors in the slot
+ * @return FALSE if flushing.
+ */
+static gboolean
+gst_tensor_filter_ring_acquire (GstTensorFilter * self,
+    GstTensorFilterRing * ring, GstMemory ** mems)
+{
+  GstTensorFilterRingMem *rmem;
+  GstTensorMemory *t;
+  guint i, slot;
+
+  g_mutex_lock (&ring->lock);
+  while (g_queue_is_empty (&ring->free_slots) && !ring->flushing) {
+    GST_LOG_OBJECT (self, "All slots of the output ring are in use, waiting.");
+    g_cond_wait (&ring->cond, &ring->lock);
+  }
+
+  if (ring->flushing) {
+    g_mutex_unlock (&ring->lock);
+    return FALSE;
+  }
+
+  slot = GPOINTER_TO_UINT (g_queue_pop_head (&ring->free_slots));
+  ring->slot_mems[slot] = ring->num_tensors;
+  g_mutex_unlock (&ring->lock);
+
+  for (i = 0; i < ring->num_tensors; i++) {
+    t = &ring->slots[slot * NNS_TENSOR_SIZE_LIMIT + i];
+
+    rmem = g_new0 (GstTensorFilterRingMem, 1);
+    rmem->ring = ring;
+    rmem->slot = slot;
+    g_atomic_int_inc (&ring->refcount);
+
+    mems[i] = gst_memory_new_wrapped (0, t->data, t->size, 0,
+        gst_tensor_filter_get_tensor_size (self, i, FALSE), rmem,
+        gst_tensor_filter_ring_mem_free);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop or restart waiting for a free slot of the output ring.
+ */
+static void
+gst_tensor_filter_ring_set_flushing (GstTensorFilter * self, gboolean flushing)
+{
+  GstTensorFilterRing *ring;
+
+  /* called from the upstream thread, the streaming thread may release the ring */
+  GST_OBJECT_LOCK (self);
+  ring = self->out_ring;
+  if (ring)
+    g_atomic_int_inc (&ring->refcount);
+  GST_OBJECT_UNLOCK (self);
+
+  if (ring == NULL)
+    return;
+
+  g_mutex_lock (&ring->lock);
+  ring->flushing = flushing;
+  g_cond_broadcast (&ring->cond);
+  g_mutex_unlock (&ring->lock);
+
+  gst_tensor_filter_ring_unref (ring);
+}
+
+/**
+ * @brief Release the output ring. The subplugin gets the ring back when downstream releases all slots.
+ */
+static void
+gst_tensor_filter_ring_release (GstTensorFilter * self)
+{
+  GstTensorFilterRing *ring;
+
+  GST_OBJECT_LOCK (self);
+  ring = self->out_ring;
+  self->out_ring = NULL;
+  self->out_ring_checked = FALSE;
+  GST_OBJECT_UNLOCK (self);
+
+  if (ring) {
+    g_mutex_lock (&ring->lock);
+    ring->flushing = TRUE;
+    g_cond_broadcast (&ring->cond);
+    g_mutex_unlock (&ring->lock);
+
+    gst_tensor_filter_ring_unref (ring);
+  }
+}
+
+/**
+ * @brief Data structure for a frame to be invoked.
+ */
+typedef struct
+{
+  GstTensorFilter *self; /**< "this" pointer */
+  GstBuffer *inbuf; /**< The input buffer */
+  GstBuffer *outbuf; /**< The output buffer (asynchronous invoke) */
+
+  guint num_mems; /**< The number of memory blocks in the input buffer */
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT]; /**< The input memory blocks */
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT]; /**< The map info of the input memory blocks */
+  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT]; /**< The meta of the flexible input tensors */
+  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< The input tensors to invoke */
+
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT]; /**< The output memory blocks */
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT]; /**< The map info of the output memory blocks */
+  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT]; /**< The meta of the flexible output tensors */
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT]; /**< The output tensors */
+
+  gboolean in_flexible; /**< TRUE if the input is flexible tensor */
+  gboolean out_flexible; /**< TRUE if the output is flexible tensor */
+  gboolean allocate_in_invoke; /**< TRUE if the subplugin allocates the output */
+
+  gint64 invoke_time; /**< The time to start the invoke (usec) */
+  GstFlowReturn result; /**< The result of the frame (asynchronous invoke) */
+  gboolean done; /**< TRUE if the invoke is done (asynchronous invoke) */
+} GstTensorFilterFrame;
+
+/**
+ * @brief Unmap the memory blocks of the frame.
+ * @param release TRUE to release the output memory blocks
+ */
+static void
+gst_tensor_filter_frame_unmap (GstTensorFilter * self,
+    GstTensorFilterFrame * frame, gboolean release)
+{
+  guint i;
+
+  for (i = 0; i < frame->num_mems; i++) {
+    if (frame->in_mem[i])
+      gst_memory_unmap (frame->in_mem[i], &frame->in_info[i]);
+  }
+
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (frame->out_mem[i]) {
+      gst_memory_unmap (frame->out_mem[i], &frame->out_info[i]);
+
+      if (release) {
+        gst_memory_unref (frame->out_mem[i]);
+        frame->out_mem[i] = NULL;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Get all input tensors from the input buffer and prepare the output tensors.
+ * @return TRUE if the frame is ready to invoke.
+ */
+static gboolean
+gst_tensor_filter_frame_prepare (GstTensorFilter * self,
+    GstTensorFilterFrame * frame, GstBuffer * inbuf)
+{
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorFilterRing *ring = NULL;
+  GList *list;
+  guint i, j;
+  gsize expected, hsize;
+
+  memset (frame, 0, sizeof (GstTensorFilterFrame));
+  frame->self = self;
+  frame->result = GST_FLOW_OK;
+
+  frame->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  frame->in_flexible =
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans));
+  frame->out_flexible =
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
+
+  /* 1. Get all input tensors from inbuf. */
+  /* Internal Logic Error or GST Bug (sinkcap changed!) */
+  frame->num_mems = gst_buffer_n_memory (inbuf);
+
+  for (i = 0; i < frame->num_mems; i++) {
+    frame->in_mem[i] = gst_buffer_peek_memory (inbuf, i);
+    if (!gst_memory_map (frame->in_mem[i], &frame->in_info[i], GST_MAP_READ)) {
+      ml_logf ("Cannot map input memory buffer(%d)\n", i);
+      frame->in_mem[i] = NULL;
+      goto mem_map_error;
+    }
+
+    hsize = 0;
+    if (frame->in_flexible) {
+      gst_tensor_meta_info_parse_header (&frame->in_meta[i],
+          frame->in_info[i].data);
+      hsize = gst_tensor_meta_info_get_header_size (&frame->in_meta[i]);
+    }
+
+    in_tensors[i].data = frame->in_info[i].data + hsize;
+    in_tensors[i].size = frame->in_info[i].size - hsize;
+  }
+
+  /* 1.1 Prepare tensors to invoke. */
+  if (priv->combi.in_combi_defined) {
+    guint info_idx = 0;
+
+    for (list = priv->combi.in_combi; list != NULL; list = list->next) {
+      i = GPOINTER_TO_UINT (list->data);
+
+      if (i >= frame->num_mems) {
+        ml_loge
+            ("Invalid combination index %u, incoming buffer has total %u memories.",
+            i, frame->num_mems);
+        goto mem_map_error;
+      }
+
+      expected = gst_tensor_filter_get_tensor_size (self, info_idx, TRUE);
+      if (expected != in_tensors[i].size) {
+        ml_loge ("Incoming buffer size ([%u] %zd) is invalid, expected %zd.",
+            i, in_tensors[i].size, expected);
+        goto mem_map_error;
+      }
+
+      frame->invoke_tensors[info_idx++] = in_tensors[i];
+    }
+  } else {
+    if (frame->num_mems != prop->input_meta.num_tensors) {
+      ml_loge ("Incoming buffer has invalid memory blocks (%u), expected %u.",
+          frame->num_mems, prop->input_meta.num_tensors);
+      goto mem_map_error;
+    }
+
+    for (i = 0; i < prop->input_meta.num_tensors; i++) {
+      expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+      if (expected != in_tensors[i].size) {
+        ml_loge ("Incoming buffer size ([%u] %zd) is invalid, expected %zd.",
+            i, in_tensors[i].size, expected);
+        goto mem_map_error;
+      }
+
+      frame->invoke_tensors[i] = in_tensors[i];
+    }
+  }
+
+  /* 2. Prepare output tensors. */
+  /* the slot of the output ring owned by the subplugin, for static output */
+  if (!frame->out_flexible)
+    ring = gst_tensor_filter_ring_get (self);
+
+  if (ring) {
+    if (!gst_tensor_filter_ring_acquire (self, ring, frame->out_mem)) {
+      frame->result = GST_FLOW_FLUSHING;
+      goto mem_map_error;
+    }
+
+    frame->allocate_in_invoke = FALSE;
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    frame->out_tensors[i].data = NULL;
+    frame->out_tensors[i].size =
+        gst_tensor_filter_get_tensor_size (self, i, FALSE);
+
+    hsize = 0;
+    if (frame->out_flexible) {
+      gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
+          &frame->out_meta[i]);
+      hsize = gst_tensor_meta_info_get_header_size (&frame->out_meta[i]);
+    }
+
+    /* allocate memory if allocate_in_invoke is FALSE */
+    if (!frame->allocate_in_invoke) {
+      if (!ring) {
+        frame->out_mem[i] = gst_tensor_filter_alloc_output_mem (self, i,
+            frame->out_tensors[i].size + hsize, frame->out_flexible);
+      }
+
+      if (!gst_memory_map (frame->out_mem[i], &frame->out_info[i],
+              GST_MAP_WRITE)) {
+        ml_logf ("Cannot map output memory buffer(%d)\n", i);
+        /* release the memory blocks of the slot not mapped yet */
+        for (j = i; j < NNS_TENSOR_SIZE_LIMIT && frame->out_mem[j]; j++) {
+          gst_memory_unref (frame->out_mem[j]);
+          frame->out_mem[j] = NULL;
+        }
+        goto mem_map_error;
+      }
+
+      frame->out_tensors[i].data = frame->out_info[i].data + hsize;
+
+      /* append header */
+      if (frame->out_flexible)
+        gst_tensor_meta_info_update_header (&frame->out_meta[i],
+            frame->out_info[i].data);
+    }
+  }
+
+  return TRUE;
+
+mem_map_error:
+  gst_tensor_filter_frame_unmap (self, frame, TRUE);
+  return FALSE;
+}
+
+/**
+ * @brief Release the map info of the frame and fill the output buffer with the result of invoke.
+ * @param ret the return value of invoke
+ * @return GST_FLOW_OK if the output is ready, GST_BASE_TRANSFORM_FLOW_DROPPED to drop this frame, or GST_FLOW_ERROR.
+ */
+static GstFlowReturn
+gst_tensor_filter_frame_finish (GstTensorFilter * self,
+    GstTensorFilterFrame * frame, gint ret, GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *mem;
+  GList *list;
+  guint i;
+  gsize hsize;
+
+  /* 4. Free map info and handle error case */
+  gst_tensor_filter_frame_unmap (self, frame, (ret != 0));
+
+  /** @todo define enum to indicate status code */
+  if (ret < 0) {
+    ml_loge ("Tensor-filter invoke failed (error code = %d).\n", ret);
+    return GST_FLOW_ERROR;
+  } else if (ret > 0) {
+    /* drop this buffer */
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  /* 5. Update result */
+  /* If output combination is defined, append input tensors first */
+  if (priv->combi.out_combi_i_defined) {
+    for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
+      i = GPOINTER_TO_UINT (list->data);
+
+      if (!frame->in_flexible && frame->out_flexible) {
+        /* append header */
+        gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i],
+            &frame->in_meta[i]);
+        mem = gst_tensor_meta_info_append_header (&frame->in_meta[i],
+            frame->in_mem[i]);
+      } else if (frame->in_flexible && !frame->out_flexible) {
+        /* remove header */
+        hsize = gst_tensor_meta_info_get_header_size (&frame->in_meta[i]);
+        mem = gst_memory_share (frame->in_mem[i], hsize, -1);
+      } else {
+        mem = gst_memory_ref (frame->in_mem[i]);
+      }
+
+      gst_buffer_append_memory (outbuf, mem);
+    }
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    if (priv->combi.out_combi_o_defined) {
+      gboolean out_combi = FALSE;
+
+      for (list = priv->combi.out_combi_o; list != NULL; list = list->next) {
+        if (i == GPOINTER_TO_UINT (list->data)) {
+          out_combi = TRUE;
+          break;
+        }
+      }
+      if (!out_combi) {
+        /* release memory block if output tensor is not in the combi list */
+        if (frame->allocate_in_invoke) {
+          gst_tensor_filter_destroy_notify_util (priv,
+              frame->out_tensors[i].data);
+        } else {
+          gst_memory_unref (frame->out_mem[i]);
+        }
+
+        frame->out_mem[i] = NULL;
+        continue;
+      }
+    }
+
+    if (frame->allocate_in_invoke) {
+      /* prepare memory block if successfully done */
+      frame->out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
+          frame->out_tensors[i].data, frame->out_tensors[i].size);
+
+      if (frame->out_flexible) {
+        /* prepare new memory block with meta */
+        frame->out_mem[i] =
+            gst_tensor_meta_info_append_header (&frame->out_meta[i], mem);
+        gst_memory_unref (mem);
+      }
+    }
+
+    /* append the memory block to outbuf */
+    gst_buffer_append_memory (outbuf, frame->out_mem[i]);
+    frame->out_mem[i] = NULL;
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Check whether the subplugin invokes the model asynchronously.
+ */
+static inline gboolean
+gst_tensor_filter_async_enabled (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  if (gst_tensor_filter_parallel_enabled (self))
+    return TRUE;
+
+  return (priv->max_inflight > 0 && !priv->shared_model &&
+      GST_TF_FW_V2 (priv->fw) && priv->fw->invoke_async != NULL);
+}
+
+/**
+ * @brief Free the frame for asynchronous invoke.
+ */
+static void
+gst_tensor_filter_frame_free (GstTensorFilterFrame * frame)
+{
+  if (frame->inbuf)
+    gst_buffer_unref (frame->inbuf);
+  if (frame->outbuf)
+    gst_buffer_unref (frame->outbuf);
+
+  g_free (frame);
+}
+
+/**
+ * @brief Callback to notify the completion of asynchronous invoke.
+ */
+static void
+gst_tensor_filter_async_done (void *user_data, int status)
+{
+  GstTensorFilterFrame *frame = (GstTensorFilterFrame *) user_data;
+  GstTensorFilter *self = frame->self;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstStructure *report;
+  GstFlowReturn result;
+
+  result = gst_tensor_filter_frame_finish (self, frame, status, frame->outbuf);
+
+  /* the latency report is posted out of the async lock */
+  if (gst_tensor_filter_need_profiling (priv)) {
+    record_statistics_since (self, frame->invoke_time, &report);
+    post_statistics (self, report);
+  }
+
+  g_mutex_lock (&self->async_lock);
+  frame->result = result;
+  frame->done = TRUE;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Output task to push the results of the frames in flight, in the order of the input.
+ */
+static void
+gst_tensor_filter_output_loop (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (&self->element);
+  GstTensorFilterFrame *frame = NULL;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&self->async_lock);
+  while (!self->async_flushing) {
+    frame = g_queue_peek_head (&self->async_frames);
+    if (frame && frame->done)
+      break;
+
+    g_cond_wait (&self->async_cond, &self->async_lock);
+  }
+
+  if (self->async_flushing) {
+    g_mutex_unlock (&self->async_lock);
+    gst_pad_pause_task (srcpad);
+    return;
+  }
+  g_mutex_unlock (&self->async_lock);
+
+  /**
+   * Pop the frame after pushing the output,
+   * so that the serialized events are sent after all frames in flight.
+   */
+  if (frame->result == GST_FLOW_OK) {
+    ret = gst_pad_push (srcpad, frame->outbuf);
+    frame->outbuf = NULL;
+  } else if (frame->result != GST_BASE_TRANSFORM_FLOW_DROPPED) {
+    GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+        ("Failed to invoke the model asynchronously."));
+    ret = GST_FLOW_ERROR;
+  }
+
+  g_mutex_lock (&self->async_lock);
+  g_queue_pop_head (&self->async_frames);
+  if (ret != GST_FLOW_OK)
+    self->async_flow = ret;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+
+  gst_tensor_filter_frame_free (frame);
+
+  if (ret != GST_FLOW_OK) {
+    GST_DEBUG_OBJECT (self, "Pausing the output task, reason %s",
+        gst_flow_get_name (ret));
+    gst_pad_pause_task (srcpad);
+  }
+}
+
+/**
+ * @brief Data structure for the worker invoking the frames with an instance of NN framework.
+ */
+struct _GstTensorFilterWorker
+{
+  GstTensorFilter *self; /**< "this" pointer */
+  guint index; /**< The index of the instance */
+  GThread *thread; /**< The thread invoking the frames */
+  GAsyncQueue *queue; /**< The frames dispatched to this worker */
+};
+
+/**
+ * @brief Thread to invoke the frames dispatched to the worker.
+ */
+static gpointer
+gst_tensor_filter_worker_loop (gpointer user_data)
+{
+  GstTensorFilterWorker *worker = (GstTensorFilterWorker *) user_data;
+  GstTensorFilter *self = worker->self;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterInstance *instance = &priv->instances[worker->index];
+  GstTensorFilterFrame *frame;
+  void **private_data;
+  gint ret;
+
+  private_data = (worker->index == 0) ?
+      &priv->privateData : &instance->privateData;
+
+  gst_tensor_filter_common_apply_thread_policy (priv);
+
+  while (TRUE) {
+    frame = (GstTensorFilterFrame *) g_async_queue_pop (worker->queue);
+
+    /* empty frame to stop the worker */
+    if (frame->self == NULL) {
+      g_free (frame);
+      break;
+    }
+
+    frame->invoke_time = g_get_real_time ();
+
+    if (GST_TF_FW_V0 (priv->fw)) {
+      ret = priv->fw->invoke_NN (&priv->prop, private_data,
+          frame->invoke_tensors, frame->out_tensors);
+    } else {
+      ret = priv->fw->invoke (priv->fw, &priv->prop, *private_data,
+          frame->invoke_tensors, frame->out_tensors);
+    }
+
+    /* the statistics are read without stopping the workers */
+    __atomic_fetch_add (&instance->total_invoke_num, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add (&instance->total_invoke_latency,
+        g_get_real_time () - frame->invoke_time, __ATOMIC_RELAXED);
+
+    gst_tensor_filter_async_done (frame, ret);
+  }
+
+  gst_tensor_filter_common_restore_thread_policy (priv, TRUE);
+  return NULL;
+}
+
+/**
+ * @brief Open the instances of NN framework and start the workers.
+ */
+static gboolean
+gst_tensor_filter_workers_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterWorker *worker;
+  guint i;
+
+  if (!gst_tensor_filter_common_open_instances (priv))
+    return FALSE;
+
+  self->workers = g_new0 (GstTensorFilterWorker, priv->instances_len);
+
+  for (i = 0; i < priv->instances_len; i++) {
+    worker = &self->workers[i];
+
+    worker->self = self;
+    worker->index = i;
+    worker->queue = g_async_queue_new ();
+    worker->thread = g_thread_new ("tensor_filter_worker",
+        gst_tensor_filter_worker_loop, worker);
+  }
+
+  self->num_workers = priv->instances_len;
+  self->worker_seq = 0;
+  return TRUE;
+}
+
+/**
+ * @brief Stop the workers after invoking the frames dispatched, and close the instances of NN framework.
+ */
+static void
+gst_tensor_filter_workers_stop (GstTensorFilter * self)
+{
+  GstTensorFilterWorker *worker;
+  guint i;
+
+  for (i = 0; i < self->num_workers; i++) {
+    worker = &self->workers[i];
+    g_async_queue_push (worker->queue, g_new0 (GstTensorFilterFrame, 1));
+  }
+
+  for (i = 0; i < self->num_workers; i++) {
+    worker = &self->workers[i];
+
+    g_thread_join (worker->thread);
+    g_async_queue_unref (worker->queue);
+  }
+
+  g_free (self->workers);
+  self->workers = NULL;
+  self->num_workers = 0;
+
+  gst_tensor_filter_common_close_instances (&self->priv);
+}
+
+/**
+ * @brief Wait until the output task pushes all frames in flight.
+ */
+static void
+gst_tensor_filter_async_drain (GstTensorFilter * self)
+{
+  g_mutex_lock (&self->async_lock);
+  while (!g_queue_is_empty (&self->async_frames) && !self->async_flushing &&
+      self->async_flow == GST_FLOW_OK) {
+    g_cond_wait (&self->async_cond, &self->async_lock);
+  }
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Release all frames in flight. Caller should stop the output task before calling this.
+ */
+static void
+gst_tensor_filter_async_clear (GstTensorFilter * self)
+{
+  GstTensorFilterFrame *frame;
+  GList *list;
+  gboolean pending;
+
+  g_mutex_lock (&self->async_lock);
+
+  /* wait for the subplugin to complete the invoke */
+  do {
+    pending = FALSE;
+
+    for (list = self->async_frames.head; list != NULL; list = list->next) {
+      frame = (GstTensorFilterFrame *) list->data;
+
+      if (!frame->done) {
+        pending = TRUE;
+        g_cond_wait (&self->async_cond, &self->async_lock);
+        break;
+      }
+    }
+  } while (pending);
+
+  while ((frame = g_queue_pop_head (&self->async_frames)) != NULL)
+    gst_tensor_filter_frame_free (frame);
+
+  self->async_flow = GST_FLOW_OK;
+  g_mutex_unlock (&self->async_lock);
+}
+
+/**
+ * @brief Stop the output task and release all frames in flight.
+ */
+static void
+gst_tensor_filter_async_stop (GstTensorFilter * self)
+{
+  g_mutex_lock (&self->async_lock);
+  self->async_flushing = TRUE;
+  g_cond_broadcast (&self->async_cond);
+  g_mutex_unlock (&self->async_lock);
+
+  gst_pad_stop_task (GST_BASE_TRANSFORM_SRC_PAD (&self->element));
+  gst_tensor_filter_async_clear (self);
+  gst_tensor_filter_workers_stop (self);
+}
+
+/**
+ * @brief Invoke the model asynchronously. The output task pushes the output buffer.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_async (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (&self->element);
+  GstTensorFilterFrame *frame;
+  GstFlowReturn flow;
+  gboolean parallel;
+  guint max_inflight;
+  gint ret;
+
+  parallel = gst_tensor_filter_parallel_enabled (self);
+  max_inflight = priv->max_inflight;
+
+  if (parallel) {
+    if (self->num_workers == 0 && !gst_tensor_filter_workers_start (self)) {
+      GST_ELEMENT_ERROR (self, RESOURCE, FAILED, (NULL),
+          ("Failed to open %u instances of the framework.",
+              priv->num_instances));
+      return GST_FLOW_ERROR;
+    }
+
+    /* keep all instances busy */
+    max_inflight = MAX (max_inflight, self->num_workers);
+  }
+
+  frame = g_new (GstTensorFilterFrame, 1);
+  if (!gst_tensor_filter_frame_prepare (self, frame, inbuf)) {
+    flow = (frame->result != GST_FLOW_OK) ? frame->result : GST_FLOW_ERROR;
+    g_free (frame);
+    return flow;
+  }
+
+  frame->inbuf = gst_buffer_ref (inbuf);
+  frame->outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (frame->outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  g_mutex_lock (&self->async_lock);
+  while (g_queue_get_length (&self->async_frames) >= max_inflight &&
+      !self->async_flushing && self->async_flow == GST_FLOW_OK) {
+    g_cond_wait (&self->async_cond, &self->async_lock);
+  }
+
+  flow = (self->async_flushing) ? GST_FLOW_FLUSHING : self->async_flow;
+  if (flow != GST_FLOW_OK) {
+    g_mutex_unlock (&self->async_lock);
+
+    gst_tensor_filter_frame_unmap (self, frame, TRUE);
+    gst_tensor_filter_frame_free (frame);
+    return flow;
+  }
+
+  frame->invoke_time = g_get_real_time ();
+  g_queue_push_tail (&self->async_frames, frame);
+
+  if (gst_pad_get_task_state (srcpad) != GST_TASK_STARTED)
+    gst_pad_start_task (srcpad, gst_tensor_filter_output_loop, self, NULL);
+  g_mutex_unlock (&self->async_lock);
+
+  if (parallel) {
+    GstTensorFilterWorker *worker;
+
+    /* dispatch the frame to the workers in round-robin */
+    worker = &self->workers[self->worker_seq++ % self->num_workers];
+    g_async_queue_push (worker->queue, frame);
+
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  /* 3. Call the filter-subplugin callback, "invoke_async" */
+  ret = priv->fw->invoke_async (priv->fw, &priv->prop, priv->privateData,
+      frame->invoke_tensors, frame->out_tensors,
+      gst_tensor_filter_async_done, frame);
+  if (ret != 0) {
+    /* the callback will not be called, complete the frame with error */
+    gst_tensor_filter_async_done (frame, ret);
+  }
+
+  /* the output task pushes the output buffer */
+  return GST_BASE_TRANSFORM_FLOW_DROPPED;
+}
+
+/**
+ * @brief Release the frames in the incomplete batch. Caller should hold the batch lock.
+ * @note The batched input memory is kept to stage the next batch.
+ */
+static void
+gst_tensor_filter_batch_clear (GstTensorFilter * self)
+{
+  g_ptr_array_set_size (self->batch_frames, 0);
+}
+
+/**
+ * @brief Release the batched input memory. Caller should hold the batch lock.
+ */
+static void
+gst_tensor_filter_batch_free_staging (GstTensorFilter * self)
+{
+  guint i;
+
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (self->batch_in_mem[i]) {
+      gst_memory_unref (self->batch_in_mem[i]);
+      self->batch_in_mem[i] = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Copy the input tensors of the frame into the batch, or keep the frame if the subplugin invokes the batch. Caller should hold the batch lock.
+ */
+static gboolean
+gst_tensor_filter_batch_append (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *mem;
+  GstMapInfo in_map, batch_map;
+  guint i, idx, num_mems, offset;
+  gsize size;
+
+  num_mems = gst_buffer_n_memory (inbuf);
+  offset = self->batch_frames->len;
+
+  if (!priv->combi.in_combi_defined &&
+      num_mems != prop->input_meta.num_tensors) {
+    ml_loge ("Incoming buffer has invalid memory blocks (%u), expected %u.",
+        num_mems, prop->input_meta.num_tensors);
+    return FALSE;
+  }
+
+  for (idx = 0; idx < prop->input_meta.num_tensors; idx++) {
+    if (priv->combi.in_combi_defined)
+      i = GPOINTER_TO_UINT (g_list_nth_data (priv->combi.in_combi, idx));
+    else
+      i = idx;
+
+    if (i >= num_mems) {
+      ml_loge
+          ("Invalid combination index %u, incoming buffer has total %u memories.",
+          i, num_mems);
+      return FALSE;
+    }
+
+    size = gst_tensor_filter_get_tensor_size (self, idx, TRUE);
+    mem = gst_buffer_peek_memory (inbuf, i);
+
+    if (gst_memory_get_sizes (mem, NULL, NULL) != size) {
+      ml_loge ("Incoming buffer size ([%u] %zd) is invalid, expected %zd.",
+          i, gst_memory_get_sizes (mem, NULL, NULL), size);
+      return FALSE;
+    }
+
+    /* the subplugin takes the input tensors of each frame */
+    if (priv->batch_invoke)
+      continue;
+
+    /* reuse the batched input memory, allocate new one if the size is changed */
+    if (self->batch_in_mem[idx] &&
+        gst_memory_get_sizes (self->batch_in_mem[idx], NULL, NULL) !=
+        size * priv->batch_configured) {
+      gst_memory_unref (self->batch_in_mem[idx]);
+      self->batch_in_mem[idx] = NULL;
+    }
+
+    if (!self->batch_in_mem[idx]) {
+      self->batch_in_mem[idx] =
+          gst_allocator_alloc (NULL, size * priv->batch_configured, NULL);
+    }
+
+    if (!gst_memory_map (mem, &in_map, GST_MAP_READ)) {
+      ml_logf ("Cannot map input memory buffer(%d)\n", i);
+      return FALSE;
+    }
+
+    if (!gst_memory_map (self->batch_in_mem[idx], &batch_map, GST_MAP_WRITE)) {
+      ml_logf ("Cannot map batched input memory buffer(%d)\n", idx);
+      gst_memory_unmap (mem, &in_map);
+      return FALSE;
+    }
+
+    nns_memcpy (batch_map.data + offset * size, in_map.data, size);
+
+    gst_memory_unmap (self->batch_in_mem[idx], &batch_map);
+    gst_memory_unmap (mem, &in_map);
+  }
+
+  g_ptr_array_add (self->batch_frames, gst_buffer_ref (inbuf));
+  return TRUE;
+}
+
+/**
+ * @brief Make the output buffer of the frame in the batch.
+ * @param mems The output tensors of the frame (transfer full, NULL if the tensor is not in the output combination)
+ */
+static GstBuffer *
+gst_tensor_filter_batch_make_output (GstTensorFilter * self, GstBuffer * inbuf,
+    GstMemory ** mems, guint num_out, gboolean out_flexible)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorMetaInfo meta;
+  GstBuffer *outbuf;
+  GstMemory *mem, *hmem;
+  GList *list;
+  guint i;
+
+  outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (outbuf, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  /* If output combination is defined, append input tensors first */
+  if (priv->combi.out_combi_i_defined) {
+    for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
+      i = GPOINTER_TO_UINT (list->data);
+      mem = gst_buffer_peek_memory (inbuf, i);
+
+      if (out_flexible) {
+        gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i], &meta);
+        mem = gst_tensor_meta_info_append_header (&meta, mem);
+      } else {
+        mem = gst_memory_ref (mem);
+      }
+
+      gst_buffer_append_memory (outbuf, mem);
+    }
+  }
+
+  for (i = 0; i < num_out; i++) {
+    mem = mems[i];
+    if (mem == NULL)
+      continue;
 
-        GST_OBJECT_UNLOCK (trans);
-        return TRUE;
+    if (out_flexible) {
+      gst_tensor_info_convert_to_meta (&priv->prop.output_meta.info[i], &meta);
+      hmem = gst_tensor_meta_info_append_header (&meta, mem);
+      gst_memory_unref (mem);
+      mem = hmem;
+    }
+
+    gst_buffer_append_memory (outbuf, mem);
+  }
+
+  return outbuf;
+}
+
+/**
+ * @brief Invoke the frames in the batch with the subplugin callback 'invoke_batch' and collect the output of each frame. Caller should hold the batch lock.
+ * Unlike the stacked batch, the input tensors of each frame are passed to the subplugin without copying.
+ * @param report The latency report, caller should post it after releasing the batch lock.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_invoke_frames (GstTensorFilter * self,
+    GQueue * outbufs, GstStructure ** report)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (&self->element);
+  GstMemory *mems[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory **in_mem, **out_mem;
+  GstMapInfo *in_info, *out_info;
+  GstTensorMemory *in_tensors, *out_tensors;
+  const GstTensorMemory **in_frames;
+  GstTensorMemory **out_frames;
+  GstBuffer *inbuf, *outbuf;
+  GstMemory *mem;
+  guint i, k, n, idx, num_frames, num_in, num_out, total;
+  gboolean allocate_in_invoke, out_flexible, need_profiling;
+  gint ret = -1;
+  GstFlowReturn flow = GST_FLOW_OK;
+
+  num_frames = self->batch_frames->len;
+  if (num_frames == 0)
+    return GST_FLOW_OK;
+
+  num_in = priv->prop.input_meta.num_tensors;
+  num_out = priv->prop.output_meta.num_tensors;
+  total = num_frames * NNS_TENSOR_SIZE_LIMIT;
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  out_flexible = gst_tensor_pad_caps_is_flexible (srcpad);
+
+  in_mem = g_new0 (GstMemory *, total);
+  out_mem = g_new0 (GstMemory *, total);
+  in_info = g_new0 (GstMapInfo, total);
+  out_info = g_new0 (GstMapInfo, total);
+  in_tensors = g_new0 (GstTensorMemory, total);
+  out_tensors = g_new0 (GstTensorMemory, total);
+  in_frames = g_new0 (const GstTensorMemory *, num_frames);
+  out_frames = g_new0 (GstTensorMemory *, num_frames);
+
+  /* 1. Prepare the input and output tensors of each frame. */
+  for (k = 0; k < num_frames; k++) {
+    inbuf = (GstBuffer *) g_ptr_array_index (self->batch_frames, k);
+    in_frames[k] = &in_tensors[k * NNS_TENSOR_SIZE_LIMIT];
+    out_frames[k] = &out_tensors[k * NNS_TENSOR_SIZE_LIMIT];
+
+    for (i = 0; i < num_in; i++) {
+      n = k * NNS_TENSOR_SIZE_LIMIT + i;
+
+      if (priv->combi.in_combi_defined)
+        idx = GPOINTER_TO_UINT (g_list_nth_data (priv->combi.in_combi, i));
+      else
+        idx = i;
+
+      /* the memory is valid while the batch holds the frame */
+      mem = gst_buffer_peek_memory (inbuf, idx);
+      if (!gst_memory_map (mem, &in_info[n], GST_MAP_READ)) {
+        ml_logf ("Cannot map input memory buffer(%d)\n", idx);
+        goto done;
       }
 
-      priv->throttling_accum = 0;
+      in_mem[n] = mem;
+      in_tensors[n].data = in_info[n].data;
+      in_tensors[n].size = in_info[n].size;
+    }
+
+    for (i = 0; i < num_out; i++) {
+      n = k * NNS_TENSOR_SIZE_LIMIT + i;
+
+      out_tensors[n].data = NULL;
+      out_tensors[n].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+
+      if (!allocate_in_invoke) {
+        mem = gst_tensor_filter_alloc_output_mem (self, i,
+            out_tensors[n].size, out_flexible);
+        if (!gst_memory_map (mem, &out_info[n], GST_MAP_WRITE)) {
+          ml_logf ("Cannot map output memory buffer(%d)\n", i);
+          gst_memory_unref (mem);
+          goto done;
+        }
+
+        out_mem[n] = mem;
+        out_tensors[n].data = out_info[n].data;
+      }
     }
   }
 
-  GST_OBJECT_UNLOCK (trans);
-  return FALSE;
+  /* 2. Call the filter-subplugin callback, "invoke_batch" */
+  need_profiling = gst_tensor_filter_need_profiling (priv);
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  ret = gst_tensor_filter_common_invoke_batch (priv, num_frames, in_frames,
+      out_frames);
+
+  if (need_profiling)
+    record_statistics_since (self, priv->stat.latest_invoke_time, report);
+
+done:
+  /* 3. Free map info and handle error case */
+  for (n = 0; n < total; n++) {
+    if (in_mem[n])
+      gst_memory_unmap (in_mem[n], &in_info[n]);
+    if (out_mem[n])
+      gst_memory_unmap (out_mem[n], &out_info[n]);
+  }
+
+  if (ret < 0) {
+    ml_loge ("Tensor-filter invoke failed (error code = %d).\n", ret);
+    flow = GST_FLOW_ERROR;
+    goto release;
+  } else if (ret > 0) {
+    /* drop the frames in this batch */
+    goto release;
+  }
+
+  /* 4. Collect the output of each frame in order. */
+  for (k = 0; k < num_frames; k++) {
+    inbuf = (GstBuffer *) g_ptr_array_index (self->batch_frames, k);
+
+    for (i = 0; i < num_out; i++) {
+      n = k * NNS_TENSOR_SIZE_LIMIT + i;
+
+      if (allocate_in_invoke) {
+        out_mem[n] = gst_tensor_filter_get_wrapped_mem (self,
+            out_tensors[n].data, out_tensors[n].size);
+      }
+
+      if (priv->combi.out_combi_o_defined &&
+          !g_list_find (priv->combi.out_combi_o, GUINT_TO_POINTER (i)))
+        mems[i] = NULL;
+      else
+        mems[i] = gst_memory_ref (out_mem[n]);
+    }
+
+    outbuf = gst_tensor_filter_batch_make_output (self, inbuf, mems, num_out,
+        out_flexible);
+    g_queue_push_tail (outbufs, outbuf);
+  }
+
+release:
+  for (n = 0; n < total; n++) {
+    if (out_mem[n])
+      gst_memory_unref (out_mem[n]);
+  }
+
+  g_free (in_mem);
+  g_free (out_mem);
+  g_free (in_info);
+  g_free (out_info);
+  g_free (in_tensors);
+  g_free (out_tensors);
+  g_free (in_frames);
+  g_free (out_frames);
+
+  gst_tensor_filter_batch_clear (self);
+  return flow;
 }
 
 /**
- * @brief Check input paramters for gst_tensor_filter_transform ();
+ * @brief Invoke the batch and collect the output of each frame. Caller should hold the batch lock.
+ * If the batch is incomplete, the remaining input is filled with zero and its output is discarded.
+ * @param outbufs The queue to collect the output buffers, caller should push them with gst_tensor_filter_batch_push() after releasing the batch lock.
+ * @param report The latency report (NULL if not reported), caller should post it after releasing the batch lock.
  */
 static GstFlowReturn
-_gst_tensor_filter_transform_validate (GstBaseTransform * trans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+gst_tensor_filter_batch_invoke (GstTensorFilter * self, GQueue * outbufs,
+    GstStructure ** report)
 {
-  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
   GstTensorFilterPrivate *priv = &self->priv;
-  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterProperties prop;
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *mems[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *inbuf, *outbuf;
+  guint i, k, num_frames;
+  guint num_in = 0, num_out = 0;
+  gsize size;
+  gboolean allocate_in_invoke, out_flexible, need_profiling;
+  gint ret = -1;
+  GstFlowReturn flow = GST_FLOW_OK;
 
-  if (G_UNLIKELY (!priv->configured)) {
-    GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL), ("unknown format"));
-    return GST_FLOW_NOT_NEGOTIATED;
+  *report = NULL;
+
+  if (priv->batch_invoke)
+    return gst_tensor_filter_batch_invoke_frames (self, outbufs, report);
+
+  num_frames = self->batch_frames->len;
+  if (num_frames == 0)
+    return GST_FLOW_OK;
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  out_flexible =
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (self));
+
+  /* invoke the model with the batched tensor info */
+  prop = priv->prop;
+  prop.input_meta = priv->batch_in_info;
+  prop.output_meta = priv->batch_out_info;
+
+  /* 1. Prepare the batched input tensors, filling the remaining frames with zero. */
+  for (num_in = 0; num_in < prop.input_meta.num_tensors; num_in++) {
+    if (!gst_memory_map (self->batch_in_mem[num_in], &in_info[num_in],
+            GST_MAP_READWRITE)) {
+      ml_logf ("Cannot map batched input memory buffer(%d)\n", num_in);
+      goto done;
+    }
+
+    size = gst_tensor_filter_get_tensor_size (self, num_in, TRUE);
+    if (num_frames < priv->batch_configured) {
+      memset (in_info[num_in].data + num_frames * size, 0,
+          (priv->batch_configured - num_frames) * size);
+    }
+
+    in_tensors[num_in].data = in_info[num_in].data;
+    in_tensors[num_in].size = in_info[num_in].size;
   }
-  if (G_UNLIKELY (!priv->fw)) {
-    /**
-      * This is fatal; if framework is not configured until this stage,
-      * it means that an extension is missing or not configured.
-      * We need readable messages for non-developers
-      */
-    g_error
-        ("\nA nnstreamer extension is not installed or framework property of tensor_filter is incorrect: [%s] is not found.\n\n",
-        prop->fwname);
-    GST_ELEMENT_ERROR (self, LIBRARY, FAILED,
-        ("framework (filter subplugin) is not found or not configured"),
-        ("framework not configured"));
-    return GST_FLOW_ERROR;
+
+  /* 2. Prepare the batched output tensors. */
+  for (num_out = 0; num_out < prop.output_meta.num_tensors; num_out++) {
+    out_tensors[num_out].data = NULL;
+    out_tensors[num_out].size =
+        gst_tensor_info_get_size (&prop.output_meta.info[num_out]);
+
+    /* the batched output is shared with the frames, the header is not reserved */
+    if (!allocate_in_invoke) {
+      out_mem[num_out] = gst_tensor_filter_alloc_pooled_mem (self,
+          &priv->batch_out_pool[num_out], out_tensors[num_out].size, FALSE);
+      if (!gst_memory_map (out_mem[num_out], &out_info[num_out],
+              GST_MAP_WRITE)) {
+        ml_logf ("Cannot map batched output memory buffer(%d)\n", num_out);
+        goto done;
+      }
+
+      out_tensors[num_out].data = out_info[num_out].data;
+    }
   }
-  if (G_UNLIKELY (!priv->fw->run_without_model) &&
-      G_UNLIKELY (!(prop->model_files &&
-              prop->num_models > 0 && prop->model_files[0]))) {
-    GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
-        ("model filepath not configured"));
-    return GST_FLOW_ERROR;
+
+  /* 3. Call the filter-subplugin callback, "invoke" */
+  need_profiling = gst_tensor_filter_need_profiling (priv);
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  if (priv->shared_model) {
+    ret = gst_tensor_filter_common_invoke_shared (priv, &prop, in_tensors,
+        out_tensors);
+  } else if (GST_TF_FW_V0 (priv->fw)) {
+    ret = priv->fw->invoke_NN (&prop, &priv->privateData, in_tensors,
+        out_tensors);
+  } else {
+    ret = priv->fw->invoke (priv->fw, &prop, priv->privateData, in_tensors,
+        out_tensors);
   }
-  if ((GST_TF_FW_V0 (priv->fw) && G_UNLIKELY (!priv->fw->invoke_NN)) ||
-      (GST_TF_FW_V1 (priv->fw) && G_UNLIKELY (!priv->fw->invoke))) {
-    GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
-        ("invoke function is not defined"));
-    return GST_FLOW_ERROR;
+
+  if (need_profiling)
+    record_statistics_since (self, priv->stat.latest_invoke_time, report);
+
+done:
+  /* 4. Free map info and handle error case */
+  for (i = 0; i < num_in; i++)
+    gst_memory_unmap (self->batch_in_mem[i], &in_info[i]);
+
+  if (!allocate_in_invoke) {
+    for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+      if (out_mem[i] == NULL)
+        break;
+
+      /* the last one is not mapped if failed to map */
+      if (i < num_out)
+        gst_memory_unmap (out_mem[i], &out_info[i]);
+    }
   }
 
-  silent_debug ("Invoking %s with %s model\n", priv->fw->name,
-      GST_STR_NULL (prop->model_files[0]));
+  if (ret < 0) {
+    ml_loge ("Tensor-filter invoke failed (error code = %d).\n", ret);
+    flow = GST_FLOW_ERROR;
+    goto release;
+  } else if (ret > 0) {
+    /* drop the frames in this batch */
+    goto release;
+  }
 
-  /* skip input data when throttling delay is set */
-  if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
-    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  if (allocate_in_invoke) {
+    for (i = 0; i < num_out; i++) {
+      out_mem[i] = gst_tensor_filter_get_wrapped_mem (self,
+          out_tensors[i].data, out_tensors[i].size);
+    }
+  }
 
-  if (!outbuf) {
-    GST_ELEMENT_ERROR (self, RESOURCE, FAILED, ("outbuf is null."),
-        ("%s:%s:%d", __FILE__, __func__, __LINE__));
-    return GST_FLOW_ERROR;
+  /* 5. Split the output into the frames, and collect them in order. */
+  for (k = 0; k < num_frames; k++) {
+    inbuf = (GstBuffer *) g_ptr_array_index (self->batch_frames, k);
+
+    for (i = 0; i < num_out; i++) {
+      if (priv->combi.out_combi_o_defined &&
+          !g_list_find (priv->combi.out_combi_o, GUINT_TO_POINTER (i))) {
+        mems[i] = NULL;
+        continue;
+      }
+
+      size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+      mems[i] = gst_memory_share (out_mem[i], k * size, size);
+    }
+
+    outbuf = gst_tensor_filter_batch_make_output (self, inbuf, mems, num_out,
+        out_flexible);
+    g_queue_push_tail (outbufs, outbuf);
   }
-  if (gst_buffer_get_size (outbuf) != 0) {
-    GST_ELEMENT_ERROR (self, RESOURCE, FAILED, ("outbuf size is not zero."),
-        ("%s:%s:%d. size = %zu", __FILE__, __func__, __LINE__,
-            gst_buffer_get_size (outbuf)));
-    return GST_FLOW_ERROR;
+
+release:
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (out_mem[i])
+      gst_memory_unref (out_mem[i]);
   }
 
-  return GST_FLOW_OK;
+  gst_tensor_filter_batch_clear (self);
+  return flow;
+}
+
+/**
+ * @brief Take the turn to push the collected output. Caller should hold the batch lock.
+ * @return The ticket to be passed to gst_tensor_filter_batch_push().
+ */
+static guint64
+gst_tensor_filter_batch_take_ticket (GstTensorFilter * self)
+{
+  return self->batch_push_next++;
+}
+
+/**
+ * @brief Push the output buffers collected by gst_tensor_filter_batch_invoke(), in the order of the ticket.
+ * @note Caller should not hold the batch lock, so that blocking downstream does not block the element.
+ * @param flow The flow return of the invoke, the output is dropped if it is not GST_FLOW_OK.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_push (GstTensorFilter * self, GQueue * outbufs,
+    guint64 ticket, GstFlowReturn flow)
+{
+  GstPad *srcpad = GST_BASE_TRANSFORM_SRC_PAD (&self->element);
+  GstBuffer *outbuf;
+
+  /* the streaming thread and the batch timer push in the order of the batch */
+  g_mutex_lock (&self->batch_lock);
+  while (self->batch_push_turn != ticket)
+    g_cond_wait (&self->batch_cond, &self->batch_lock);
+  g_mutex_unlock (&self->batch_lock);
+
+  while ((outbuf = (GstBuffer *) g_queue_pop_head (outbufs)) != NULL) {
+    if (flow == GST_FLOW_OK)
+      flow = gst_pad_push (srcpad, outbuf);
+    else
+      gst_buffer_unref (outbuf);
+  }
+
+  g_mutex_lock (&self->batch_lock);
+  self->batch_push_turn++;
+  g_cond_broadcast (&self->batch_cond);
+  g_mutex_unlock (&self->batch_lock);
+
+  return flow;
+}
+
+/**
+ * @brief Invoke the incomplete batch and push the output. Caller should hold the batch lock, the lock is released while pushing the output.
+ */
+static void
+gst_tensor_filter_batch_flush (GstTensorFilter * self)
+{
+  GQueue outbufs = G_QUEUE_INIT;
+  GstStructure *report;
+  GstFlowReturn flow;
+  guint64 ticket;
+
+  flow = gst_tensor_filter_batch_invoke (self, &outbufs, &report);
+  ticket = gst_tensor_filter_batch_take_ticket (self);
+
+  g_mutex_unlock (&self->batch_lock);
+  post_statistics (self, report);
+  flow = gst_tensor_filter_batch_push (self, &outbufs, ticket, flow);
+
+  if (flow == GST_FLOW_ERROR) {
+    GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+        ("Failed to invoke the incomplete batch."));
+  }
+
+  g_mutex_lock (&self->batch_lock);
+  if (flow != GST_FLOW_OK)
+    self->batch_flow = flow;
+}
+
+/**
+ * @brief Thread to invoke the incomplete batch when the timeout expires.
+ */
+static gpointer
+gst_tensor_filter_batch_loop (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+
+  gst_tensor_filter_common_apply_thread_policy (&self->priv);
+
+  g_mutex_lock (&self->batch_lock);
+  while (self->batch_running) {
+    if (self->batch_frames->len == 0) {
+      g_cond_wait (&self->batch_cond, &self->batch_lock);
+    } else if (g_get_monotonic_time () < self->batch_deadline) {
+      g_cond_wait_until (&self->batch_cond, &self->batch_lock,
+          self->batch_deadline);
+    } else {
+      GST_DEBUG_OBJECT (self, "Batch timeout, invoke %u frames.",
+          self->batch_frames->len);
+      gst_tensor_filter_batch_flush (self);
+    }
+  }
+  g_mutex_unlock (&self->batch_lock);
+
+  gst_tensor_filter_common_restore_thread_policy (&self->priv, TRUE);
+  return NULL;
+}
+
+/**
+ * @brief Stop the batch timer and release the incomplete batch.
+ */
+static void
+gst_tensor_filter_batch_stop (GstTensorFilter * self)
+{
+  GThread *thread;
+
+  g_mutex_lock (&self->batch_lock);
+  self->batch_running = FALSE;
+  g_cond_broadcast (&self->batch_cond);
+  thread = self->batch_thread;
+  self->batch_thread = NULL;
+  g_mutex_unlock (&self->batch_lock);
+
+  if (thread)
+    g_thread_join (thread);
+
+  g_mutex_lock (&self->batch_lock);
+  gst_tensor_filter_batch_clear (self);
+  gst_tensor_filter_batch_free_staging (self);
+  g_mutex_unlock (&self->batch_lock);
+}
+
+/**
+ * @brief Append the frame to the batch, and invoke the model if the batch is filled.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_batch (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GQueue outbufs = G_QUEUE_INIT;
+  GstStructure *report;
+  GstFlowReturn flow;
+  guint64 ticket;
+
+  g_mutex_lock (&self->batch_lock);
+
+  /* the batch timer may fail to push the output */
+  flow = self->batch_flow;
+  if (flow != GST_FLOW_OK)
+    goto done;
+
+  if (!gst_tensor_filter_batch_append (self, inbuf)) {
+    flow = GST_FLOW_ERROR;
+    goto done;
+  }
+
+  if (self->batch_frames->len >= priv->batch_configured) {
+    flow = gst_tensor_filter_batch_invoke (self, &outbufs, &report);
+    ticket = gst_tensor_filter_batch_take_ticket (self);
+    g_mutex_unlock (&self->batch_lock);
+    post_statistics (self, report);
+
+    /* push the output after releasing the lock */
+    flow = gst_tensor_filter_batch_push (self, &outbufs, ticket, flow);
+    goto pushed;
+  } else if (self->batch_frames->len == 1 && priv->batch_timeout > 0) {
+    self->batch_deadline = g_get_monotonic_time () +
+        (gint64) priv->batch_timeout * G_TIME_SPAN_MILLISECOND;
+
+    if (!self->batch_thread) {
+      self->batch_running = TRUE;
+      self->batch_thread = g_thread_new ("tensor_filter_batch",
+          gst_tensor_filter_batch_loop, self);
+    }
+
+    g_cond_broadcast (&self->batch_cond);
+  }
+
+done:
+  g_mutex_unlock (&self->batch_lock);
+
+pushed:
+  /* the output buffers are pushed when invoking the batch */
+  return (flow == GST_FLOW_OK) ? GST_BASE_TRANSFORM_FLOW_DROPPED : flow;
 }
 
 /**
@@ -585,240 +3344,195 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
 static GstFlowReturn
 gst_tensor_filter_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterFrame frame;
+  gboolean need_profiling, use_cache;
+  guint64 cache_key = 0;
+  gint ret;
+
+  /* 0. Check all properties. */
+  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, inbuf,
+      outbuf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  /* micro-batching, the frames are invoked synchronously */
+  if (priv->batch_configured > 1)
+    return gst_tensor_filter_transform_batch (self, inbuf);
+
+  if (gst_tensor_filter_async_enabled (self))
+    return gst_tensor_filter_transform_async (self, inbuf);
+
+  /* push the frames in flight first, in case of disabling asynchronous invoke */
+  gst_tensor_filter_async_drain (self);
+
+  /* skip the invoke if the output of same input is cached */
+  use_cache = gst_tensor_filter_cache_enabled (self) &&
+      gst_tensor_filter_cache_hash (inbuf, &cache_key);
+  if (use_cache) {
+    if (gst_tensor_filter_cache_lookup (self, cache_key, inbuf, outbuf)) {
+      __atomic_fetch_add (&priv->stat.cache_hits, 1, __ATOMIC_RELAXED);
+      return GST_FLOW_OK;
+    }
+
+    __atomic_fetch_add (&priv->stat.cache_misses, 1, __ATOMIC_RELAXED);
+  }
+
+  /* 1. Get all input tensors from inbuf, 2. Prepare output tensors. */
+  if (!gst_tensor_filter_frame_prepare (self, &frame, inbuf))
+    return (frame.result != GST_FLOW_OK) ? frame.result : GST_FLOW_ERROR;
+
+  need_profiling = gst_tensor_filter_need_profiling (priv);
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  /* 3. Call the filter-subplugin callback, "invoke" */
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, frame.invoke_tensors, frame.out_tensors);
+  if (need_profiling)
+    record_statistics (self);
+
+  /* 4. Free map info and handle error case, 5. Update result */
+  retval = gst_tensor_filter_frame_finish (self, &frame, ret, outbuf);
+
+  if (use_cache && retval == GST_FLOW_OK)
+    gst_tensor_filter_cache_insert (self, cache_key, inbuf, outbuf);
+
+  return retval;
+}
+
+/**
+ * @brief Check whether the model can write the output into the memory block.
+ */
+static gboolean
+gst_tensor_filter_memory_is_writable (GstMemory * mem)
+{
+  return !GST_MEMORY_IS_READONLY (mem) && gst_memory_is_exclusive (mem);
+}
+
+/**
+ * @brief in-place transform. optional vmethod of GstBaseTransform.
+ * The model writes the output tensors into the memory blocks of the input buffer.
+ * If the memory block is shared with other buffers (e.g., the input buffer is not writable and basetransform made a shallow copy), the output is written into new memory block which replaces the input, to avoid copying the input.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
 {
   GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
   GstTensorFilterPrivate *priv = &self->priv;
   GstTensorFilterProperties *prop = &priv->prop;
-  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo info[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
   GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
   GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GList *list;
-  guint i, num_mems;
+  guint i, num_mems, num_mapped = 0;
+  gsize expected;
+  gboolean need_profiling, writable;
   gint ret;
-  gboolean allocate_in_invoke, in_flexible, out_flexible;
-  gboolean need_profiling;
-  gsize expected, hsize;
-
-  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *mem;
 
   /* 0. Check all properties. */
-  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, inbuf,
-      outbuf);
+  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, buf,
+      buf);
   if (retval != GST_FLOW_OK)
     return retval;
 
-  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
-
-  in_flexible =
-      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans));
-  out_flexible =
-      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
-
-  /* 1. Get all input tensors from inbuf. */
-  /* Internal Logic Error or GST Bug (sinkcap changed!) */
-  num_mems = gst_buffer_n_memory (inbuf);
+  num_mems = gst_buffer_n_memory (buf);
+  if (num_mems != prop->input_meta.num_tensors) {
+    ml_loge ("Incoming buffer has invalid memory blocks (%u), expected %u.",
+        num_mems, prop->input_meta.num_tensors);
+    return GST_FLOW_ERROR;
+  }
 
+  /* 1. Get all tensors from buf, the output tensors share the input memory if it is writable. */
   for (i = 0; i < num_mems; i++) {
-    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
-    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+    mem[i] = gst_buffer_peek_memory (buf, i);
+    writable = gst_tensor_filter_memory_is_writable (mem[i]);
+
+    if (!gst_memory_map (mem[i], &info[i],
+            writable ? GST_MAP_READWRITE : GST_MAP_READ)) {
       ml_logf ("Cannot map input memory buffer(%d)\n", i);
       goto mem_map_error;
     }
 
-    hsize = 0;
-    if (in_flexible) {
-      gst_tensor_meta_info_parse_header (&in_meta[i], in_info[i].data);
-      hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
-    }
-
-    in_tensors[i].data = in_info[i].data + hsize;
-    in_tensors[i].size = in_info[i].size - hsize;
-  }
-
-  /* 1.1 Prepare tensors to invoke. */
-  if (priv->combi.in_combi_defined) {
-    guint info_idx = 0;
-
-    for (list = priv->combi.in_combi; list != NULL; list = list->next) {
-      i = GPOINTER_TO_UINT (list->data);
-
-      if (i >= num_mems) {
-        ml_loge
-            ("Invalid combination index %u, incoming buffer has total %u memories.",
-            i, num_mems);
-        goto mem_map_error;
-      }
-
-      expected = gst_tensor_filter_get_tensor_size (self, info_idx, TRUE);
-      if (expected != in_tensors[i].size) {
-        ml_loge ("Incoming buffer size ([%u] %zd) is invalid, expected %zd.",
-            i, in_tensors[i].size, expected);
-        goto mem_map_error;
-      }
+    num_mapped++;
 
-      invoke_tensors[info_idx++] = in_tensors[i];
-    }
-  } else {
-    if (num_mems != prop->input_meta.num_tensors) {
-      ml_loge ("Incoming buffer has invalid memory blocks (%u), expected %u.",
-          num_mems, prop->input_meta.num_tensors);
+    expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+    if (expected != info[i].size) {
+      ml_loge ("Incoming buffer size ([%u] %zd) is invalid, expected %zd.",
+          i, info[i].size, expected);
       goto mem_map_error;
     }
 
-    for (i = 0; i < prop->input_meta.num_tensors; i++) {
-      expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
-      if (expected != in_tensors[i].size) {
-        ml_loge ("Incoming buffer size ([%u] %zd) is invalid, expected %zd.",
-            i, in_tensors[i].size, expected);
-        goto mem_map_error;
-      }
-
-      invoke_tensors[i] = in_tensors[i];
-    }
-  }
+    in_tensors[i].data = info[i].data;
+    in_tensors[i].size = info[i].size;
 
-  /* 2. Prepare output tensors. */
-  for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    out_tensors[i].data = NULL;
+    out_tensors[i].data = info[i].data;
     out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
 
-    hsize = 0;
-    if (out_flexible) {
-      gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
-          &out_meta[i]);
-      hsize = gst_tensor_meta_info_get_header_size (&out_meta[i]);
-    }
-
-    /* allocate memory if allocate_in_invoke is FALSE */
-    if (!allocate_in_invoke) {
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
+    if (!writable) {
+      out_mem[i] = gst_tensor_filter_alloc_output_mem (self, i,
+          out_tensors[i].size, FALSE);
       if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
         ml_logf ("Cannot map output memory buffer(%d)\n", i);
+        gst_memory_unref (out_mem[i]);
+        out_mem[i] = NULL;
         goto mem_map_error;
       }
 
-      out_tensors[i].data = out_info[i].data + hsize;
-
-      /* append header */
-      if (out_flexible)
-        gst_tensor_meta_info_update_header (&out_meta[i], out_info[i].data);
+      out_tensors[i].data = out_info[i].data;
     }
   }
 
-  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0);
+  need_profiling = gst_tensor_filter_need_profiling (priv);
   if (need_profiling)
     prepare_statistics (priv);
 
-  /* 3. Call the filter-subplugin callback, "invoke" */
-  GST_TF_FW_INVOKE_COMPAT (priv, ret, invoke_tensors, out_tensors);
+  /* 2. Call the filter-subplugin callback, "invoke" */
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
   if (need_profiling)
-    record_statistics (priv);
-
-  /* 4. Free map info and handle error case */
-  for (i = 0; i < num_mems; i++)
-    gst_memory_unmap (in_mem[i], &in_info[i]);
+    record_statistics (self);
 
-  if (!allocate_in_invoke) {
-    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+  /* 3. Free map info and handle error case */
+  for (i = 0; i < num_mems; i++) {
+    gst_memory_unmap (mem[i], &info[i]);
+    if (out_mem[i])
       gst_memory_unmap (out_mem[i], &out_info[i]);
-      if (ret != 0)
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-    }
   }
 
   /** @todo define enum to indicate status code */
   if (ret < 0) {
     ml_loge ("Tensor-filter invoke failed (error code = %d).\n", ret);
-    return GST_FLOW_ERROR;
+    retval = GST_FLOW_ERROR;
   } else if (ret > 0) {
     /* drop this buffer */
-    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    retval = GST_BASE_TRANSFORM_FLOW_DROPPED;
   }
 
-  /* 5. Update result */
-  /* If output combination is defined, append input tensors first */
-  if (priv->combi.out_combi_i_defined) {
-    for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
-      i = GPOINTER_TO_UINT (list->data);
-
-      if (!in_flexible && out_flexible) {
-        /* append header */
-        gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i],
-            &in_meta[i]);
-        mem = gst_tensor_meta_info_append_header (&in_meta[i], in_mem[i]);
-      } else if (in_flexible && !out_flexible) {
-        /* remove header */
-        hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
-        mem = gst_memory_share (in_mem[i], hsize, -1);
-      } else {
-        mem = gst_memory_ref (in_mem[i]);
-      }
+  /* 4. Replace the memory blocks not written in-place with the output */
+  for (i = 0; i < num_mems; i++) {
+    if (out_mem[i] == NULL)
+      continue;
 
-      gst_buffer_append_memory (outbuf, mem);
-    }
+    if (retval == GST_FLOW_OK)
+      gst_buffer_replace_memory (buf, i, out_mem[i]);
+    else
+      gst_memory_unref (out_mem[i]);
   }
 
-  for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    if (priv->combi.out_combi_o_defined) {
-      gboolean out_combi = FALSE;
-
-      for (list = priv->combi.out_combi_o; list != NULL; list = list->next) {
-        if (i == GPOINTER_TO_UINT (list->data)) {
-          out_combi = TRUE;
-          break;
-        }
-      }
-      if (!out_combi) {
-        /* release memory block if output tensor is not in the combi list */
-        if (allocate_in_invoke) {
-          gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
-        } else {
-          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-        }
-
-        continue;
-      }
-    }
-
-    if (allocate_in_invoke) {
-      /* prepare memory block if successfully done */
-      out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
-          out_tensors[i].data, out_tensors[i].size);
-
-      if (out_flexible) {
-        /* prepare new memory block with meta */
-        out_mem[i] = gst_tensor_meta_info_append_header (&out_meta[i], mem);
-        gst_memory_unref (mem);
-      }
-    }
-
-    /* append the memory block to outbuf */
-    gst_buffer_append_memory (outbuf, out_mem[i]);
-  }
+  return retval;
 
-  return GST_FLOW_OK;
 mem_map_error:
-  num_mems = gst_buffer_n_memory (inbuf);
-  for (i = 0; i < num_mems; i++) {
-    if (in_mem[i])
-      gst_memory_unmap (in_mem[i], &in_info[i]);
-  }
-
-  if (!allocate_in_invoke) {
-    for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      if (out_mem[i]) {
-        gst_memory_unmap (out_mem[i], &out_info[i]);
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-      }
+  for (i = 0; i < num_mapped; i++) {
+    gst_memory_unmap (mem[i], &info[i]);
+    if (out_mem[i]) {
+      gst_memory_unmap (out_mem[i], &out_info[i]);
+      gst_memory_unref (out_mem[i]);
     }
   }
+
   return GST_FLOW_ERROR;
 }
 
@@ -928,6 +3642,21 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
     }
   }
 
+  /** set the batched input info to the model if micro-batching is enabled */
+  if (!priv->configured && priv->batch_size > 1) {
+    if (flexible) {
+      GST_ERROR_OBJECT (self,
+          "The input tensor is flexible, cannot invoke the frames in a batch.");
+      goto done;
+    }
+
+    if (!gst_tensor_filter_common_configure_batch (priv, priv->batch_size)) {
+      GST_ERROR_OBJECT (self, "Failed to configure the batch (size %u).",
+          priv->batch_size);
+      goto done;
+    }
+  }
+
   /**
    * @todo framerate of output tensors
    * How can we update the framerate?
@@ -995,7 +3724,7 @@ gst_tensor_filter_transform_caps (GstBaseTransform * trans,
   prop = &priv->prop;
 
   /* Not ready */
-  if (priv->fw == NULL)
+  if (priv->fw == NULL || !gst_tensor_filter_loader_wait (self))
     return NULL;
 
   gst_tensors_config_init (&in_config);
@@ -1123,6 +3852,59 @@ gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
   return result;
 }
 
+/**
+ * @brief Check whether the negotiated tensors can be invoked in-place.
+ * @param self "this" pointer
+ * @param out_flexible TRUE if the output tensor is flexible
+ * @return TRUE if the model can write the output into the input buffer
+ */
+static gboolean
+gst_tensor_filter_check_in_place (GstTensorFilter * self,
+    gboolean out_flexible)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  int allow_in_place = 0;
+  guint i;
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    allow_in_place = priv->fw->allow_in_place;
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    allow_in_place = priv->info.allow_in_place;
+  }
+
+  if (!allow_in_place || gst_tensor_filter_allocate_in_invoke (priv))
+    return FALSE;
+
+  /* the frames are invoked in the other paths */
+  if (priv->batch_configured > 1 || gst_tensor_filter_async_enabled (self))
+    return FALSE;
+
+  /* the frames are looked up in the invoke cache */
+  if (priv->invoke_cache && priv->invoke_cache_size > 0 &&
+      !priv->combi.out_combi_i_defined)
+    return FALSE;
+
+  /* the output buffer should consist of the model output only */
+  if (priv->combi.in_combi_defined || priv->combi.out_combi_i_defined ||
+      priv->combi.out_combi_o_defined)
+    return FALSE;
+
+  if (out_flexible || gst_tensors_info_is_flexible (&priv->in_config.info))
+    return FALSE;
+
+  if (prop->input_meta.num_tensors != prop->output_meta.num_tensors)
+    return FALSE;
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    if (gst_tensor_info_get_size (&prop->input_meta.info[i]) !=
+        gst_tensor_info_get_size (&prop->output_meta.info[i]))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief set caps. required vmethod of GstBaseTransform.
  */
@@ -1141,6 +3923,11 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
   silent_debug_caps (incaps, "incaps");
   silent_debug_caps (outcaps, "outcaps");
 
+  if (!gst_tensor_filter_loader_wait (self)) {
+    GST_ERROR_OBJECT (self, "Failed to open the framework.");
+    return FALSE;
+  }
+
   if (!gst_tensor_filter_configure_tensor (self, incaps)) {
     GST_ERROR_OBJECT (self, "Failed to configure tensor.");
     return FALSE;
@@ -1167,6 +3954,19 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  self->in_place = gst_tensor_filter_check_in_place (self,
+      gst_tensors_info_is_flexible (&config.info));
+  gst_base_transform_set_in_place (trans, self->in_place);
+  GST_INFO_OBJECT (self, "In-place invoke is %s.",
+      self->in_place ? "enabled" : "disabled");
+
+  /* output size may be changed, reset buffer pools and cached outputs */
+  gst_tensor_filter_release_pools (self);
+  gst_tensor_filter_ring_release (self);
+  gst_tensor_filter_cache_clear (self);
+
+  /* input info may be changed, reopen the instances when invoking the frame */
+  gst_tensor_filter_workers_stop (self);
   return TRUE;
 }
 
@@ -1198,6 +3998,150 @@ gst_tensor_filter_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Check whether the buffer pool allocates the memory with the alignment.
+ */
+static gboolean
+gst_tensor_filter_pool_is_aligned (GstBufferPool * pool, gsize align)
+{
+  GstStructure *config;
+  GstAllocationParams params;
+  gboolean aligned = FALSE;
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_allocation_params_init (&params);
+  if (gst_buffer_pool_config_get_allocator (config, NULL, &params))
+    aligned = ((params.align & align) == align);
+  gst_structure_free (config);
+
+  return aligned;
+}
+
+/**
+ * @brief Raise the alignment of the allocation parameters in the query, and remove the buffer pools without the alignment.
+ */
+static void
+gst_tensor_filter_align_allocation (GstQuery * query, gsize align)
+{
+  GstAllocator *allocator;
+  GstAllocationParams params;
+  GstBufferPool *pool;
+  guint i, n;
+
+  n = gst_query_get_n_allocation_params (query);
+  for (i = 0; i < n; i++) {
+    allocator = NULL;
+    gst_query_parse_nth_allocation_param (query, i, &allocator, &params);
+
+    if ((params.align & align) != align) {
+      params.align |= align;
+      gst_query_set_nth_allocation_param (query, i, allocator, &params);
+    }
+
+    if (allocator)
+      gst_object_unref (allocator);
+  }
+
+  if (n == 0) {
+    gst_allocation_params_init (&params);
+    params.align = align;
+    gst_query_add_allocation_param (query, NULL, &params);
+  }
+
+  for (i = gst_query_get_n_allocation_pools (query); i > 0; i--) {
+    pool = NULL;
+    gst_query_parse_nth_allocation_pool (query, i - 1, &pool, NULL, NULL,
+        NULL);
+
+    if (pool) {
+      if (!gst_tensor_filter_pool_is_aligned (pool, align))
+        gst_query_remove_nth_allocation_pool (query, i - 1);
+      gst_object_unref (pool);
+    }
+  }
+}
+
+/**
+ * @brief Propose the allocation parameters and the buffer pool to upstream. optional vmethod of BaseTransform
+ * @details If input-alignment is given or the framework requires the alignment (mem_align of the framework info, e.g., 64 bytes for tensorflow-lite), upstream allocates the input memory with the larger one, so that the framework directly uses the input without copying it.
+ *          In passthrough and in-place mode (decide_query is NULL), the query is answered by downstream and the model writes the output into the input memory, so the alignment is applied to the answer of downstream.
+ *          The alignment is applied to each memory of multi tensors. With flexible tensors, the data follows the header in the memory, so the data is aligned only if the header size is a multiple of the alignment.
+ *          The buffer pool of the input tensor is proposed for static input with single tensor only, if upstream needs it and downstream did not propose the aligned pool.
+ */
+static gboolean
+gst_tensor_filter_propose_allocation (GstBaseTransform * trans,
+    GstQuery * decide_query, GstQuery * query)
+{
+  GstTensorFilter *self;
+  GstTensorFilterPrivate *priv;
+  GstTensorsConfig config;
+  GstTensorMetaInfo meta;
+  GstAllocationParams params;
+  GstBufferPool *pool;
+  GstStructure *pool_config;
+  GstCaps *caps;
+  gboolean need_pool;
+  gsize size, prefix;
+  guint align;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+  priv = &self->priv;
+
+  if (!GST_BASE_TRANSFORM_CLASS (parent_class)->propose_allocation (trans,
+          decide_query, query))
+    return FALSE;
+
+  /* the framework may require the alignment to use the input without copying it */
+  align = MAX (priv->input_alignment, priv->info.mem_align);
+  if (align == 0)
+    return TRUE;
+
+  gst_tensor_filter_align_allocation (query, align - 1);
+
+  gst_query_parse_allocation (query, &caps, &need_pool);
+  if (!need_pool || caps == NULL ||
+      gst_query_get_n_allocation_pools (query) > 0)
+    return TRUE;
+
+  gst_tensors_config_init (&config);
+  gst_tensors_config_from_structure (&config, gst_caps_get_structure (caps, 0));
+
+  if (!gst_tensors_config_validate (&config) ||
+      gst_tensors_info_is_flexible (&config.info) ||
+      config.info.num_tensors != 1)
+    goto done;
+
+  size = gst_tensors_info_get_size (&config.info, 0);
+
+  gst_allocation_params_init (&params);
+  params.align = align - 1;
+
+  /* reserve the area for the header of flexible tensor, if it keeps the alignment */
+  gst_tensor_meta_info_init (&meta);
+  prefix = gst_tensor_meta_info_get_header_size (&meta);
+  if ((prefix & params.align) == 0) {
+    params.flags = GST_TENSOR_MEMORY_FLAG_HEADER_ROOM;
+    params.prefix = prefix;
+  }
+
+  pool = gst_buffer_pool_new ();
+  pool_config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (pool_config, caps, size, 0, 0);
+  gst_buffer_pool_config_set_allocator (pool_config, NULL, &params);
+
+  if (gst_buffer_pool_set_config (pool, pool_config)) {
+    GST_DEBUG_OBJECT (self, "Propose the buffer pool (size %zd, align %u).",
+        size, align);
+    gst_query_add_allocation_pool (query, pool, size, 0, 0);
+  }
+
+  gst_object_unref (pool);
+
+done:
+  gst_tensors_config_free (&config);
+  return TRUE;
+}
+
 /**
  * @brief Event handler for sink pad of tensor filter.
  * @param trans "this" pointer
@@ -1213,7 +4157,60 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
 
+  /* serialized events should be sent after the frames in flight */
+  if (GST_EVENT_IS_SERIALIZED (event) &&
+      GST_EVENT_TYPE (event) != GST_EVENT_FLUSH_STOP) {
+    gst_tensor_filter_async_drain (self);
+  }
+
+  /* invoke the incomplete batch only before the events ending or changing the stream */
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_EOS:
+    case GST_EVENT_CAPS:
+    case GST_EVENT_SEGMENT:
+      if (priv->batch_size > 1) {
+        g_mutex_lock (&self->batch_lock);
+        gst_tensor_filter_batch_flush (self);
+        g_mutex_unlock (&self->batch_lock);
+      }
+      break;
+    default:
+      break;
+  }
+
   switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+    {
+      gboolean ret;
+
+      g_mutex_lock (&self->async_lock);
+      self->async_flushing = TRUE;
+      g_cond_broadcast (&self->async_cond);
+      g_mutex_unlock (&self->async_lock);
+
+      gst_tensor_filter_ring_set_flushing (self, TRUE);
+
+      ret = GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+      gst_pad_pause_task (GST_BASE_TRANSFORM_SRC_PAD (trans));
+
+      g_mutex_lock (&self->batch_lock);
+      gst_tensor_filter_batch_clear (self);
+      g_mutex_unlock (&self->batch_lock);
+      return ret;
+    }
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_filter_async_clear (self);
+
+      g_mutex_lock (&self->async_lock);
+      self->async_flushing = FALSE;
+      g_mutex_unlock (&self->async_lock);
+
+      g_mutex_lock (&self->batch_lock);
+      self->batch_flow = GST_FLOW_OK;
+      g_mutex_unlock (&self->batch_lock);
+
+      gst_tensor_filter_ring_set_flushing (self, FALSE);
+      break;
     case GST_EVENT_CUSTOM_DOWNSTREAM:
     {
       const GstStructure *structure = gst_event_get_structure (event);
@@ -1305,6 +4302,7 @@ gst_tensor_filter_start (GstBaseTransform * trans)
 {
   GstTensorFilter *self;
   GstTensorFilterPrivate *priv;
+  gboolean preloading;
 
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
@@ -1313,7 +4311,36 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   if (priv->fw == NULL)
     return FALSE;
 
-  gst_tensor_filter_common_open_fw (priv);
+  priv->stat.first_frame_latency = -1;
+
+  g_mutex_lock (&self->async_lock);
+  self->async_flushing = FALSE;
+  self->async_flow = GST_FLOW_OK;
+  g_mutex_unlock (&self->async_lock);
+
+  g_mutex_lock (&self->batch_lock);
+  self->batch_flow = GST_FLOW_OK;
+  g_mutex_unlock (&self->batch_lock);
+
+  GST_OBJECT_LOCK (self);
+  preloading = (self->loader_thread != NULL);
+  GST_OBJECT_UNLOCK (self);
+
+  /* the framework is being opened in background, report the error in the state change */
+  if (preloading) {
+    if (!gst_tensor_filter_loader_wait (self)) {
+      GST_ELEMENT_ERROR (self, RESOURCE, OPEN_READ,
+          ("Failed to open the framework in background thread."), (NULL));
+      return FALSE;
+    }
+  } else {
+    gst_tensor_filter_common_open_fw (priv);
+  }
+
+  /* the warm-up runs in READY to PAUSED, with the thread policy and the properties at this time */
+  if (priv->prop.fw_opened && !gst_tensor_filter_common_warmup (priv))
+    GST_WARNING_OBJECT (self, "Failed to run the warm-up invokes.");
+
   return priv->prop.fw_opened;
 }
 
@@ -1331,6 +4358,14 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
 
+  gst_tensor_filter_loader_wait (self);
+  gst_tensor_filter_swap_stop (self);
+  gst_tensor_filter_release_pools (self);
+  gst_tensor_filter_ring_release (self);
+  gst_tensor_filter_cache_clear (self);
   gst_tensor_filter_common_close_fw (priv);
+
+  /* the streaming thread is not pinned after stopping */
+  gst_tensor_filter_common_restore_thread_policy (priv, FALSE);
   return TRUE;
 }
@@ -54,6 +54,8 @@ G_BEGIN_DECLS
 
 typedef struct _GstTensorFilter GstTensorFilter;
 typedef struct _GstTensorFilterClass GstTensorFilterClass;
+typedef struct _GstTensorFilterWorker GstTensorFilterWorker;
+typedef struct _GstTensorFilterRing GstTensorFilterRing;
 
 /**
  * @brief Internal data structure for tensor_filter instances.
@@ -63,6 +65,45 @@ struct _GstTensorFilter
   GstBaseTransform element;     /**< This is the parent object */
 
   GstTensorFilterPrivate priv; /**< Internal properties for tensor-filter */
+
+  GMutex async_lock; /**< Lock for the frames in flight */
+  GCond async_cond; /**< Condition to wait for the frames in flight */
+  GQueue async_frames; /**< The frames in flight, in the order of the input */
+  gboolean async_flushing; /**< TRUE to stop waiting for the frames in flight */
+  GstFlowReturn async_flow; /**< The last flow return of the output task */
+
+  GMutex batch_lock; /**< Lock for the incomplete batch */
+  GCond batch_cond; /**< Condition to wake up the batch timer */
+  GThread *batch_thread; /**< The thread to invoke the incomplete batch when the timeout expires */
+  gboolean batch_running; /**< TRUE while the batch timer is running */
+  GPtrArray *batch_frames; /**< The input buffers in the incomplete batch */
+  GstMemory *batch_in_mem[NNS_TENSOR_SIZE_LIMIT]; /**< The batched input tensors */
+  gint64 batch_deadline; /**< The monotonic time to invoke the incomplete batch */
+  GstFlowReturn batch_flow; /**< The last flow return of the batch timer */
+  guint64 batch_push_next; /**< The ticket of the next invoked batch to push the output */
+  guint64 batch_push_turn; /**< The ticket of the batch whose output is being pushed */
+
+  GstTensorFilterWorker *workers; /**< The workers invoking the frames in parallel, one for each instance */
+  guint num_workers; /**< The number of running workers */
+  guint64 worker_seq; /**< The sequence number of the frame to dispatch the workers in round-robin */
+
+  gboolean in_place; /**< TRUE if the negotiated tensors can be invoked in-place */
+
+  GstTensorFilterRing *out_ring; /**< The ring of output buffers owned by the subplugin (NULL if not provided) */
+  gboolean out_ring_checked; /**< TRUE if the subplugin is asked for the output ring */
+
+  GMutex cache_lock; /**< Lock for the invoke cache */
+  GQueue cache_lru; /**< The cached outputs, the most recently used first */
+  GHashTable *cache_table; /**< The table to find the cached output with the hash of input */
+  guint64 cache_used; /**< The size of the cached outputs in bytes */
+
+  GThread *loader_thread; /**< The thread to open the framework in background (see preload) */
+
+  GMutex swap_lock; /**< Lock for the model loaded in background */
+  GThread *swap_thread; /**< The thread to load new model in background (see hot-swap) */
+  gboolean swap_running; /**< TRUE while the thread is loading new model */
+  gchar *swap_pending; /**< The latest model files requested while loading new model */
+  GstTensorFilterModelSwap *swap_ready; /**< The model to be swapped at next frame boundary */
 };
 
 /**
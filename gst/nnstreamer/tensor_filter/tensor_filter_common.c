@@ -23,8 +23,25 @@
  *
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <string.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+#ifndef CPU_SETSIZE
+#define CPU_SETSIZE (1024)
+#endif
 
+#include <glib/gstdio.h>
 #include <hw_accel.h>
 #include <nnstreamer_log.h>
 #include <tensor_common.h>
@@ -84,43 +101,172 @@ static const gchar *regex_accl_elem_utils[] = {
 #define g_strfreev_const(x) g_strfreev((void*)(long)(x))
 
 static GType accl_hw_get_type (void);
+static int _gtfc_fw_open (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data);
 static GList *parse_accl_hw_all (const gchar * accelerators,
     const gchar ** supported_accelerators);
 static gint _gtfc_setprop_IS_UPDATABLE (GstTensorFilterPrivate * priv,
     GstTensorFilterProperties * prop, const GValue * value);
 static gint _gtfc_setprop_ACCELERATOR (GstTensorFilterPrivate * priv,
     GstTensorFilterProperties * prop, const GValue * value);
+static gboolean _gtfc_shared_model_destroy_notify (GstTensorFilterPrivate *
+    priv, void *data);
+static void _gtfc_destroy_notify_context (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data, void *data);
+
+/**
+ * @brief Default max number of buffers in the output buffer pool.
+ */
+#define DEFAULT_OUTPUT_POOL_SIZE (4)
+
+/**
+ * @brief Default number of preallocated buffers in the output buffer pool.
+ */
+#define DEFAULT_OUTPUT_POOL_MIN_BUFFERS (0)
+
+/**
+ * @brief Default memory alignment of the input tensor (0 not to propose the alignment to upstream).
+ */
+#define DEFAULT_INPUT_ALIGNMENT (0)
+
+/**
+ * @brief Default max number of frames in flight with asynchronous invoke.
+ */
+#define DEFAULT_MAX_INFLIGHT (4)
+
+/**
+ * @brief Default number of frames to be invoked at once (1 to disable micro-batching).
+ */
+#define DEFAULT_BATCH_SIZE (1)
+
+/**
+ * @brief Default timeout (in milliseconds) to invoke the incomplete batch (0 to wait for the batch).
+ */
+#define DEFAULT_BATCH_TIMEOUT (0)
+
+/**
+ * @brief Default number of instances of NN framework.
+ */
+#define DEFAULT_NUM_INSTANCES (1)
+
+/**
+ * @brief Default interval (ms) to post the latency percentiles (0 to disable).
+ */
+#define DEFAULT_LATENCY_REPORT_INTERVAL (0)
+
+/**
+ * @brief Default number of framework contexts in the pool of the shared model.
+ */
+#define DEFAULT_SHARED_POOL_SIZE (1)
 
 /**
- * @brief GstTensorFilter properties.
- */
-enum
-{
-  PROP_0,
-  PROP_SILENT,
-  PROP_FRAMEWORK,
-  PROP_MODEL,
-  PROP_INPUT,
-  PROP_INPUTTYPE,
-  PROP_INPUTNAME,
-  PROP_INPUTLAYOUT,
-  PROP_INPUTRANKS,
-  PROP_OUTPUT,
-  PROP_OUTPUTTYPE,
-  PROP_OUTPUTNAME,
-  PROP_OUTPUTLAYOUT,
-  PROP_OUTPUTRANKS,
-  PROP_CUSTOM,
-  PROP_SUBPLUGINS,
-  PROP_ACCELERATOR,
-  PROP_IS_UPDATABLE,
-  PROP_LATENCY,
-  PROP_THROUGHPUT,
-  PROP_INPUTCOMBINATION,
-  PROP_OUTPUTCOMBINATION,
-  PROP_SHARED_TENSOR_FILTER_KEY,
+ * @brief Default max size of the cached outputs in bytes.
+ */
+#define DEFAULT_INVOKE_CACHE_SIZE (16 * 1024 * 1024)
+
+/**
+ * @brief Default budget (ms) of the deadline mode (0 to disable).
+ */
+#define DEFAULT_DEADLINE (0)
+
+/**
+ * @brief Default number of the warm-up invokes (0 to disable).
+ */
+#define DEFAULT_WARMUP_ITERATIONS (0)
+
+/**
+ * @brief Default flag to open the framework in background thread.
+ */
+#define DEFAULT_PRELOAD (FALSE)
+
+/**
+ * @brief Default flag to load new model in background thread.
+ */
+#define DEFAULT_HOT_SWAP (FALSE)
+
+/**
+ * @brief Default flag to validate new model before swapping.
+ */
+#define DEFAULT_HOT_SWAP_VALIDATE (TRUE)
+
+/**
+ * @brief Default scheduling priority of the threads invoking the model (unchanged).
+ */
+#define DEFAULT_SCHED_PRIORITY (0)
+
+/**
+ * @brief Description of the invokes whose latency is recorded (see gst_tensor_filter_need_profiling()).
+ */
+#define GST_TF_LATENCY_RECORD_DESC \
+    "The latency is recorded if latency or throughput is enabled or the " \
+    "deadline is set. Otherwise, the first frame only is recorded."
+
+/**
+ * @brief A framework context in the pool of shared model.
+ */
+typedef struct
+{
+  void *data; /**< the private data of the framework context */
+  guint generation; /**< the generation of model (model files and input info) opened with */
+  guint refcount; /**< 1 while in the pool, and 1 for each output data allocated by the context and not freed yet (with the lock of shared model) */
+} GstTensorFilterSharedContext;
+
+/**
+ * @brief Shared model representation with a pool of framework contexts.
+ */
+struct _GstTensorFilterSharedModel
+{
+  gchar *key; /**< the key of shared model (shared-tensor-filter-key) */
+  const GstTensorFilterFramework *fw; /**< the framework of shared model */
+  guint refcount; /**< number of tensor-filters sharing the model */
+
+  GMutex lock; /**< lock for the pool */
+  GCond cond; /**< condition to wait for an idle context */
+  gboolean opening; /**< the first context is being opened */
+  gboolean failed; /**< failed to open the first context */
+  GQueue idle; /**< idle contexts in the pool */
+  guint num_contexts; /**< number of opened (and opening) contexts */
+  guint pool_size; /**< max number of contexts (the sum of shared-pool-size of the tensor-filters sharing the model) */
+  GHashTable *outputs; /**< output data allocated in invoke (allocate_in_invoke) and the context allocated it */
+
+  guint generation; /**< increased when a context is updated, the contexts of old generation are closed */
+  gchar **model_files; /**< the model files to open a new context */
+  gboolean input_configured; /**< the input info is set to the contexts */
+  GstTensorsInfo input_info; /**< the input info to set to a new context */
+
+  guint64 num_invokes; /**< number of invokes */
+  guint64 num_contentions; /**< number of invokes waited for an idle context */
+  gint64 total_wait_time; /**< accumulated time waited for an idle context (usec) */
 };
 
+/**
+ * @brief Table of the shared models (key: shared-tensor-filter-key).
+ */
+static GHashTable *shared_models = NULL;
+G_LOCK_DEFINE_STATIC (shared_models);
+
+/**
+ * @brief Data structure for the model file mapped and shared in the process.
+ */
+typedef struct
+{
+  gchar *key; /**< the key of the mapping (path, mtime and size) */
+  gchar *path; /**< the path of the model file */
+  GMappedFile *file; /**< the read-only mapping of the model file */
+  const void *data; /**< the mapped data */
+  gsize size; /**< the size of the mapped data */
+  guint refcount; /**< the number of references */
+} GstTensorFilterModelFile;
+
+/**
+ * @brief Tables of the mapped model files (key: path-mtime-size, and the mapped data).
+ */
+static GHashTable *model_files = NULL;
+static GHashTable *model_files_data = NULL;
+static guint64 model_files_hits = 0;
+static guint64 model_files_misses = 0;
+G_LOCK_DEFINE_STATIC (model_files);
+
 /**
  * @brief Initialize the tensors layout.
  */
@@ -564,6 +710,7 @@ gst_tensor_filter_framework_info_init (GstTensorFilterFrameworkInfo * info)
   info->accl_auto = -1;
   info->accl_default = -1;
   info->statistics = NULL;
+  info->mem_align = 0;
 }
 
 /**
@@ -577,7 +724,120 @@ gst_tensor_filter_statistics_init (GstTensorFilterStatistics * stat)
   stat->old_total_invoke_num = 0;
   stat->old_total_invoke_latency = 0;
   stat->latest_invoke_time = 0;
-  stat->recent_latencies = g_queue_new ();
+  stat->recent_num = 0;
+  stat->recent_idx = 0;
+  gst_tensor_filter_histogram_reset (&stat->latency_hist);
+  stat->latest_report_time = 0;
+  stat->pool_hits = 0;
+  stat->cache_hits = 0;
+  stat->cache_misses = 0;
+  stat->deadline_dropped = 0;
+  stat->warmup_time = 0;
+  stat->first_frame_latency = -1;
+  stat->pool_misses = 0;
+}
+
+/**
+ * @brief Get the bucket index of the value in the histogram.
+ */
+static guint
+gst_tensor_filter_histogram_get_bucket (gint64 value)
+{
+  guint bits, shift;
+
+  if (value < GST_TF_HIST_SUB_BUCKETS)
+    return (value > 0) ? (guint) value : 0U;
+
+  if (value >= ((gint64) 1 << GST_TF_HIST_MAX_BITS))
+    value = ((gint64) 1 << GST_TF_HIST_MAX_BITS) - 1;
+
+  /* the number of bits to represent the value (gulong may be 32bit) */
+  if (value >> 32)
+    bits = 32 + g_bit_storage ((gulong) (value >> 32));
+  else
+    bits = g_bit_storage ((gulong) value);
+
+  /* linear buckets in the range [2^(bits-1), 2^bits) */
+  shift = bits - GST_TF_HIST_SUB_BITS - 1;
+  return (bits - GST_TF_HIST_SUB_BITS) * GST_TF_HIST_SUB_BUCKETS +
+      (guint) ((value >> shift) - GST_TF_HIST_SUB_BUCKETS);
+}
+
+/**
+ * @brief Get the upper bound of the values in the bucket.
+ */
+static gint64
+gst_tensor_filter_histogram_get_upper_bound (guint bucket)
+{
+  guint group, sub;
+
+  if (bucket < GST_TF_HIST_SUB_BUCKETS)
+    return (gint64) bucket;
+
+  group = bucket / GST_TF_HIST_SUB_BUCKETS;
+  sub = bucket % GST_TF_HIST_SUB_BUCKETS;
+
+  return ((gint64) (GST_TF_HIST_SUB_BUCKETS + sub + 1) << (group - 1)) - 1;
+}
+
+/**
+ * @brief Reset the histogram of latencies.
+ */
+void
+gst_tensor_filter_histogram_reset (GstTensorFilterHistogram * hist)
+{
+  g_return_if_fail (hist != NULL);
+
+  memset (hist, 0, sizeof (GstTensorFilterHistogram));
+}
+
+/**
+ * @brief Record the latency (usec) in the histogram.
+ */
+void
+gst_tensor_filter_histogram_record (GstTensorFilterHistogram * hist,
+    gint64 value)
+{
+  g_return_if_fail (hist != NULL);
+
+  hist->counts[gst_tensor_filter_histogram_get_bucket (value)]++;
+  hist->total++;
+
+  if (value > hist->max)
+    hist->max = value;
+}
+
+/**
+ * @brief Get the percentile of the recorded latencies.
+ */
+gint64
+gst_tensor_filter_histogram_get_percentile (const GstTensorFilterHistogram *
+    hist, gdouble percentile)
+{
+  guint64 rank, count = 0;
+  guint i;
+
+  g_return_val_if_fail (hist != NULL, -1);
+
+  if (hist->total == 0)
+    return -1;
+
+  /* the rank of nearest value, rounded up */
+  rank = (guint64) (hist->total * CLAMP (percentile, 0.0, 100.0) / 100.0);
+  if (rank < hist->total &&
+      (gdouble) rank < hist->total * CLAMP (percentile, 0.0, 100.0) / 100.0)
+    rank++;
+  if (rank == 0)
+    rank = 1;
+
+  for (i = 0; i < GST_TF_HIST_NUM_BUCKETS; i++) {
+    count += hist->counts[i];
+
+    if (count >= rank)
+      return MIN (gst_tensor_filter_histogram_get_upper_bound (i), hist->max);
+  }
+
+  return hist->max;
 }
 
 /**
@@ -727,6 +987,180 @@ nnstreamer_filter_find (const char *name)
   return fw;
 }
 
+/**
+ * @brief Map the model file read-only and share the mapping in the process.
+ * @param[in] path The path of the model file.
+ * @param[out] size The size of the mapped data.
+ * @return The mapped data, NULL if the file cannot be mapped. Caller should call nnstreamer_filter_model_file_unref() to release it.
+ * @note The mapping is shared with the key of the path, the file (device and inode), the size and the modified time in nanoseconds, so the updated or replaced file is mapped again.
+ */
+const void *
+nnstreamer_filter_model_file_ref (const char *path, size_t *size)
+{
+  GstTensorFilterModelFile *mfile;
+  GStatBuf st;
+  GMappedFile *file;
+  GError *err = NULL;
+  gchar *key;
+  const void *data = NULL;
+  gint64 mtime_nsec;
+
+  g_return_val_if_fail (path != NULL, NULL);
+  g_return_val_if_fail (size != NULL, NULL);
+
+  if (g_stat (path, &st) != 0 || !S_ISREG (st.st_mode) || st.st_size <= 0) {
+    nns_logw ("Cannot map the model file %s, it is not a regular file.", path);
+    return NULL;
+  }
+
+  /* the file rewritten within a second has the same st_mtime */
+#if defined (__APPLE__)
+  mtime_nsec = (gint64) st.st_mtimespec.tv_nsec;
+#elif defined (G_OS_UNIX)
+  mtime_nsec = (gint64) st.st_mtim.tv_nsec;
+#else
+  mtime_nsec = 0;
+#endif
+
+  key = g_strdup_printf ("%s:%" G_GUINT64_FORMAT ":%" G_GUINT64_FORMAT
+      ":%" G_GINT64_FORMAT ".%09" G_GINT64_FORMAT ":%" G_GINT64_FORMAT, path,
+      (guint64) st.st_dev, (guint64) st.st_ino, (gint64) st.st_mtime,
+      mtime_nsec, (gint64) st.st_size);
+
+  G_LOCK (model_files);
+
+  if (!model_files) {
+    model_files = g_hash_table_new (g_str_hash, g_str_equal);
+    model_files_data = g_hash_table_new (g_direct_hash, g_direct_equal);
+  }
+
+  mfile = g_hash_table_lookup (model_files, key);
+  if (mfile) {
+    mfile->refcount++;
+    model_files_hits++;
+
+    *size = mfile->size;
+    data = mfile->data;
+    goto done;
+  }
+
+  file = g_mapped_file_new (path, FALSE, &err);
+  if (!file) {
+    nns_logw ("Cannot map the model file %s: %s", path,
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+    goto done;
+  }
+
+  if (g_mapped_file_get_length (file) == 0) {
+    nns_logw ("Cannot map the model file %s, it is empty.", path);
+    g_mapped_file_unref (file);
+    goto done;
+  }
+
+  mfile = g_new0 (GstTensorFilterModelFile, 1);
+  mfile->key = key;
+  mfile->path = g_strdup (path);
+  mfile->file = file;
+  mfile->data = g_mapped_file_get_contents (file);
+  mfile->size = g_mapped_file_get_length (file);
+  mfile->refcount = 1;
+  key = NULL;
+
+  g_hash_table_insert (model_files, mfile->key, mfile);
+  g_hash_table_insert (model_files_data, (gpointer) mfile->data, mfile);
+  model_files_misses++;
+
+  *size = mfile->size;
+  data = mfile->data;
+
+done:
+  G_UNLOCK (model_files);
+  g_free (key);
+  return data;
+}
+
+/**
+ * @brief Release the model file mapped with nnstreamer_filter_model_file_ref().
+ * @param[in] data The mapped data. The file is unmapped when the last reference is released.
+ */
+void
+nnstreamer_filter_model_file_unref (const void *data)
+{
+  GstTensorFilterModelFile *mfile = NULL;
+
+  if (data == NULL)
+    return;
+
+  G_LOCK (model_files);
+
+  if (model_files_data)
+    mfile = g_hash_table_lookup (model_files_data, data);
+
+  if (mfile == NULL) {
+    nns_logw ("Cannot find the mapped model file to be released.");
+  } else if (--mfile->refcount == 0) {
+    g_hash_table_remove (model_files, mfile->key);
+    g_hash_table_remove (model_files_data, mfile->data);
+  } else {
+    mfile = NULL;
+  }
+
+  G_UNLOCK (model_files);
+
+  if (mfile) {
+    g_mapped_file_unref (mfile->file);
+    g_free (mfile->key);
+    g_free (mfile->path);
+    g_free (mfile);
+  }
+}
+
+/**
+ * @brief Get the statistics of the mapped model files.
+ * @return Newly allocated string. Caller should free the returned string.
+ * @note The first line is the summary (files, mapped bytes, hits and misses), and each line after is the path, size and references of the mapped file.
+ */
+char *
+nnstreamer_filter_model_file_stats (void)
+{
+  GString *stats;
+  GHashTableIter iter;
+  gpointer value;
+  gsize mapped = 0;
+  guint num_files = 0;
+
+  stats = g_string_new (NULL);
+
+  G_LOCK (model_files);
+
+  if (model_files) {
+    num_files = g_hash_table_size (model_files);
+
+    g_hash_table_iter_init (&iter, model_files);
+    while (g_hash_table_iter_next (&iter, NULL, &value))
+      mapped += ((GstTensorFilterModelFile *) value)->size;
+  }
+
+  g_string_append_printf (stats, "files=%u,mapped=%" G_GSIZE_FORMAT
+      ",hits=%" G_GUINT64_FORMAT ",misses=%" G_GUINT64_FORMAT, num_files,
+      mapped, model_files_hits, model_files_misses);
+
+  if (model_files) {
+    g_hash_table_iter_init (&iter, model_files);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      GstTensorFilterModelFile *mfile = (GstTensorFilterModelFile *) value;
+
+      g_string_append_printf (stats, "\n%s:size=%" G_GSIZE_FORMAT ",refs=%u",
+          mfile->path, mfile->size, mfile->refcount);
+    }
+  }
+
+  G_UNLOCK (model_files);
+
+  return g_string_free (stats, FALSE);
+}
+
 /**
  * @brief Parse the string of model
  * @param[out] prop Struct containing the properties of the object
@@ -763,11 +1197,16 @@ gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv)
   if (GST_TF_FW_V0 (priv->fw)) {
     allocate_in_invoke = priv->fw->allocate_in_invoke;
     if (allocate_in_invoke == TRUE && priv->fw->allocateInInvoke) {
-      if (priv->fw->allocateInInvoke (&priv->privateData) == 0) {
+      gpointer handle;
+      void **data = gst_tensor_filter_common_get_context (priv, &handle);
+
+      if (priv->fw->allocateInInvoke (data) == 0) {
         allocate_in_invoke = TRUE;
       } else {
         allocate_in_invoke = FALSE;
       }
+
+      gst_tensor_filter_common_put_context (priv, handle);
     }
   } else if (GST_TF_FW_V1 (priv->fw)) {
     allocate_in_invoke = priv->info.allocate_in_invoke;
@@ -786,15 +1225,25 @@ gst_tensor_filter_destroy_notify_util (GstTensorFilterPrivate * priv,
     void *data)
 {
   GstTensorFilterFrameworkEventData event_data;
+  gpointer handle;
+  void **context;
+
+  /* release the data with the context of shared model allocated it */
+  if (priv->shared_model && _gtfc_shared_model_destroy_notify (priv, data))
+    return;
 
   if (GST_TF_FW_V0 (priv->fw) && priv->fw->destroyNotify) {
-    priv->fw->destroyNotify (&priv->privateData, data);
+    context = gst_tensor_filter_common_get_context (priv, &handle);
+    priv->fw->destroyNotify (context, data);
+    gst_tensor_filter_common_put_context (priv, handle);
   } else if (GST_TF_FW_V1 (priv->fw)) {
     event_data.data = data;
-    if (priv->fw->eventHandler (priv->fw, &priv->prop, priv->privateData,
+    context = gst_tensor_filter_common_get_context (priv, &handle);
+    if (priv->fw->eventHandler (priv->fw, &priv->prop, *context,
             DESTROY_NOTIFY, &event_data) == -ENOENT) {
       g_free (data);
     }
+    gst_tensor_filter_common_put_context (priv, handle);
   } else {
     g_free (data);
   }
@@ -975,6 +1424,235 @@ gst_tensor_filter_install_properties (GObjectClass * gobject_class)
           "to declare and share such instances. "
           "If it is NULL, it means the model representations is not shared.",
           NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHARED_POOL_SIZE,
+      g_param_spec_uint ("shared-pool-size", "Shared pool size",
+          "The number of framework contexts this tensor-filter adds to the "
+          "pool of the shared model (shared-tensor-filter-key). Each invoke "
+          "checks out an idle context, so that the tensor-filters sharing "
+          "the model invoke concurrently. The pool size is the sum of the "
+          "tensor-filters sharing the model (by default, one context for each "
+          "tensor-filter) and the pool is grown on demand.",
+          1, G_MAXUINT, DEFAULT_SHARED_POOL_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHARED_POOL_STATS,
+      g_param_spec_string ("shared-pool-stats", "Shared pool statistics",
+          "The statistics of the shared model pool: the number of contexts, "
+          "invokes, invokes waited for an idle context and the average "
+          "waiting time in microseconds (e.g., contexts=2,invokes=100,"
+          "contentions=10,avg-wait=120). Empty if the model is not shared "
+          "or pooled (context-pool-size of single-shot).",
+          "", G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_SIZE,
+      g_param_spec_uint ("output-pool-size", "Output buffer pool size",
+          "The max number of buffers in the buffer pool of each output tensor. "
+          "The output memory is recycled when downstream releases it. "
+          "If the pool is exhausted, the memory is allocated for each frame. "
+          "Set 0 to disable the buffer pool.",
+          0, G_MAXUINT, DEFAULT_OUTPUT_POOL_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_MIN_BUFFERS,
+      g_param_spec_uint ("output-pool-min-buffers",
+          "Output buffer pool min buffers",
+          "The number of buffers to be preallocated in the buffer pool of each output tensor.",
+          0, G_MAXUINT, DEFAULT_OUTPUT_POOL_MIN_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_HITS,
+      g_param_spec_uint64 ("output-pool-hits", "Output buffer pool hits",
+          "The number of output memories recycled from the buffer pool",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_POOL_MISSES,
+      g_param_spec_uint64 ("output-pool-misses", "Output buffer pool misses",
+          "The number of output memories newly allocated because the buffer pool is disabled or exhausted",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INPUT_ALIGNMENT,
+      g_param_spec_uint ("input-alignment", "Input memory alignment",
+          "The memory alignment in bytes (power of 2) of the input tensor. "
+          "tensor_filter proposes the alignment and the buffer pool to upstream "
+          "with the allocation query, so that the framework directly uses the "
+          "input without realigning it. The alignment is applied to each "
+          "memory of multi tensors, and the buffer pool is proposed for the "
+          "static single tensor only. With flexible tensors, the data after "
+          "the header is not guaranteed to be aligned. If the framework "
+          "requires a larger alignment (e.g., 64 bytes of tensorflow-lite), "
+          "it is proposed instead. "
+          "Set 0 not to propose the alignment other than the framework's.",
+          0, G_MAXUINT, DEFAULT_INPUT_ALIGNMENT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_CACHE,
+      g_param_spec_boolean ("invoke-cache", "Invoke cache",
+          "Skip the invoke if the input is same as the one previously "
+          "invoked. The cached output is found with the hash of the input "
+          "tensors and the input is compared byte by byte when the hash is "
+          "same. The cache holds the input and output memories without "
+          "copying them, and the cached output is shared with downstream "
+          "(read-only). This works with synchronous invoke only, it cannot "
+          "be enabled with asynchronous invoke, micro-batching, in-place "
+          "invoke or the output ring of the subplugin.",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_CACHE_SIZE,
+      g_param_spec_uint64 ("invoke-cache-size", "Invoke cache size",
+          "The max size of the cached inputs and outputs in bytes. "
+          "The least recently used output is evicted if exceeded.",
+          0, G_MAXUINT64, DEFAULT_INVOKE_CACHE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_CACHE_HITS,
+      g_param_spec_uint64 ("invoke-cache-hits", "Invoke cache hits",
+          "The number of frames whose output is found in the invoke cache",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INVOKE_CACHE_MISSES,
+      g_param_spec_uint64 ("invoke-cache-misses", "Invoke cache misses",
+          "The number of frames invoked because the output is not in the invoke cache",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DEADLINE,
+      g_param_spec_uint ("deadline", "Deadline",
+          "The budget in milliseconds to complete the invoke of each frame. "
+          "The deadline of a frame is its timestamp (running-time on the "
+          "pipeline clock) plus this budget. The frame is dropped before "
+          "invoking and a qos event is sent to upstream elements if it would "
+          "finish late, predicted with recent invoke latencies. "
+          "This does not enable the property 'qos' of the base transform, "
+          "which drops the frames with the qos events from downstream. "
+          "Set 0 to disable the deadline mode.",
+          0, G_MAXUINT, DEFAULT_DEADLINE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DEADLINE_DROPPED,
+      g_param_spec_uint64 ("deadline-dropped", "Deadline dropped",
+          "The number of frames dropped because they would miss the deadline",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP_ITERATIONS,
+      g_param_spec_uint ("warmup-iterations", "Warm-up iterations",
+          "The number of invokes with zero-filled inputs after opening the "
+          "framework (READY to PAUSED), so that the memory allocations and "
+          "JIT compilations of the framework are done before the first frame. "
+          "The warm-up is skipped if the input and output tensors of the "
+          "model are not fixed. Set 0 to disable the warm-up.",
+          0, G_MAXUINT, DEFAULT_WARMUP_ITERATIONS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_PRELOAD,
+      g_param_spec_boolean ("preload", "Preload",
+          "Open the framework in background thread from NULL to READY state, "
+          "so that loading the model overlaps with the state change of the "
+          "other elements. The warm-up runs from READY to PAUSED state.",
+          DEFAULT_PRELOAD, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP_TIME,
+      g_param_spec_int64 ("warmup-time", "Warm-up time",
+          "The time in microseconds to run the warm-up invokes",
+          0, G_MAXINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_FIRST_FRAME_LATENCY,
+      g_param_spec_int64 ("first-frame-latency", "First frame latency",
+          "The invoke latency in microseconds of the first frame "
+          "(-1 if no frame is invoked)",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_HOT_SWAP,
+      g_param_spec_boolean ("hot-swap", "Hot swap",
+          "If the model is updated while the framework is opened and "
+          "is-updatable is set, load new "
+          "model with another framework context in background thread while "
+          "the running model keeps invoking the frames, then swap them at a "
+          "frame boundary. The property 'model' is updated when swapping. "
+          "The element message 'nnstreamer-model-swap' is posted with the "
+          "load and swap time. The model is reloaded synchronously if the "
+          "model is shared, invoked in parallel or micro-batches, or the "
+          "subplugin allocates the output buffers.",
+          DEFAULT_HOT_SWAP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_HOT_SWAP_VALIDATE,
+      g_param_spec_boolean ("hot-swap-validate", "Hot swap validate",
+          "Validate new model with a warm-up invoke before swapping, "
+          "the running model is kept if it fails (see hot-swap).",
+          DEFAULT_HOT_SWAP_VALIDATE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CPU_AFFINITY,
+      g_param_spec_string ("cpu-affinity", "CPU affinity",
+          "The list of CPU cores to run the threads invoking the model, "
+          "e.g., '0-3,8'. The streaming thread and the workers are pinned "
+          "once and restored when the element stops. The threads created by "
+          "the framework while opening it inherit the affinity, and the "
+          "number of cores is passed to the framework (num_cpus), which may "
+          "use it as the number of threads unless the custom option of the "
+          "framework (e.g., NumThreads) is given. The threads of single-shot "
+          "callers are not changed. "
+          "Set empty string not to change the affinity (Linux only).",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SCHED_PRIORITY,
+      g_param_spec_int ("sched-priority", "Scheduling priority",
+          "The scheduling priority of the threads invoking the model. "
+          "Positive value is the real-time priority with SCHED_FIFO (1~99), "
+          "negative value is the nice value (-20~-1) with SCHED_OTHER. "
+          "This may require the privilege (CAP_SYS_NICE). The old priority "
+          "is restored when the element stops (see cpu-affinity). "
+          "Set 0 not to change the priority (Linux only).",
+          -20, 99, DEFAULT_SCHED_PRIORITY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_FRAMEWORK_STATS,
+      g_param_spec_string ("framework-stats", "Framework statistics",
+          "The statistics reported by the subplugin, e.g., the invokes and "
+          "the average latency of each interpreter of tensorflow-lite. "
+          "Empty if the framework is not opened or does not report them "
+          "(API version 1 or higher with the event GET_STATISTICS).",
+          "", G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_INFLIGHT,
+      g_param_spec_uint ("max-inflight", "Max frames in flight",
+          "The max number of frames in flight if the subplugin supports "
+          "asynchronous invoke (API version 2). The output is pushed in the "
+          "order of the input. Set 0 to invoke synchronously.",
+          0, G_MAXUINT, DEFAULT_MAX_INFLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The number of incoming frames stacked along the outermost "
+          "dimension and invoked at once. The batched input info is set to "
+          "the model when negotiating the caps, and it cannot be changed "
+          "after the caps are negotiated. Set 1 to invoke each frame.",
+          1, G_MAXUINT, DEFAULT_BATCH_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_TIMEOUT,
+      g_param_spec_uint ("batch-timeout", "Batch timeout",
+          "The timeout (in milliseconds) to invoke the incomplete batch "
+          "after receiving its first frame. Set 0 to wait until the batch "
+          "is filled or the stream is ended or changed (EOS, caps or segment).",
+          0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUM_INSTANCES,
+      g_param_spec_uint ("num-instances", "Number of instances",
+          "The number of instances of the framework. If it is larger than 1, "
+          "the frames are dispatched to the instances in round-robin and "
+          "the output is pushed in the order of the input. "
+          "The subplugin allocating the output in invoke uses one instance.",
+          1, G_MAXUINT, DEFAULT_NUM_INSTANCES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_INSTANCE_UTILIZATION,
+      g_param_spec_string ("instance-utilization", "Instance utilization",
+          "The busy time ratio (%) of each instance since the instances are "
+          "opened, separated with commas. Empty if num-instances is 1.", "",
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P50,
+      g_param_spec_int64 ("latency-p50", "Latency p50",
+          "The 50th percentile of invoke latency in microseconds since the "
+          "last reset, -1 if no latency is recorded. " GST_TF_LATENCY_RECORD_DESC,
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P90,
+      g_param_spec_int64 ("latency-p90", "Latency p90",
+          "The 90th percentile of invoke latency in microseconds since the "
+          "last reset, -1 if no latency is recorded. " GST_TF_LATENCY_RECORD_DESC,
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P99,
+      g_param_spec_int64 ("latency-p99", "Latency p99",
+          "The 99th percentile of invoke latency in microseconds since the "
+          "last reset, -1 if no latency is recorded. " GST_TF_LATENCY_RECORD_DESC,
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_MAX,
+      g_param_spec_int64 ("latency-max", "Latency max",
+          "The max invoke latency in microseconds since the last reset, "
+          "-1 if no latency is recorded. " GST_TF_LATENCY_RECORD_DESC,
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class,
+      PROP_LATENCY_REPORT_INTERVAL,
+      g_param_spec_uint ("latency-report-interval", "Latency report interval",
+          "The interval in milliseconds to post the latency percentiles as "
+          "an element message (nnstreamer-latency) on the bus, "
+          "while the latency or throughput profiling is on. 0 to disable.",
+          0, G_MAXUINT, DEFAULT_LATENCY_REPORT_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -1003,6 +1681,43 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
   gst_tensors_config_init (&priv->out_config);
   priv->prop.shared_tensor_filter_key = NULL;
 
+  /* init output buffer pool */
+  priv->pool_size = DEFAULT_OUTPUT_POOL_SIZE;
+  priv->pool_min_buffers = DEFAULT_OUTPUT_POOL_MIN_BUFFERS;
+  memset (priv->out_pool, 0, sizeof (priv->out_pool));
+  memset (priv->batch_out_pool, 0, sizeof (priv->batch_out_pool));
+  priv->input_alignment = DEFAULT_INPUT_ALIGNMENT;
+  priv->max_inflight = DEFAULT_MAX_INFLIGHT;
+  priv->batch_size = DEFAULT_BATCH_SIZE;
+  priv->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+  priv->batch_configured = 0;
+  priv->batch_invoke = FALSE;
+  gst_tensors_info_init (&priv->batch_in_info);
+  gst_tensors_info_init (&priv->batch_out_info);
+  priv->num_instances = DEFAULT_NUM_INSTANCES;
+  priv->instances = NULL;
+  priv->instances_len = 0;
+  g_mutex_init (&priv->instances_lock);
+  priv->instances_start_time = 0;
+  priv->latency_report_interval = DEFAULT_LATENCY_REPORT_INTERVAL;
+  priv->deadline = DEFAULT_DEADLINE;
+  priv->warmup_iterations = DEFAULT_WARMUP_ITERATIONS;
+  priv->preload = DEFAULT_PRELOAD;
+  priv->hot_swap = DEFAULT_HOT_SWAP;
+  priv->hot_swap_validate = DEFAULT_HOT_SWAP_VALIDATE;
+  priv->cpu_affinity = NULL;
+  priv->sched_priority = DEFAULT_SCHED_PRIORITY;
+  priv->policy_serial = 0;
+  g_mutex_init (&priv->policy_lock);
+  g_mutex_init (&priv->stat_lock);
+  priv->policy_threads = NULL;
+  priv->invoke_cache = FALSE;
+  priv->invoke_cache_size = DEFAULT_INVOKE_CACHE_SIZE;
+  priv->shared_pool_size = DEFAULT_SHARED_POOL_SIZE;
+  priv->shared_pool_share = 0;
+  priv->shared_model = NULL;
+  priv->private_pool_size = 0;
+
   /* init qos properties */
   priv->prev_ts = GST_CLOCK_TIME_NONE;
   priv->throttling_delay = 0;
@@ -1033,17 +1748,22 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   gst_tensors_config_free (&priv->in_config);
   gst_tensors_config_free (&priv->out_config);
 
+  gst_tensors_info_free (&priv->batch_in_info);
+  gst_tensors_info_free (&priv->batch_out_info);
+
   g_list_free (priv->combi.in_combi);
   g_list_free (priv->combi.out_combi_i);
   g_list_free (priv->combi.out_combi_o);
 
-  if (priv->stat.recent_latencies != NULL) {
-    GQueue *queue = priv->stat.recent_latencies;
-    gint64 *latency;
-    while ((latency = g_queue_pop_tail (queue)) != NULL)
-      g_free (latency);
-    g_queue_free (queue);
-  }
+  gst_tensor_filter_common_restore_thread_policy (priv, FALSE);
+  if (priv->policy_threads)
+    g_array_free (priv->policy_threads, TRUE);
+  if (priv->cpu_affinity)
+    g_array_free (priv->cpu_affinity, TRUE);
+
+  g_mutex_clear (&priv->policy_lock);
+  g_mutex_clear (&priv->stat_lock);
+  g_mutex_clear (&priv->instances_lock);
 }
 
 /**
@@ -1071,8 +1791,12 @@ gst_tensor_filter_parse_accelerator (GstTensorFilterPrivate * priv,
 
   /** Get h/w accelerators supported by framework */
   if (info->name == NULL) {
-    status = priv->fw->getFrameworkInfo (priv->fw, prop, priv->privateData,
-        info);
+    gpointer handle;
+    void **data = gst_tensor_filter_common_get_context (priv, &handle);
+
+    status = priv->fw->getFrameworkInfo (priv->fw, prop, *data, info);
+    gst_tensor_filter_common_put_context (priv, handle);
+
     if (status != 0 || info->hw_list == NULL) {
       ml_logw ("Unable to fetch accelerators supported by the framework.");
       return;
@@ -1392,9 +2116,12 @@ _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
    * has responsibility for the verification of the path regardless of priv->fw->verify_model_path.
    */
   if (prop->fw_opened) {
+    gpointer handle;
+    void **context = gst_tensor_filter_common_get_context (priv, &handle);
+
     if (GST_TF_FW_V0 (priv->fw) && priv->is_updatable) {
       if (priv->fw->reloadModel &&
-          priv->fw->reloadModel (prop, &priv->privateData) != 0) {
+          priv->fw->reloadModel (prop, context) != 0) {
         status = -1;
       }
     } else if (GST_TF_FW_V1 (priv->fw) && priv->is_updatable) {
@@ -1402,12 +2129,18 @@ _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
       data.model_files = prop->model_files;
       data.num_models = prop->num_models;
       /** original prop is sent and not the updated prop */
-      if (priv->fw->eventHandler (priv->fw, &_prop, priv->privateData,
+      if (priv->fw->eventHandler (priv->fw, &_prop, *context,
               RELOAD_MODEL, &data) != 0) {
         status = -1;
       }
     }
 
+    /* the other contexts in the pool are opened again with new model */
+    if (status == 0)
+      gst_tensor_filter_common_update_context (priv, handle, NULL,
+          prop->model_files);
+    gst_tensor_filter_common_put_context (priv, handle);
+
     if (status == 0) {
       g_strfreev_const (_prop.model_files);
     } else {
@@ -1573,14 +2306,19 @@ _gtfc_setprop_CUSTOM (GstTensorFilterPrivate * priv,
           ("Cannot change custom-prop once the element/pipeline is configured.");
     } else if (GST_TF_FW_V1 (priv->fw)) {
       GstTensorFilterFrameworkEventData data;
+      gpointer handle;
+      void **context;
 
       data.custom_properties = g_value_dup_string (value);
+      context = gst_tensor_filter_common_get_context (priv, &handle);
       status = priv->fw->eventHandler
-          (priv->fw, prop, priv->privateData, CUSTOM_PROP, &data);
+          (priv->fw, prop, *context, CUSTOM_PROP, &data);
       if (status == 0) {
         g_free_const (prop->custom_properties);
         prop->custom_properties = g_value_dup_string (value);
+        gst_tensor_filter_common_update_context (priv, handle, NULL, NULL);
       }
+      gst_tensor_filter_common_put_context (priv, handle);
 
       g_free_const (data.custom_properties);
     }
@@ -1604,14 +2342,21 @@ _gtfc_setprop_ACCELERATOR (GstTensorFilterPrivate * priv,
     } else if (GST_TF_FW_V1 (priv->fw)) {
       GstTensorFilterProperties _prop;
       GstTensorFilterFrameworkEventData data;
+      gpointer handle;
+      void **context;
       memcpy (&_prop, prop, sizeof (GstTensorFilterProperties));
 
       gst_tensor_filter_parse_accelerator (priv, prop, accelerators);
       data.num_hw = prop->num_hw;
       data.hw_list = prop->hw_list;
 
+      context = gst_tensor_filter_common_get_context (priv, &handle);
       status = priv->fw->eventHandler
-          (priv->fw, &_prop, priv->privateData, SET_ACCELERATOR, &data);
+          (priv->fw, &_prop, *context, SET_ACCELERATOR, &data);
+      if (status == 0)
+        gst_tensor_filter_common_update_context (priv, handle, NULL, NULL);
+      gst_tensor_filter_common_put_context (priv, handle);
+
       if (status == 0) {
         g_free (_prop.hw_list);
       } else {
@@ -1646,12 +2391,19 @@ _gtfc_setprop_IS_UPDATABLE (GstTensorFilterPrivate * priv,
     if (GST_TF_FW_V0 (priv->fw) && priv->fw->reloadModel == NULL) {
       priv->is_updatable = FALSE;
       return 0;
-    } else if (GST_TF_FW_V1 (priv->fw) &&
-        priv->fw->eventHandler (priv->fw, prop, priv->privateData, RELOAD_MODEL,
-            NULL)
-        == -ENOENT) {
-      priv->is_updatable = FALSE;
-      return 0;
+    } else if (GST_TF_FW_V1 (priv->fw)) {
+      gpointer handle;
+      void **context = gst_tensor_filter_common_get_context (priv, &handle);
+      gint status;
+
+      status = priv->fw->eventHandler (priv->fw, prop, *context, RELOAD_MODEL,
+          NULL);
+      gst_tensor_filter_common_put_context (priv, handle);
+
+      if (status == -ENOENT) {
+        priv->is_updatable = FALSE;
+        return 0;
+      }
     }
   }
 
@@ -1659,6 +2411,73 @@ _gtfc_setprop_IS_UPDATABLE (GstTensorFilterPrivate * priv,
   return 0;
 }
 
+/** @brief Handle "PROP_CPU_AFFINITY" for set-property */
+static gint
+_gtfc_setprop_CPU_AFFINITY (GstTensorFilterPrivate * priv,
+    GstTensorFilterProperties * prop, const GValue * value)
+{
+  const gchar *str = g_value_get_string (value);
+  GArray *cpus = NULL;
+  gchar **items = NULL;
+  guint i, c, first, last;
+
+  if (str && str[0] != '\0') {
+    cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+    items = g_strsplit (str, ",", -1);
+
+    for (i = 0; items[i]; i++) {
+      gchar *item = g_strstrip (items[i]);
+      gchar *end = NULL;
+
+      if (item[0] == '\0')
+        continue;
+
+      /* a core or a range of cores (e.g., 4-7) */
+      first = last = (guint) g_ascii_strtoull (item, &end, 10);
+      if (end == item)
+        goto error;
+
+      if (*end == '-') {
+        gchar *range = end + 1;
+
+        last = (guint) g_ascii_strtoull (range, &end, 10);
+        if (end == range || last < first)
+          goto error;
+      }
+
+      if (*end != '\0' || last >= CPU_SETSIZE)
+        goto error;
+
+      for (c = first; c <= last; c++)
+        g_array_append_val (cpus, c);
+    }
+
+    g_strfreev (items);
+
+    if (cpus->len == 0) {
+      g_array_free (cpus, TRUE);
+      cpus = NULL;
+    }
+  }
+
+  /* the threads invoking the model read the cores */
+  g_mutex_lock (&priv->policy_lock);
+  if (priv->cpu_affinity)
+    g_array_free (priv->cpu_affinity, TRUE);
+  priv->cpu_affinity = cpus;
+  prop->num_cpus = cpus ? (int) cpus->len : 0;
+  g_atomic_int_inc (&priv->policy_serial);
+  g_mutex_unlock (&priv->policy_lock);
+
+  return 0;
+
+error:
+  nns_loge ("Invalid cpu-affinity '%s', e.g., '0-3,8'.", str);
+  g_strfreev (items);
+  g_array_free (cpus, TRUE);
+  return -EINVAL;
+}
+
 /** @brief Handle "PROP_INPUTLAYOUT" and "PROP_OUTPUTLAYOUT" for set-property */
 static gint
 _gtfc_setprop_LAYOUT (GstTensorFilterPrivate * priv,
@@ -1703,6 +2522,8 @@ _gtfc_setprop_LAYOUT (GstTensorFilterPrivate * priv,
       ml_loge ("Cannot change layout once the element/pipeline is configured.");
     } else if (GST_TF_FW_V1 (priv->fw)) {
       GstTensorFilterFrameworkEventData data;
+      gpointer handle;
+      void **context;
 
       data.info = NULL;
       num_layouts = gst_tensors_parse_layouts_string (data.layout,
@@ -1713,13 +2534,17 @@ _gtfc_setprop_LAYOUT (GstTensorFilterPrivate * priv,
           ml_logw ("Invalid layout, given param does not fit.");
         }
 
+        context = gst_tensor_filter_common_get_context (priv, &handle);
+
         if (priv->fw->eventHandler
-            (priv->fw, prop, priv->privateData, evt, &data) == 0) {
+            (priv->fw, prop, *context, evt, &data) == 0) {
           memcpy (*layout, data.layout,
               sizeof (tensor_layout) * NNS_TENSOR_SIZE_LIMIT);
+          gst_tensor_filter_common_update_context (priv, handle, NULL, NULL);
         } else {
           ml_logw ("Unable to update layout.");
         }
+        gst_tensor_filter_common_put_context (priv, handle);
       }
     }
   }
@@ -1932,11 +2757,89 @@ gst_tensor_filter_common_set_property (GstTensorFilterPrivate * priv,
     case PROP_SHARED_TENSOR_FILTER_KEY:
       status = _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (prop, value);
       break;
-    default:
-      return FALSE;
-  }
+    case PROP_OUTPUT_POOL_SIZE:
+      priv->pool_size = g_value_get_uint (value);
+      break;
+    case PROP_OUTPUT_POOL_MIN_BUFFERS:
+      priv->pool_min_buffers = g_value_get_uint (value);
+      break;
+    case PROP_INPUT_ALIGNMENT:
+    {
+      guint align = g_value_get_uint (value);
 
-  /** Although no one return !0 at this point, let's enable error handling. */
+      if (align & (align - 1)) {
+        ml_logw ("The input alignment %u is not power of 2, ignore it.",
+            align);
+        break;
+      }
+
+      priv->input_alignment = align;
+      break;
+    }
+    case PROP_MAX_INFLIGHT:
+      priv->max_inflight = g_value_get_uint (value);
+      break;
+    case PROP_BATCH_SIZE:
+    {
+      guint batch_size = g_value_get_uint (value);
+
+      /* the batched input info is already set to the model */
+      if (priv->configured && batch_size != priv->batch_size) {
+        ml_logw ("Cannot change the batch size (%u) after the caps are "
+            "negotiated, ignore it.", batch_size);
+        break;
+      }
+
+      priv->batch_size = batch_size;
+      break;
+    }
+    case PROP_BATCH_TIMEOUT:
+      priv->batch_timeout = g_value_get_uint (value);
+      break;
+    case PROP_NUM_INSTANCES:
+      priv->num_instances = g_value_get_uint (value);
+      break;
+    case PROP_LATENCY_REPORT_INTERVAL:
+      priv->latency_report_interval = g_value_get_uint (value);
+      break;
+    case PROP_SHARED_POOL_SIZE:
+      priv->shared_pool_size = g_value_get_uint (value);
+      break;
+    case PROP_INVOKE_CACHE:
+      priv->invoke_cache = g_value_get_boolean (value);
+      break;
+    case PROP_INVOKE_CACHE_SIZE:
+      priv->invoke_cache_size = g_value_get_uint64 (value);
+      break;
+    case PROP_DEADLINE:
+      priv->deadline = g_value_get_uint (value);
+      break;
+    case PROP_WARMUP_ITERATIONS:
+      priv->warmup_iterations = g_value_get_uint (value);
+      break;
+    case PROP_PRELOAD:
+      priv->preload = g_value_get_boolean (value);
+      break;
+    case PROP_HOT_SWAP:
+      priv->hot_swap = g_value_get_boolean (value);
+      break;
+    case PROP_HOT_SWAP_VALIDATE:
+      priv->hot_swap_validate = g_value_get_boolean (value);
+      break;
+    case PROP_CPU_AFFINITY:
+      status = _gtfc_setprop_CPU_AFFINITY (priv, prop, value);
+      break;
+    case PROP_SCHED_PRIORITY:
+      g_mutex_lock (&priv->policy_lock);
+      priv->sched_priority = g_value_get_int (value);
+      g_atomic_int_inc (&priv->policy_serial);
+      g_mutex_unlock (&priv->policy_lock);
+      break;
+    default:
+      return FALSE;
+  }
+
+  /** Although no one return !0 at this point, let's enable error handling. */
   if (0 != status)
     return FALSE;
 
@@ -2133,6 +3036,187 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       else
         g_value_set_string (value, "");
       break;
+    case PROP_OUTPUT_POOL_SIZE:
+      g_value_set_uint (value, priv->pool_size);
+      break;
+    case PROP_OUTPUT_POOL_MIN_BUFFERS:
+      g_value_set_uint (value, priv->pool_min_buffers);
+      break;
+    case PROP_INPUT_ALIGNMENT:
+      g_value_set_uint (value, priv->input_alignment);
+      break;
+    case PROP_OUTPUT_POOL_HITS:
+      g_value_set_uint64 (value,
+          __atomic_load_n (&priv->stat.pool_hits, __ATOMIC_RELAXED));
+      break;
+    case PROP_OUTPUT_POOL_MISSES:
+      g_value_set_uint64 (value,
+          __atomic_load_n (&priv->stat.pool_misses, __ATOMIC_RELAXED));
+      break;
+    case PROP_MAX_INFLIGHT:
+      g_value_set_uint (value, priv->max_inflight);
+      break;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, priv->batch_size);
+      break;
+    case PROP_BATCH_TIMEOUT:
+      g_value_set_uint (value, priv->batch_timeout);
+      break;
+    case PROP_NUM_INSTANCES:
+      g_value_set_uint (value, priv->num_instances);
+      break;
+    case PROP_INSTANCE_UTILIZATION:
+    {
+      GString *utilization = g_string_new (NULL);
+      gint64 elapsed, latency;
+      guint i;
+
+      /* the workers may be stopped and the instances closed meanwhile */
+      g_mutex_lock (&priv->instances_lock);
+      elapsed = g_get_real_time () - priv->instances_start_time;
+
+      for (i = 0; i < priv->instances_len; i++) {
+        gdouble ratio = 0.0;
+
+        latency = __atomic_load_n (&priv->instances[i].total_invoke_latency,
+            __ATOMIC_RELAXED);
+        if (elapsed > 0)
+          ratio = 100.0 * latency / elapsed;
+
+        g_string_append_printf (utilization, "%s%.1f", (i > 0) ? "," : "",
+            ratio);
+      }
+      g_mutex_unlock (&priv->instances_lock);
+
+      g_value_take_string (value, g_string_free (utilization, FALSE));
+      break;
+    }
+    case PROP_LATENCY_P50:
+      g_mutex_lock (&priv->stat_lock);
+      g_value_set_int64 (value,
+          gst_tensor_filter_histogram_get_percentile (&priv->stat.latency_hist,
+              50.0));
+      g_mutex_unlock (&priv->stat_lock);
+      break;
+    case PROP_LATENCY_P90:
+      g_mutex_lock (&priv->stat_lock);
+      g_value_set_int64 (value,
+          gst_tensor_filter_histogram_get_percentile (&priv->stat.latency_hist,
+              90.0));
+      g_mutex_unlock (&priv->stat_lock);
+      break;
+    case PROP_LATENCY_P99:
+      g_mutex_lock (&priv->stat_lock);
+      g_value_set_int64 (value,
+          gst_tensor_filter_histogram_get_percentile (&priv->stat.latency_hist,
+              99.0));
+      g_mutex_unlock (&priv->stat_lock);
+      break;
+    case PROP_LATENCY_MAX:
+      g_mutex_lock (&priv->stat_lock);
+      g_value_set_int64 (value, (priv->stat.latency_hist.total > 0) ?
+          priv->stat.latency_hist.max : -1);
+      g_mutex_unlock (&priv->stat_lock);
+      break;
+    case PROP_LATENCY_REPORT_INTERVAL:
+      g_value_set_uint (value, priv->latency_report_interval);
+      break;
+    case PROP_SHARED_POOL_SIZE:
+      g_value_set_uint (value, priv->shared_pool_size);
+      break;
+    case PROP_INVOKE_CACHE:
+      g_value_set_boolean (value, priv->invoke_cache);
+      break;
+    case PROP_INVOKE_CACHE_SIZE:
+      g_value_set_uint64 (value, priv->invoke_cache_size);
+      break;
+    case PROP_INVOKE_CACHE_HITS:
+      g_value_set_uint64 (value,
+          __atomic_load_n (&priv->stat.cache_hits, __ATOMIC_RELAXED));
+      break;
+    case PROP_INVOKE_CACHE_MISSES:
+      g_value_set_uint64 (value,
+          __atomic_load_n (&priv->stat.cache_misses, __ATOMIC_RELAXED));
+      break;
+    case PROP_DEADLINE:
+      g_value_set_uint (value, priv->deadline);
+      break;
+    case PROP_DEADLINE_DROPPED:
+      g_value_set_uint64 (value,
+          __atomic_load_n (&priv->stat.deadline_dropped, __ATOMIC_RELAXED));
+      break;
+    case PROP_WARMUP_ITERATIONS:
+      g_value_set_uint (value, priv->warmup_iterations);
+      break;
+    case PROP_PRELOAD:
+      g_value_set_boolean (value, priv->preload);
+      break;
+    case PROP_HOT_SWAP:
+      g_value_set_boolean (value, priv->hot_swap);
+      break;
+    case PROP_HOT_SWAP_VALIDATE:
+      g_value_set_boolean (value, priv->hot_swap_validate);
+      break;
+    case PROP_CPU_AFFINITY:
+    {
+      GString *cpus = g_string_new (NULL);
+      guint i;
+
+      g_mutex_lock (&priv->policy_lock);
+      for (i = 0; priv->cpu_affinity && i < priv->cpu_affinity->len; i++) {
+        g_string_append_printf (cpus, "%s%u", (i > 0) ? "," : "",
+            g_array_index (priv->cpu_affinity, guint, i));
+      }
+      g_mutex_unlock (&priv->policy_lock);
+
+      g_value_take_string (value, g_string_free (cpus, FALSE));
+      break;
+    }
+    case PROP_SCHED_PRIORITY:
+      g_value_set_int (value, priv->sched_priority);
+      break;
+    case PROP_WARMUP_TIME:
+      g_value_set_int64 (value, priv->stat.warmup_time);
+      break;
+    case PROP_FIRST_FRAME_LATENCY:
+      g_value_set_int64 (value, priv->stat.first_frame_latency);
+      break;
+    case PROP_SHARED_POOL_STATS:
+    {
+      GstTensorFilterSharedModel *model = priv->shared_model;
+      gchar *stats = NULL;
+
+      if (model) {
+        g_mutex_lock (&model->lock);
+        stats = g_strdup_printf ("contexts=%u,invokes=%" G_GUINT64_FORMAT
+            ",contentions=%" G_GUINT64_FORMAT ",avg-wait=%" G_GINT64_FORMAT,
+            model->num_contexts, model->num_invokes, model->num_contentions,
+            (model->num_contentions > 0) ?
+            model->total_wait_time / (gint64) model->num_contentions : 0);
+        g_mutex_unlock (&model->lock);
+      }
+
+      g_value_take_string (value, stats ? stats : g_strdup (""));
+      break;
+    }
+    case PROP_FRAMEWORK_STATS:
+    {
+      GstTensorFilterFrameworkEventData data;
+      gpointer handle;
+      void **context;
+
+      data.stats = NULL;
+      if (prop->fw_opened && GST_TF_FW_V1 (priv->fw)) {
+        context = gst_tensor_filter_common_get_context (priv, &handle);
+        if (priv->fw->eventHandler (priv->fw, prop, *context, GET_STATISTICS,
+                &data) != 0)
+          data.stats = NULL;
+        gst_tensor_filter_common_put_context (priv, handle);
+      }
+
+      g_value_take_string (value, data.stats ? data.stats : g_strdup (""));
+      break;
+    }
     default:
       /* unknown property */
       return FALSE;
@@ -2266,10 +3350,27 @@ gst_tensor_filter_common_get_out_info (GstTensorFilterPrivate * priv,
   }
 
   /* call setInputDimension with given input tensor */
-  if (GST_TF_FW_V0 (priv->fw)) {
-    gst_tensor_filter_v0_call (priv, r, setInputDimension, in, out);
-  } else {
-    gst_tensor_filter_v1_call (priv, r, getModelInfo, SET_INPUT_INFO, in, out);
+  gst_tensor_filter_common_open_fw (priv);
+
+  if (priv->prop.fw_opened && priv->fw) {
+    void **data;
+    gpointer handle;
+
+    data = gst_tensor_filter_common_get_context (priv, &handle);
+
+    if (GST_TF_FW_V0 (priv->fw)) {
+      if (priv->fw->setInputDimension)
+        r = priv->fw->setInputDimension (&priv->prop, data, in, out);
+    } else if (priv->fw->getModelInfo) {
+      r = priv->fw->getModelInfo (priv->fw, &priv->prop, *data,
+          SET_INPUT_INFO, in, out);
+    }
+
+    /* the other contexts in the pool are opened again with new input info */
+    if (r == 0)
+      gst_tensor_filter_common_update_context (priv, handle, in, NULL);
+
+    gst_tensor_filter_common_put_context (priv, handle);
   }
 
   if (r != 0) {
@@ -2280,6 +3381,88 @@ gst_tensor_filter_common_get_out_info (GstTensorFilterPrivate * priv,
   return TRUE;
 }
 
+/**
+ * @brief Configure the batched tensor info, stacking the frames along the outermost dimension.
+ */
+gboolean
+gst_tensor_filter_common_configure_batch (GstTensorFilterPrivate * priv,
+    guint batch_size)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorsInfo in_info, out_info;
+  guint i, d;
+  gboolean ret = FALSE;
+
+  prop = &priv->prop;
+
+  gst_tensors_info_free (&priv->batch_in_info);
+  gst_tensors_info_free (&priv->batch_out_info);
+  priv->batch_configured = 0;
+  priv->batch_invoke = FALSE;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (batch_size <= 1)
+    return TRUE;
+
+  /* the subplugin invokes the frames without stacking them */
+  if (gst_tensor_filter_common_batch_invoke_available (priv)) {
+    priv->batch_invoke = TRUE;
+    priv->batch_configured = batch_size;
+    return TRUE;
+  }
+
+  gst_tensors_info_copy (&in_info, &prop->input_meta);
+  for (i = 0; i < in_info.num_tensors; i++)
+    in_info.info[i].dimension[NNS_TENSOR_RANK_LIMIT - 1] *= batch_size;
+
+  /* set the batched input info to the model */
+  if (!gst_tensor_filter_common_get_out_info (priv, &in_info, &out_info)) {
+    nns_loge ("Failed to set the batched input info (batch %u) to the model.",
+        batch_size);
+    goto done;
+  }
+
+  /* the model should stack the output frames along the outermost dimension */
+  if (out_info.num_tensors != prop->output_meta.num_tensors) {
+    nns_loge ("The number of batched output tensors (%u) is invalid, expected %u.",
+        out_info.num_tensors, prop->output_meta.num_tensors);
+    goto done;
+  }
+
+  for (i = 0; i < out_info.num_tensors; i++) {
+    GstTensorInfo *batched = &out_info.info[i];
+    GstTensorInfo *frame = &prop->output_meta.info[i];
+
+    if (batched->type != frame->type)
+      goto invalid_output;
+
+    for (d = 0; d < NNS_TENSOR_RANK_LIMIT - 1; d++) {
+      if (batched->dimension[d] != frame->dimension[d])
+        goto invalid_output;
+    }
+
+    if (batched->dimension[d] != frame->dimension[d] * batch_size)
+      goto invalid_output;
+  }
+
+  gst_tensors_info_copy (&priv->batch_in_info, &in_info);
+  gst_tensors_info_copy (&priv->batch_out_info, &out_info);
+  priv->batch_configured = batch_size;
+  ret = TRUE;
+  goto done;
+
+invalid_output:
+  nns_loge ("The model does not stack the output along the outermost dimension.");
+  gst_tensor_filter_compare_tensors (&out_info, &prop->output_meta);
+
+done:
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return ret;
+}
+
 /**
  * @brief Load tensor info from NN model.
  * (both input and output tensor)
@@ -2353,54 +3536,1425 @@ done:
 }
 
 /**
- * @brief Open NN framework.
+ * @brief Open a context of NN framework and set the input info same as the tensor-filter.
  */
-void
-gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
+static gboolean
+_gtfc_open_context (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data)
 {
-  int run_without_model = 0;
+  GstTensorsInfo out_info;
+  int ret = -ENOENT;
 
-  if (!priv->prop.fw_opened && priv->fw) {
-    if (priv->fw->open) {
-      /* at least one model should be configured before opening fw */
-      if (GST_TF_FW_V0 (priv->fw)) {
-        run_without_model = priv->fw->run_without_model;
-      } else if (GST_TF_FW_V1 (priv->fw)) {
-        run_without_model = priv->info.run_without_model;
-      }
+  if (priv->fw->open && _gtfc_fw_open (priv, prop, private_data) < 0)
+    return FALSE;
 
-      if (G_UNLIKELY (!run_without_model) &&
-          G_UNLIKELY (!(priv->prop.model_files &&
-                  priv->prop.num_models > 0 && priv->prop.model_files[0]))) {
-        return;
-      }
-      /* 0 if successfully loaded. 1 if skipped (already loaded). */
-      if (verify_model_path (priv)) {
-        if (priv->fw->open (&priv->prop, &priv->privateData) >= 0) {
-          /* Update the framework info once it has been opened */
-          if (GST_TF_FW_V1 (priv->fw) &&
-              priv->fw->getFrameworkInfo (priv->fw, &priv->prop,
-                  priv->privateData, &priv->info) != 0) {
-            priv->fw->close (&priv->prop, &priv->privateData);
-          } else {
-            priv->prop.fw_opened = TRUE;
-          }
-        }
+  if (!prop->input_configured)
+    return TRUE;
+
+  gst_tensors_info_init (&out_info);
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    if (priv->fw->setInputDimension) {
+      ret = priv->fw->setInputDimension (prop, private_data,
+          &prop->input_meta, &out_info);
+    }
+  } else {
+    ret = priv->fw->getModelInfo (priv->fw, prop, *private_data,
+        SET_INPUT_INFO, &prop->input_meta, &out_info);
+  }
+
+  gst_tensors_info_free (&out_info);
+
+  if (ret != 0 && ret != -ENOENT) {
+    if (priv->fw->close)
+      priv->fw->close (prop, private_data);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Create new shared model. The first context is opened by the caller.
+ */
+static GstTensorFilterSharedModel *
+_gtfc_shared_model_new (const gchar * key, GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterSharedModel *model;
+
+  model = g_new0 (GstTensorFilterSharedModel, 1);
+  model->key = g_strdup (key);
+  model->fw = priv->fw;
+  model->refcount = 1;
+  g_mutex_init (&model->lock);
+  g_cond_init (&model->cond);
+  g_queue_init (&model->idle);
+  model->outputs = g_hash_table_new (g_direct_hash, g_direct_equal);
+  model->opening = TRUE;
+  model->num_contexts = 1;
+
+  model->model_files = g_strdupv ((gchar **) priv->prop.model_files);
+  model->input_configured = priv->prop.input_configured;
+  gst_tensors_info_init (&model->input_info);
+  if (model->input_configured)
+    gst_tensors_info_copy (&model->input_info, &priv->prop.input_meta);
+
+  return model;
+}
+
+/**
+ * @brief Close the framework context of shared model.
+ */
+static void
+_gtfc_shared_context_close (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedContext * ctx)
+{
+  if (priv->fw->close)
+    priv->fw->close (&priv->prop, &ctx->data);
+  g_free (ctx);
+}
+
+/**
+ * @brief Release a reference of the context. Call this with the lock of shared model.
+ * @return TRUE if the context is not used anymore, close it out of the lock.
+ */
+static gboolean
+_gtfc_shared_context_unref_locked (GstTensorFilterSharedContext * ctx)
+{
+  return (--ctx->refcount == 0);
+}
+
+/**
+ * @brief Close all contexts and free the shared model. No invoke should be running.
+ * @note The contexts of the output data not freed yet are closed too.
+ */
+static void
+_gtfc_shared_model_free (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedModel * model)
+{
+  GstTensorFilterSharedContext *ctx;
+  GHashTableIter iter;
+  gpointer value;
+
+  /* no invoke is running, all contexts are idle */
+  while ((ctx = g_queue_pop_head (&model->idle)) != NULL) {
+    if (_gtfc_shared_context_unref_locked (ctx))
+      _gtfc_shared_context_close (priv, ctx);
+  }
+
+  g_hash_table_iter_init (&iter, model->outputs);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    ctx = (GstTensorFilterSharedContext *) value;
+    g_hash_table_iter_remove (&iter);
+    if (_gtfc_shared_context_unref_locked (ctx))
+      _gtfc_shared_context_close (priv, ctx);
+  }
+
+  g_hash_table_destroy (model->outputs);
+  g_mutex_clear (&model->lock);
+  g_cond_clear (&model->cond);
+  g_strfreev (model->model_files);
+  gst_tensors_info_free (&model->input_info);
+  g_free (model->key);
+  g_free (model);
+}
+
+/**
+ * @brief Release the reference of shared model registered in the table.
+ */
+static void
+_gtfc_shared_model_unref (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedModel * model)
+{
+  gboolean last;
+
+  G_LOCK (shared_models);
+
+  /* do not share the model failed to open anymore */
+  if ((model->failed || model->refcount == 1) &&
+      g_hash_table_lookup (shared_models, model->key) == model)
+    g_hash_table_remove (shared_models, model->key);
+
+  model->refcount--;
+  last = (model->refcount == 0);
+
+  G_UNLOCK (shared_models);
+
+  /* close the contexts out of the global lock */
+  if (last)
+    _gtfc_shared_model_free (priv, model);
+}
+
+/**
+ * @brief Attach the tensor-filter to the shared model. The model is opened if the key is not registered.
+ * @note The framework is opened out of the global lock, other tensor-filters sharing the key wait for it.
+ */
+static gboolean
+_gtfc_shared_model_attach (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterSharedModel *model;
+  GstTensorFilterSharedContext *ctx;
+  const gchar *key = priv->prop.shared_tensor_filter_key;
+  gboolean opener = FALSE;
+  gboolean failed;
+
+  if (key == NULL) {
+    /* private pool, the model is not registered in the table */
+    if (priv->private_pool_size == 0)
+      return FALSE;
+
+    model = _gtfc_shared_model_new (NULL, priv);
+    opener = TRUE;
+  } else {
+    G_LOCK (shared_models);
+
+    if (!shared_models)
+      shared_models = g_hash_table_new (g_str_hash, g_str_equal);
+
+    model = g_hash_table_lookup (shared_models, key);
+    if (model) {
+      if (model->fw != priv->fw) {
+        nns_loge ("The shared model '%s' is opened with other framework.",
+            key);
+        G_UNLOCK (shared_models);
+        return FALSE;
       }
+
+      model->refcount++;
     } else {
-      priv->prop.fw_opened = TRUE;
+      model = _gtfc_shared_model_new (key, priv);
+      g_hash_table_insert (shared_models, model->key, model);
+      opener = TRUE;
+    }
+
+    G_UNLOCK (shared_models);
+  }
+
+  if (opener) {
+    ctx = g_new0 (GstTensorFilterSharedContext, 1);
+    ctx->refcount = 1;
+    failed = (_gtfc_fw_open (priv, &priv->prop, &ctx->data) < 0);
+
+    g_mutex_lock (&model->lock);
+    if (failed) {
+      model->num_contexts = 0;
+      g_free (ctx);
+    } else {
+      g_queue_push_tail (&model->idle, ctx);
     }
+    model->failed = failed;
+    model->opening = FALSE;
+    g_cond_broadcast (&model->cond);
+    g_mutex_unlock (&model->lock);
+  } else {
+    g_mutex_lock (&model->lock);
+    while (model->opening)
+      g_cond_wait (&model->cond, &model->lock);
+    failed = model->failed;
+    g_mutex_unlock (&model->lock);
+  }
+
+  if (failed) {
+    if (key == NULL)
+      _gtfc_shared_model_free (priv, model);
+    else
+      _gtfc_shared_model_unref (priv, model);
+    return FALSE;
+  }
+
+  /* each tensor-filter sharing the model adds its contexts to the pool */
+  g_mutex_lock (&model->lock);
+  if (key) {
+    priv->shared_pool_share = priv->shared_pool_size;
+    model->pool_size += priv->shared_pool_share;
+  } else {
+    model->pool_size = priv->private_pool_size;
   }
+  g_mutex_unlock (&model->lock);
+
+  priv->shared_model = model;
+  return TRUE;
 }
 
 /**
- * @brief Close NN framework.
+ * @brief Detach the tensor-filter from the shared model. The contexts are closed when the last one is detached.
  */
-void
-gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
+static void
+_gtfc_shared_model_detach (GstTensorFilterPrivate * priv)
 {
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  GstTensorFilterSharedContext *ctx;
+  GQueue closing = G_QUEUE_INIT;
+
+  if (!model)
+    return;
+
+  if (model->key == NULL) {
+    /* private pool */
+    _gtfc_shared_model_free (priv, model);
+  } else {
+    /* remove the contexts of this tensor-filter from the pool */
+    g_mutex_lock (&model->lock);
+    model->pool_size = (model->pool_size > priv->shared_pool_share) ?
+        model->pool_size - priv->shared_pool_share : 1;
+    while (model->num_contexts > model->pool_size &&
+        (ctx = g_queue_pop_head (&model->idle)) != NULL) {
+      model->num_contexts--;
+      if (_gtfc_shared_context_unref_locked (ctx))
+        g_queue_push_tail (&closing, ctx);
+    }
+    g_mutex_unlock (&model->lock);
+
+    while ((ctx = g_queue_pop_head (&closing)) != NULL)
+      _gtfc_shared_context_close (priv, ctx);
+
+    _gtfc_shared_model_unref (priv, model);
+  }
+
+  priv->shared_pool_share = 0;
+  priv->shared_model = NULL;
+  priv->privateData = NULL;
+}
+
+/**
+ * @brief Open a new context of shared model with the model files and input info of current generation.
+ */
+static GstTensorFilterSharedContext *
+_gtfc_shared_context_open (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedModel * model, guint generation,
+    const gchar ** model_files, const GstTensorsInfo * input_info,
+    gboolean input_configured)
+{
+  GstTensorFilterSharedContext *ctx;
+  GstTensorFilterProperties prop;
+
+  memcpy (&prop, &priv->prop, sizeof (GstTensorFilterProperties));
+  prop.model_files = model_files;
+  prop.num_models = g_strv_length ((gchar **) model_files);
+  prop.input_configured = input_configured;
+  memcpy (&prop.input_meta, input_info, sizeof (GstTensorsInfo));
+
+  ctx = g_new0 (GstTensorFilterSharedContext, 1);
+  ctx->generation = generation;
+  ctx->refcount = 1;
+
+  if (!_gtfc_open_context (priv, &prop, &ctx->data)) {
+    nns_logw ("Failed to open a context of the shared model '%s'.",
+        GST_STR_NULL (model->key));
+    g_free (ctx);
+    return NULL;
+  }
+
+  return ctx;
+}
+
+/**
+ * @brief Check out an idle context from the pool of shared model. The pool is grown up to the pool size.
+ * @param invoke TRUE to count the statistics of invoke
+ */
+static GstTensorFilterSharedContext *
+_gtfc_shared_model_checkout (GstTensorFilterPrivate * priv, gboolean invoke)
+{
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  GstTensorFilterSharedContext *ctx = NULL;
+  gint64 wait_start = 0;
+
+  g_mutex_lock (&model->lock);
+
+  while (g_queue_is_empty (&model->idle)) {
+    if (model->num_contexts < model->pool_size) {
+      gchar **files;
+      GstTensorsInfo info;
+      gboolean configured;
+      guint generation;
+
+      /* open a new context out of the lock */
+      model->num_contexts++;
+      files = g_strdupv (model->model_files);
+      gst_tensors_info_init (&info);
+      gst_tensors_info_copy (&info, &model->input_info);
+      configured = model->input_configured;
+      generation = model->generation;
+      g_mutex_unlock (&model->lock);
+
+      ctx = _gtfc_shared_context_open (priv, model, generation,
+          (const gchar **) files, &info, configured);
+      g_strfreev (files);
+      gst_tensors_info_free (&info);
+
+      g_mutex_lock (&model->lock);
+
+      if (ctx && ctx->generation != model->generation) {
+        /* the model is updated while opening, open again */
+        model->num_contexts--;
+        g_mutex_unlock (&model->lock);
+        _gtfc_shared_context_close (priv, ctx);
+        ctx = NULL;
+        g_mutex_lock (&model->lock);
+        continue;
+      }
+
+      if (ctx)
+        goto done;
+
+      /* do not grow the pool anymore */
+      model->num_contexts--;
+      model->pool_size = MAX (model->num_contexts, 1);
+      continue;
+    }
+
+    if (invoke && wait_start == 0) {
+      wait_start = g_get_monotonic_time ();
+      model->num_contentions++;
+    }
+
+    g_cond_wait (&model->cond, &model->lock);
+  }
+
+  ctx = g_queue_pop_head (&model->idle);
+
+done:
+  if (wait_start > 0)
+    model->total_wait_time += g_get_monotonic_time () - wait_start;
+  if (invoke)
+    model->num_invokes++;
+
+  g_mutex_unlock (&model->lock);
+  return ctx;
+}
+
+/**
+ * @brief Return the context to the pool of shared model. The context of old generation is closed.
+ */
+static void
+_gtfc_shared_model_checkin (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedContext * ctx)
+{
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  gboolean closing = FALSE;
+
+  g_mutex_lock (&model->lock);
+  if (ctx->generation != model->generation) {
+    model->num_contexts--;
+    closing = _gtfc_shared_context_unref_locked (ctx);
+  } else {
+    g_queue_push_tail (&model->idle, ctx);
+  }
+  g_cond_signal (&model->cond);
+  g_mutex_unlock (&model->lock);
+
+  /* a new context is opened with new model when checking out */
+  if (closing)
+    _gtfc_shared_context_close (priv, ctx);
+}
+
+/**
+ * @brief Increase the generation of shared model with the updated context, and close the idle contexts of old generation.
+ */
+static void
+_gtfc_shared_model_update (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedContext * ctx, const GstTensorsInfo * input_info,
+    const gchar ** model_files)
+{
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  GstTensorFilterSharedContext *idle;
+  GQueue closing = G_QUEUE_INIT;
+
+  g_mutex_lock (&model->lock);
+
+  if (input_info) {
+    gst_tensors_info_free (&model->input_info);
+    gst_tensors_info_copy (&model->input_info, input_info);
+    model->input_configured = TRUE;
+  }
+
+  if (model_files) {
+    g_strfreev (model->model_files);
+    model->model_files = g_strdupv ((gchar **) model_files);
+  }
+
+  model->generation++;
+  ctx->generation = model->generation;
+
+  while ((idle = g_queue_pop_head (&model->idle)) != NULL) {
+    model->num_contexts--;
+    if (_gtfc_shared_context_unref_locked (idle))
+      g_queue_push_tail (&closing, idle);
+  }
+
+  /* the pool is grown again with new model */
+  g_cond_broadcast (&model->cond);
+  g_mutex_unlock (&model->lock);
+
+  while ((idle = g_queue_pop_head (&closing)) != NULL)
+    _gtfc_shared_context_close (priv, idle);
+}
+
+/**
+ * @brief Check the context of shared model allocates the output data in invoke.
+ */
+static gboolean
+_gtfc_shared_context_allocate_in_invoke (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedContext * ctx)
+{
+  if (GST_TF_FW_V0 (priv->fw)) {
+    if (!priv->fw->allocate_in_invoke)
+      return FALSE;
+    return (priv->fw->allocateInInvoke == NULL ||
+        priv->fw->allocateInInvoke (&ctx->data) == 0);
+  }
+
+  return (GST_TF_FW_V1 (priv->fw) && priv->info.allocate_in_invoke);
+}
+
+/**
+ * @brief Keep the context allocated the output data in invoke, until the data is freed.
+ */
+static void
+_gtfc_shared_model_track_outputs (GstTensorFilterPrivate * priv,
+    GstTensorFilterSharedContext * ctx, guint num_frames,
+    GstTensorMemory ** output)
+{
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  guint i, n;
+
+  if (!_gtfc_shared_context_allocate_in_invoke (priv, ctx))
+    return;
+
+  g_mutex_lock (&model->lock);
+  for (n = 0; n < num_frames; n++) {
+    for (i = 0; i < priv->prop.output_meta.num_tensors; i++) {
+      if (output[n][i].data == NULL ||
+          g_hash_table_contains (model->outputs, output[n][i].data))
+        continue;
+
+      g_hash_table_insert (model->outputs, output[n][i].data, ctx);
+      ctx->refcount++;
+    }
+  }
+  g_mutex_unlock (&model->lock);
+}
+
+/**
+ * @brief Free the output data with the context of shared model allocated it.
+ * @return FALSE if the data is not allocated by the contexts of shared model.
+ */
+static gboolean
+_gtfc_shared_model_destroy_notify (GstTensorFilterPrivate * priv, void *data)
+{
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  GstTensorFilterSharedContext *ctx;
+  gboolean closing;
+
+  g_mutex_lock (&model->lock);
+  ctx = g_hash_table_lookup (model->outputs, data);
+  if (ctx)
+    g_hash_table_remove (model->outputs, data);
+  g_mutex_unlock (&model->lock);
+
+  if (!ctx)
+    return FALSE;
+
+  _gtfc_destroy_notify_context (priv, &priv->prop, &ctx->data, data);
+
+  g_mutex_lock (&model->lock);
+  closing = _gtfc_shared_context_unref_locked (ctx);
+  g_mutex_unlock (&model->lock);
+
+  /* the context is removed from the pool while the data is in use */
+  if (closing)
+    _gtfc_shared_context_close (priv, ctx);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the context of NN framework to call the subplugin.
+ */
+void **
+gst_tensor_filter_common_get_context (GstTensorFilterPrivate * priv,
+    gpointer * handle)
+{
+  GstTensorFilterSharedContext *ctx;
+
+  g_return_val_if_fail (handle != NULL, NULL);
+
+  if (priv->shared_model == NULL) {
+    *handle = NULL;
+    return &priv->privateData;
+  }
+
+  ctx = _gtfc_shared_model_checkout (priv, FALSE);
+  *handle = ctx;
+  return &ctx->data;
+}
+
+/**
+ * @brief Release the context of NN framework.
+ */
+void
+gst_tensor_filter_common_put_context (GstTensorFilterPrivate * priv,
+    gpointer handle)
+{
+  if (handle)
+    _gtfc_shared_model_checkin (priv, (GstTensorFilterSharedContext *) handle);
+}
+
+/**
+ * @brief Notify the context of NN framework is updated.
+ */
+void
+gst_tensor_filter_common_update_context (GstTensorFilterPrivate * priv,
+    gpointer handle, const GstTensorsInfo * input_info,
+    const gchar ** model_files)
+{
+  if (handle) {
+    _gtfc_shared_model_update (priv, (GstTensorFilterSharedContext *) handle,
+        input_info, model_files);
+  }
+}
+
+/**
+ * @brief Invoke the shared model with a framework context checked out from the pool.
+ */
+gint
+gst_tensor_filter_common_invoke_shared (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, const GstTensorMemory * input,
+    GstTensorMemory * output)
+{
+  GstTensorFilterSharedContext *ctx;
+  gint ret;
+
+  g_return_val_if_fail (priv->shared_model != NULL, -EINVAL);
+
+  ctx = _gtfc_shared_model_checkout (priv, TRUE);
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    ret = priv->fw->invoke_NN (prop, &ctx->data, input, output);
+  } else {
+    ret = priv->fw->invoke (priv->fw, prop, ctx->data, input, output);
+  }
+
+  if (ret == 0)
+    _gtfc_shared_model_track_outputs (priv, ctx, 1, &output);
+
+  _gtfc_shared_model_checkin (priv, ctx);
+  return ret;
+}
+
+/**
+ * @brief Check the subplugin supports the batched invoke with the opened model.
+ */
+gboolean
+gst_tensor_filter_common_batch_invoke_available (GstTensorFilterPrivate * priv)
+{
+  void **data;
+  gpointer handle;
+  gint ret;
+
+  if (!priv->prop.fw_opened || !GST_TF_FW_V2 (priv->fw) ||
+      priv->fw->invoke_batch == NULL)
+    return FALSE;
+
+  data = gst_tensor_filter_common_get_context (priv, &handle);
+
+  /* the subplugin returns 0 if supported when there is no frame */
+  ret = priv->fw->invoke_batch (priv->fw, &priv->prop, *data, 0, NULL, NULL);
+
+  gst_tensor_filter_common_put_context (priv, handle);
+
+  return (ret == 0);
+}
+
+/**
+ * @brief Invoke the frames at once with the subplugin callback 'invoke_batch', or one by one if not supported.
+ */
+gint
+gst_tensor_filter_common_invoke_batch (GstTensorFilterPrivate * priv,
+    guint num_frames, const GstTensorMemory ** input,
+    GstTensorMemory ** output)
+{
+  GstTensorFilterSharedContext *ctx;
+  void *data;
+  guint i;
+  gint ret = -ENOENT;
+
+  g_return_val_if_fail (num_frames > 0, -EINVAL);
+  g_return_val_if_fail (input != NULL && output != NULL, -EINVAL);
+
+  if (GST_TF_FW_V2 (priv->fw) && priv->fw->invoke_batch) {
+    ctx = priv->shared_model ? _gtfc_shared_model_checkout (priv, TRUE) : NULL;
+    data = ctx ? ctx->data : priv->privateData;
+
+    ret = priv->fw->invoke_batch (priv->fw, &priv->prop, data, num_frames,
+        input, output);
+
+    if (ctx) {
+      if (ret == 0)
+        _gtfc_shared_model_track_outputs (priv, ctx, num_frames, output);
+      _gtfc_shared_model_checkin (priv, ctx);
+    }
+  }
+
+  if (ret == -ENOENT) {
+    for (i = 0, ret = 0; i < num_frames && ret == 0; i++)
+      GST_TF_FW_INVOKE_COMPAT (priv, ret, input[i], output[i]);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Open NN framework.
+ */
+void
+gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
+{
+  int run_without_model = 0;
+
+  if (!priv->prop.fw_opened && priv->fw) {
+    if (priv->fw->open) {
+      /* at least one model should be configured before opening fw */
+      if (GST_TF_FW_V0 (priv->fw)) {
+        run_without_model = priv->fw->run_without_model;
+      } else if (GST_TF_FW_V1 (priv->fw)) {
+        run_without_model = priv->info.run_without_model;
+      }
+
+      if (G_UNLIKELY (!run_without_model) &&
+          G_UNLIKELY (!(priv->prop.model_files &&
+                  priv->prop.num_models > 0 && priv->prop.model_files[0]))) {
+        return;
+      }
+      /* 0 if successfully loaded. 1 if skipped (already loaded). */
+      if (verify_model_path (priv)) {
+        gboolean opened;
+
+        if (priv->prop.shared_tensor_filter_key ||
+            priv->private_pool_size > 1)
+          opened = _gtfc_shared_model_attach (priv);
+        else
+          opened = (_gtfc_fw_open (priv, &priv->prop,
+                  &priv->privateData) >= 0);
+
+        if (opened && GST_TF_FW_V1 (priv->fw)) {
+          void **data;
+          gpointer handle;
+
+          /* Update the framework info once it has been opened */
+          data = gst_tensor_filter_common_get_context (priv, &handle);
+          if (priv->fw->getFrameworkInfo (priv->fw, &priv->prop, *data,
+                  &priv->info) != 0)
+            opened = FALSE;
+          gst_tensor_filter_common_put_context (priv, handle);
+
+          if (!opened) {
+            if (priv->shared_model)
+              _gtfc_shared_model_detach (priv);
+            else
+              priv->fw->close (&priv->prop, &priv->privateData);
+          }
+        }
+
+        if (opened)
+          priv->prop.fw_opened = TRUE;
+      }
+    } else {
+      priv->prop.fw_opened = TRUE;
+    }
+  }
+}
+
+/**
+ * @brief Data structure for the thread policy applied to current thread.
+ */
+typedef struct
+{
+  gconstpointer owner; /**< the tensor-filter applied the policy */
+  gint serial; /**< the serial of the policy */
+} GstTensorFilterThreadPolicy;
+
+static GPrivate thread_policy_key = G_PRIVATE_INIT (g_free);
+
+#if defined(__linux__)
+/**
+ * @brief Data structure for the old policy of the thread, to be restored.
+ */
+typedef struct
+{
+  pid_t tid; /**< the thread applied the policy */
+  gint serial; /**< the serial of the policy applied to the thread */
+  cpu_set_t affinity; /**< the old CPU affinity */
+  gint sched_policy; /**< the old scheduling policy */
+  struct sched_param sched_param; /**< the old scheduling parameter */
+  gint nice; /**< the old nice value */
+} GstTensorFilterThreadState;
+
+/**
+ * @brief Internal function to save the policy of the thread.
+ */
+static void
+_gtfc_thread_state_save (GstTensorFilterThreadState * state, pid_t tid)
+{
+  memset (state, 0, sizeof (GstTensorFilterThreadState));
+  state->tid = tid;
+
+  if (sched_getaffinity (tid, sizeof (cpu_set_t), &state->affinity) != 0) {
+    gint c;
+
+    /* all cores if failed to get the affinity */
+    for (c = 0; c < CPU_SETSIZE; c++)
+      CPU_SET (c, &state->affinity);
+  }
+
+  state->sched_policy = sched_getscheduler (tid);
+  if (state->sched_policy < 0 ||
+      sched_getparam (tid, &state->sched_param) != 0) {
+    state->sched_policy = SCHED_OTHER;
+    state->sched_param.sched_priority = 0;
+  }
+
+  errno = 0;
+  state->nice = getpriority (PRIO_PROCESS, (id_t) tid);
+  if (errno != 0)
+    state->nice = 0;
+}
+
+/**
+ * @brief Internal function to set the policy of the thread, the old policy is set if not given.
+ */
+static void
+_gtfc_thread_state_set (const GstTensorFilterThreadState * state,
+    const GArray * cpus, gint priority)
+{
+  struct sched_param param;
+  cpu_set_t set;
+  guint i;
+
+  if (cpus) {
+    CPU_ZERO (&set);
+    for (i = 0; i < cpus->len; i++)
+      CPU_SET (g_array_index (cpus, guint, i), &set);
+  } else {
+    set = state->affinity;
+  }
+
+  if (sched_setaffinity (state->tid, sizeof (cpu_set_t), &set) != 0)
+    nns_logw ("Failed to set the cpu affinity (%d).", errno);
+
+  if (priority > 0) {
+    param.sched_priority = priority;
+    if (sched_setscheduler (state->tid, SCHED_FIFO, &param) != 0)
+      nns_logw ("Failed to set the real-time priority %d (%d).", priority,
+          errno);
+  } else {
+    if (sched_getscheduler (state->tid) != state->sched_policy &&
+        sched_setscheduler (state->tid, state->sched_policy,
+            &state->sched_param) != 0)
+      nns_logw ("Failed to restore the scheduling policy (%d).", errno);
+
+    if (setpriority (PRIO_PROCESS, (id_t) state->tid,
+            (priority < 0) ? priority : state->nice) != 0)
+      nns_logw ("Failed to set the nice value %d (%d).",
+          (priority < 0) ? priority : state->nice, errno);
+  }
+}
+#endif
+
+/**
+ * @brief Apply the CPU affinity and scheduling priority to current thread invoking the model.
+ */
+void
+gst_tensor_filter_common_apply_thread_policy (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterThreadPolicy *policy;
+  gint serial;
+
+  serial = g_atomic_int_get (&priv->policy_serial);
+
+  /* the properties are not set */
+  if (G_LIKELY (serial == 0))
+    return;
+
+  policy = (GstTensorFilterThreadPolicy *) g_private_get (&thread_policy_key);
+
+  if (policy == NULL) {
+    policy = g_new0 (GstTensorFilterThreadPolicy, 1);
+    g_private_set (&thread_policy_key, policy);
+  } else if (policy->owner == priv && policy->serial == serial) {
+    /* already applied */
+    return;
+  }
+
+  policy->owner = priv;
+  policy->serial = serial;
+
+#if defined(__linux__)
+  {
+    GstTensorFilterThreadState *state = NULL;
+    pid_t tid = (pid_t) syscall (SYS_gettid);
+    guint i;
+
+    g_mutex_lock (&priv->policy_lock);
+    serial = priv->policy_serial;
+
+    for (i = 0; priv->policy_threads && i < priv->policy_threads->len; i++) {
+      if (g_array_index (priv->policy_threads, GstTensorFilterThreadState,
+              i).tid == tid) {
+        state = &g_array_index (priv->policy_threads,
+            GstTensorFilterThreadState, i);
+        break;
+      }
+    }
+
+    if (state == NULL &&
+        (priv->cpu_affinity != NULL || priv->sched_priority != 0)) {
+      GstTensorFilterThreadState saved;
+
+      /* save the old policy once, to be restored at stop */
+      _gtfc_thread_state_save (&saved, tid);
+
+      if (priv->policy_threads == NULL) {
+        priv->policy_threads = g_array_new (FALSE, FALSE,
+            sizeof (GstTensorFilterThreadState));
+      }
+      g_array_append_val (priv->policy_threads, saved);
+      state = &g_array_index (priv->policy_threads, GstTensorFilterThreadState,
+          priv->policy_threads->len - 1);
+    }
+
+    /* the old policy is set again if the properties are cleared */
+    if (state && state->serial != serial) {
+      _gtfc_thread_state_set (state, priv->cpu_affinity, priv->sched_priority);
+      state->serial = serial;
+    }
+
+    g_mutex_unlock (&priv->policy_lock);
+  }
+#else
+  nns_logw ("The cpu-affinity and sched-priority are not supported.");
+#endif
+}
+
+/**
+ * @brief Restore the old policy of the threads applied the CPU affinity and scheduling priority.
+ */
+void
+gst_tensor_filter_common_restore_thread_policy (GstTensorFilterPrivate * priv,
+    gboolean current)
+{
+#if defined(__linux__)
+  GstTensorFilterThreadPolicy *policy;
+  GstTensorFilterThreadState *state;
+  pid_t tid = 0;
+  guint i;
+
+  if (current) {
+    tid = (pid_t) syscall (SYS_gettid);
+
+    /* apply the policy again if the thread invokes the model later */
+    policy = (GstTensorFilterThreadPolicy *) g_private_get (&thread_policy_key);
+    if (policy && policy->owner == priv)
+      policy->owner = NULL;
+  }
+
+  g_mutex_lock (&priv->policy_lock);
+  for (i = priv->policy_threads ? priv->policy_threads->len : 0; i > 0; i--) {
+    state = &g_array_index (priv->policy_threads, GstTensorFilterThreadState,
+        i - 1);
+
+    if (current && state->tid != tid)
+      continue;
+
+    _gtfc_thread_state_set (state, NULL, 0);
+    g_array_remove_index_fast (priv->policy_threads, i - 1);
+  }
+
+  /* the other threads apply the policy again */
+  if (!current && priv->policy_serial != 0)
+    g_atomic_int_inc (&priv->policy_serial);
+  g_mutex_unlock (&priv->policy_lock);
+#endif
+}
+
+/**
+ * @brief Internal function to open a context of NN framework. The threads created by the framework while opening it inherit the CPU affinity and scheduling priority.
+ */
+static int
+_gtfc_fw_open (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data)
+{
+  int ret;
+
+  gst_tensor_filter_common_apply_thread_policy (priv);
+  ret = priv->fw->open (prop, private_data);
+  gst_tensor_filter_common_restore_thread_policy (priv, TRUE);
+
+  return ret;
+}
+
+/**
+ * @brief Invoke the model with a framework context, or the default one of tensor-filter if private_data is NULL.
+ */
+static gint
+_gtfc_invoke_context (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data,
+    GstTensorMemory * input, GstTensorMemory * output)
+{
+  gint ret = -1;
+
+  if (private_data == NULL) {
+    GST_TF_FW_INVOKE_COMPAT (priv, ret, input, output);
+  } else if (GST_TF_FW_V0 (priv->fw)) {
+    ret = priv->fw->invoke_NN (prop, private_data, input, output);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    ret = priv->fw->invoke (priv->fw, prop, *private_data, input, output);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Free the output data allocated by a framework context, or the default one of tensor-filter if private_data is NULL.
+ */
+static void
+_gtfc_destroy_notify_context (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data, void *data)
+{
+  GstTensorFilterFrameworkEventData event_data;
+
+  if (private_data == NULL) {
+    gst_tensor_filter_destroy_notify_util (priv, data);
+  } else if (GST_TF_FW_V0 (priv->fw) && priv->fw->destroyNotify) {
+    priv->fw->destroyNotify (private_data, data);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    event_data.data = data;
+    if (priv->fw->eventHandler (priv->fw, prop, *private_data,
+            DESTROY_NOTIFY, &event_data) == -ENOENT) {
+      g_free (data);
+    }
+  } else {
+    g_free (data);
+  }
+}
+
+/**
+ * @brief Run the invokes with zero-filled inputs. The tensor info of tensor-filter should be fixed.
+ * @param[in] private_data The framework context to be invoked (NULL to use the default one of tensor-filter)
+ * @param[out] elapsed The time to run the invokes (usec)
+ */
+static gboolean
+_gtfc_run_warmup (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data,
+    guint iterations, gint64 * elapsed)
+{
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  gboolean allocate_in_invoke;
+  gint64 start_time;
+  guint i, n;
+  gint ret = 0;
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+
+  memset (in_tensors, 0, sizeof (in_tensors));
+  memset (out_tensors, 0, sizeof (out_tensors));
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    in_tensors[i].size = gst_tensor_info_get_size (&prop->input_meta.info[i]);
+    in_tensors[i].data = g_malloc0 (in_tensors[i].size);
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++)
+    out_tensors[i].size = gst_tensor_info_get_size (&prop->output_meta.info[i]);
+
+  start_time = g_get_monotonic_time ();
+
+  for (n = 0; n < iterations; n++) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      if (!allocate_in_invoke && out_tensors[i].data == NULL)
+        out_tensors[i].data = g_malloc (out_tensors[i].size);
+    }
+
+    ret = _gtfc_invoke_context (priv, prop, private_data, in_tensors,
+        out_tensors);
+
+    if (allocate_in_invoke) {
+      for (i = 0; i < prop->output_meta.num_tensors; i++) {
+        if (ret == 0 && out_tensors[i].data)
+          _gtfc_destroy_notify_context (priv, prop, private_data,
+              out_tensors[i].data);
+        out_tensors[i].data = NULL;
+      }
+    }
+
+    if (ret != 0) {
+      ml_loge ("Failed to invoke the model for the warm-up (%d).", ret);
+      break;
+    }
+  }
+
+  *elapsed = g_get_monotonic_time () - start_time;
+  ml_logi ("Warm-up with %u invokes took %.3f ms.", n, *elapsed / 1000.0);
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++)
+    g_free (in_tensors[i].data);
+
+  if (!allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++)
+      g_free (out_tensors[i].data);
+  }
+
+  return (ret == 0);
+}
+
+/**
+ * @brief Run the warm-up invokes with each context in the pool of shared model, up to the pool size.
+ */
+static gboolean
+_gtfc_shared_model_warmup (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterSharedModel *model = priv->shared_model;
+  GstTensorFilterSharedContext *ctx;
+  GQueue warmed = G_QUEUE_INIT;
+  gboolean available, ret = TRUE;
+  gint64 elapsed;
+  guint i, pool_size;
+
+  priv->stat.warmup_time = 0;
+  pool_size = model->key ? priv->shared_pool_size : priv->private_pool_size;
+
+  /* hold the warmed contexts, so that next one is opened or checked out */
+  for (i = 0; i < pool_size && ret; i++) {
+    g_mutex_lock (&model->lock);
+    available = (!g_queue_is_empty (&model->idle) ||
+        model->num_contexts < model->pool_size);
+    g_mutex_unlock (&model->lock);
+
+    /* do not wait for the contexts used by other tensor-filters */
+    if (!available)
+      break;
+
+    ctx = _gtfc_shared_model_checkout (priv, FALSE);
+    g_queue_push_tail (&warmed, ctx);
+
+    ret = _gtfc_run_warmup (priv, &priv->prop, &ctx->data,
+        priv->warmup_iterations, &elapsed);
+    priv->stat.warmup_time += elapsed;
+  }
+
+  while ((ctx = (GstTensorFilterSharedContext *) g_queue_pop_head (&warmed)))
+    _gtfc_shared_model_checkin (priv, ctx);
+
+  return ret;
+}
+
+/**
+ * @brief Check the tensor info is fixed to run the warm-up.
+ */
+static gboolean
+_gtfc_warmup_available (GstTensorFilterProperties * prop)
+{
+  return (prop->input_configured && prop->output_configured &&
+      gst_tensors_info_validate (&prop->input_meta) &&
+      gst_tensors_info_validate (&prop->output_meta));
+}
+
+/**
+ * @brief Run the warm-up invokes with zero-filled inputs (see warmup-iterations).
+ */
+gboolean
+gst_tensor_filter_common_warmup (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop;
+
+  prop = &priv->prop;
+
+  if (priv->warmup_iterations == 0 || !prop->fw_opened)
+    return TRUE;
+
+  gst_tensor_filter_load_tensor_info (priv);
+  if (!_gtfc_warmup_available (prop)) {
+    ml_logw ("The tensor info of the model is not fixed, skip the warm-up.");
+    return TRUE;
+  }
+
+  if (priv->shared_model)
+    return _gtfc_shared_model_warmup (priv);
+
+  return _gtfc_run_warmup (priv, prop, NULL, priv->warmup_iterations,
+      &priv->stat.warmup_time);
+}
+
+/**
+ * @brief Check the tensor info of new framework context is compatible with the running model.
+ */
+static gboolean
+_gtfc_check_context (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, void **private_data)
+{
+  GstTensorsInfo in_info, out_info;
+  gboolean compatible = TRUE;
+  int res_in = -ENOENT, res_out = -ENOENT;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (GST_TF_FW_V1 (priv->fw)) {
+    res_in = res_out = priv->fw->getModelInfo (priv->fw, prop, *private_data,
+        GET_IN_OUT_INFO, &in_info, &out_info);
+  } else {
+    if (priv->fw->getInputDimension)
+      res_in = priv->fw->getInputDimension (prop, private_data, &in_info);
+    if (priv->fw->getOutputDimension)
+      res_out = priv->fw->getOutputDimension (prop, private_data, &out_info);
+  }
+
+  /* the model with flexible tensor info is checked when setting the input info */
+  if (res_in == 0 && prop->input_configured &&
+      !gst_tensors_info_is_equal (&in_info, &prop->input_meta)) {
+    ml_loge ("The input tensor of new model is not compatible.");
+    gst_tensor_filter_compare_tensors (&in_info, &prop->input_meta);
+    compatible = FALSE;
+  }
+
+  if (res_out == 0 && prop->output_configured &&
+      !gst_tensors_info_is_equal (&out_info, &prop->output_meta)) {
+    ml_loge ("The output tensor of new model is not compatible.");
+    gst_tensor_filter_compare_tensors (&out_info, &prop->output_meta);
+    compatible = FALSE;
+  }
+
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return compatible;
+}
+
+/**
+ * @brief Close a framework context of the model loaded in background.
+ */
+static void
+_gtfc_swap_close (GstTensorFilterPrivate * priv,
+    const gchar ** model_files, int num_models, void **private_data)
+{
+  GstTensorFilterProperties prop;
+
+  if (priv->fw && priv->fw->close) {
+    memcpy (&prop, &priv->prop, sizeof (GstTensorFilterProperties));
+    prop.model_files = model_files;
+    prop.num_models = num_models;
+
+    priv->fw->close (&prop, private_data);
+  }
+}
+
+/**
+ * @brief Load new model with a framework context, while the running model keeps invoking the frames.
+ */
+GstTensorFilterModelSwap *
+gst_tensor_filter_common_swap_prepare (GstTensorFilterPrivate * priv,
+    const gchar * model_files, gboolean validate)
+{
+  GstTensorFilterModelSwap *swap;
+  GstTensorFilterProperties prop;
+  gint64 start_time, elapsed;
+
+  g_return_val_if_fail (priv->fw != NULL, NULL);
+  g_return_val_if_fail (model_files != NULL, NULL);
+
+  start_time = g_get_monotonic_time ();
+
+  /* the properties of running model with new model files */
+  memcpy (&prop, &priv->prop, sizeof (GstTensorFilterProperties));
+  prop.model_files = NULL;
+  gst_tensor_filter_parse_modelpaths_string (&prop, model_files);
+
+  swap = g_new0 (GstTensorFilterModelSwap, 1);
+  swap->model_files = prop.model_files;
+  swap->num_models = prop.num_models;
+
+  if (!_gtfc_open_context (priv, &prop, &swap->private_data)) {
+    ml_loge ("Failed to open the model %s.", model_files);
+    goto error;
+  }
+
+  if (!_gtfc_check_context (priv, &prop, &swap->private_data))
+    goto error_close;
+
+  if (validate && _gtfc_warmup_available (&prop)) {
+    if (!_gtfc_run_warmup (priv, &prop, &swap->private_data, 1, &elapsed)) {
+      ml_loge ("Failed to validate the model %s.", model_files);
+      goto error_close;
+    }
+
+    swap->validated = TRUE;
+  }
+
+  swap->load_time = g_get_monotonic_time () - start_time;
+  return swap;
+
+error_close:
+  _gtfc_swap_close (priv, swap->model_files, swap->num_models,
+      &swap->private_data);
+error:
+  g_strfreev_const (swap->model_files);
+  g_free (swap);
+  return NULL;
+}
+
+/**
+ * @brief Replace the running model with the model loaded in background.
+ */
+void
+gst_tensor_filter_common_swap_commit (GstTensorFilterPrivate * priv,
+    GstTensorFilterModelSwap * swap)
+{
+  GstTensorFilterProperties *prop;
+  const gchar **old_files;
+  int old_num;
+  void *old_data;
+
+  g_return_if_fail (swap != NULL);
+
+  prop = &priv->prop;
+  old_files = prop->model_files;
+  old_num = prop->num_models;
+  old_data = priv->privateData;
+
+  priv->privateData = swap->private_data;
+  prop->model_files = swap->model_files;
+  prop->num_models = swap->num_models;
+
+  /* the caller closes the old model with gst_tensor_filter_common_swap_free() */
+  swap->private_data = old_data;
+  swap->model_files = old_files;
+  swap->num_models = old_num;
+
+  /* the latencies of old model are not valid to predict new one */
+  g_mutex_lock (&priv->stat_lock);
+  priv->stat.recent_num = 0;
+  priv->stat.recent_idx = 0;
+  gst_tensor_filter_histogram_reset (&priv->stat.latency_hist);
+  priv->stat.first_frame_latency = -1;
+  g_mutex_unlock (&priv->stat_lock);
+}
+
+/**
+ * @brief Close and free the model loaded in background.
+ */
+void
+gst_tensor_filter_common_swap_free (GstTensorFilterPrivate * priv,
+    GstTensorFilterModelSwap * swap)
+{
+  if (swap == NULL)
+    return;
+
+  _gtfc_swap_close (priv, swap->model_files, swap->num_models,
+      &swap->private_data);
+  g_strfreev_const (swap->model_files);
+  g_free (swap);
+}
+
+/**
+ * @brief Open the instances of NN framework to invoke the frames in parallel.
+ */
+gboolean
+gst_tensor_filter_common_open_instances (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorFilterInstance *instance;
+  guint i;
+
+  prop = &priv->prop;
+
+  if (priv->instances)
+    return TRUE;
+
+  if (!prop->fw_opened || !priv->fw) {
+    nns_loge ("The framework is not opened, cannot open the instances.");
+    return FALSE;
+  }
+
+  g_mutex_lock (&priv->instances_lock);
+  priv->instances = g_new0 (GstTensorFilterInstance, priv->num_instances);
+  priv->instances_len = priv->num_instances;
+  priv->instances_start_time = g_get_real_time ();
+  g_mutex_unlock (&priv->instances_lock);
+
+  /* the first instance is the one opened by tensor-filter */
+  priv->instances[0].opened = TRUE;
+
+  for (i = 1; i < priv->instances_len; i++) {
+    instance = &priv->instances[i];
+
+    /* open the instance and set the input info same as the first one */
+    if (!_gtfc_open_context (priv, prop, &instance->privateData)) {
+      nns_loge ("Failed to open the instance %u of %s.", i,
+          GST_STR_NULL (prop->fwname));
+      goto error;
+    }
+
+    instance->opened = TRUE;
+
+    /* the worker invokes the first frame without the initialization overhead */
+    if (priv->warmup_iterations > 0 && _gtfc_warmup_available (prop)) {
+      gint64 elapsed;
+
+      if (!_gtfc_run_warmup (priv, prop, &instance->privateData,
+              priv->warmup_iterations, &elapsed))
+        nns_logw ("Failed to run the warm-up invokes of the instance %u.", i);
+    }
+  }
+
+  return TRUE;
+
+error:
+  gst_tensor_filter_common_close_instances (priv);
+  return FALSE;
+}
+
+/**
+ * @brief Close the instances of NN framework.
+ */
+void
+gst_tensor_filter_common_close_instances (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterInstance *instances, *instance;
+  guint i, len;
+
+  g_mutex_lock (&priv->instances_lock);
+  instances = priv->instances;
+  len = priv->instances_len;
+  priv->instances = NULL;
+  priv->instances_len = 0;
+  g_mutex_unlock (&priv->instances_lock);
+
+  if (!instances)
+    return;
+
+  /* the first instance is closed with tensor-filter */
+  for (i = 1; i < len; i++) {
+    instance = &instances[i];
+
+    if (instance->opened && priv->fw && priv->fw->close)
+      priv->fw->close (&priv->prop, &instance->privateData);
+  }
+
+  g_free (instances);
+}
+
+/**
+ * @brief Close NN framework.
+ */
+void
+gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
+{
+  gst_tensor_filter_common_close_instances (priv);
+
   if (priv->prop.fw_opened) {
-    if (priv->fw && priv->fw->close) {
+    if (priv->shared_model) {
+      _gtfc_shared_model_detach (priv);
+    } else if (priv->fw && priv->fw->close) {
       priv->fw->close (&priv->prop, &priv->privateData);
     }
     priv->prop.input_configured = priv->prop.output_configured = FALSE;
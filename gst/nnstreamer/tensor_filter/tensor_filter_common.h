@@ -40,16 +40,21 @@
 #define GST_TF_FW_VN(fw, vn) \
     (fw && checkGstTensorFilterFrameworkVersion (fw->version, vn))
 #define GST_TF_FW_V0(fw) GST_TF_FW_VN (fw, 0)
-#define GST_TF_FW_V1(fw) GST_TF_FW_VN (fw, 1)
+#define GST_TF_FW_V1(fw) (GST_TF_FW_VN (fw, 1) || GST_TF_FW_V2 (fw))
+#define GST_TF_FW_V2(fw) GST_TF_FW_VN (fw, 2)
 
 /**
  * @brief Invoke callbacks of nn framework. Guarantees calling open for the first call.
+ * @note The context is checked out from the pool if the model is shared.
  */
 #define gst_tensor_filter_v0_call(priv,ret,funcname,...) do { \
       gst_tensor_filter_common_open_fw (priv); \
       ret = -1; \
       if ((priv)->prop.fw_opened && (priv)->fw && (priv)->fw->funcname) { \
-        ret = (priv)->fw->funcname (&(priv)->prop, &(priv)->privateData, __VA_ARGS__); \
+        gpointer _handle; \
+        void **_data = gst_tensor_filter_common_get_context ((priv), &_handle); \
+        ret = (priv)->fw->funcname (&(priv)->prop, _data, __VA_ARGS__); \
+        gst_tensor_filter_common_put_context ((priv), _handle); \
       } \
     } while (0)
 
@@ -57,12 +62,17 @@
       gst_tensor_filter_common_open_fw (priv); \
       ret = -1; \
       if ((priv)->prop.fw_opened && (priv)->fw && (priv)->fw->funcname) { \
-        ret = (priv)->fw->funcname ((priv)->fw, &(priv)->prop, (priv)->privateData, __VA_ARGS__); \
+        gpointer _handle; \
+        void **_data = gst_tensor_filter_common_get_context ((priv), &_handle); \
+        ret = (priv)->fw->funcname ((priv)->fw, &(priv)->prop, *_data, __VA_ARGS__); \
+        gst_tensor_filter_common_put_context ((priv), _handle); \
       } \
     } while (0)
 
 #define GST_TF_FW_INVOKE_COMPAT(priv,ret,in,out) do { \
-      if (GST_TF_FW_V0 ((priv)->fw)) { \
+      if ((priv)->shared_model) { \
+        ret = gst_tensor_filter_common_invoke_shared ((priv), &(priv)->prop, (in), (out)); \
+      } else if (GST_TF_FW_V0 ((priv)->fw)) { \
         ret = priv->fw->invoke_NN (&(priv)->prop, &(priv)->privateData, (in), (out)); \
       } else if (GST_TF_FW_V1 ((priv)->fw)) { \
         ret = priv->fw->invoke ((priv)->fw, &(priv)->prop, (priv)->privateData, (in), (out)); \
@@ -71,8 +81,92 @@
       } \
     } while (0)
 
+/**
+ * @brief GstTensorFilter properties (the property id of tensor-filter and tensor-filter-single).
+ */
+enum
+{
+  PROP_0,
+  PROP_SILENT,
+  PROP_FRAMEWORK,
+  PROP_MODEL,
+  PROP_INPUT,
+  PROP_INPUTTYPE,
+  PROP_INPUTNAME,
+  PROP_INPUTLAYOUT,
+  PROP_INPUTRANKS,
+  PROP_OUTPUT,
+  PROP_OUTPUTTYPE,
+  PROP_OUTPUTNAME,
+  PROP_OUTPUTLAYOUT,
+  PROP_OUTPUTRANKS,
+  PROP_CUSTOM,
+  PROP_SUBPLUGINS,
+  PROP_ACCELERATOR,
+  PROP_IS_UPDATABLE,
+  PROP_LATENCY,
+  PROP_THROUGHPUT,
+  PROP_INPUTCOMBINATION,
+  PROP_OUTPUTCOMBINATION,
+  PROP_SHARED_TENSOR_FILTER_KEY,
+  PROP_OUTPUT_POOL_SIZE,
+  PROP_OUTPUT_POOL_MIN_BUFFERS,
+  PROP_OUTPUT_POOL_HITS,
+  PROP_OUTPUT_POOL_MISSES,
+  PROP_INPUT_ALIGNMENT,
+  PROP_MAX_INFLIGHT,
+  PROP_BATCH_SIZE,
+  PROP_BATCH_TIMEOUT,
+  PROP_NUM_INSTANCES,
+  PROP_INSTANCE_UTILIZATION,
+  PROP_LATENCY_P50,
+  PROP_LATENCY_P90,
+  PROP_LATENCY_P99,
+  PROP_LATENCY_MAX,
+  PROP_LATENCY_REPORT_INTERVAL,
+  PROP_SHARED_POOL_SIZE,
+  PROP_SHARED_POOL_STATS,
+  PROP_INVOKE_CACHE,
+  PROP_INVOKE_CACHE_SIZE,
+  PROP_INVOKE_CACHE_HITS,
+  PROP_INVOKE_CACHE_MISSES,
+  PROP_DEADLINE,
+  PROP_DEADLINE_DROPPED,
+  PROP_WARMUP_ITERATIONS,
+  PROP_PRELOAD,
+  PROP_WARMUP_TIME,
+  PROP_FIRST_FRAME_LATENCY,
+  PROP_HOT_SWAP,
+  PROP_HOT_SWAP_VALIDATE,
+  PROP_CPU_AFFINITY,
+  PROP_SCHED_PRIORITY,
+  PROP_FRAMEWORK_STATS,
+  PROP_CONTEXT_POOL_SIZE,
+  PROP_OUTPUT_CACHE_SIZE,
+};
+
 #define GST_TF_STAT_MAX_RECENT (10)
 
+/**
+ * @brief Definitions for the log-linear histogram of latencies.
+ * Each power-of-2 range is divided into GST_TF_HIST_SUB_BUCKETS linear buckets, so the relative error of the percentile is less than 1/GST_TF_HIST_SUB_BUCKETS.
+ */
+#define GST_TF_HIST_SUB_BITS (4)
+#define GST_TF_HIST_SUB_BUCKETS (1 << GST_TF_HIST_SUB_BITS)
+#define GST_TF_HIST_MAX_BITS (36) /* up to 2^36 usec (about 19 hours) */
+#define GST_TF_HIST_NUM_BUCKETS \
+    (GST_TF_HIST_SUB_BUCKETS * (GST_TF_HIST_MAX_BITS - GST_TF_HIST_SUB_BITS + 1))
+
+/**
+ * @brief Structure definition for the histogram of latencies (fixed size, no allocation to record)
+ */
+typedef struct _GstTensorFilterHistogram
+{
+  guint64 counts[GST_TF_HIST_NUM_BUCKETS]; /**< number of recorded values in each bucket */
+  guint64 total; /**< number of recorded values */
+  gint64 max; /**< the max recorded value */
+} GstTensorFilterHistogram;
+
 /**
  * @brief Structure definition for tensor-filter statistics
  */
@@ -83,9 +177,31 @@ typedef struct _GstTensorFilterStatistics
   gint64 old_total_invoke_num;      /**< cached value. number of total invokes */
   gint64 old_total_invoke_latency;  /**< cached value. accumulated invoke latency (usec) */
   gint64 latest_invoke_time;    /**< the latest invoke time (usec) */
-  void *recent_latencies;       /**< data structure (e.g., queue) to hold recent latencies */
+  gint64 recent_latencies[GST_TF_STAT_MAX_RECENT]; /**< ring buffer to hold recent latencies (usec) */
+  guint recent_num;             /**< number of recent latencies in the ring buffer */
+  guint recent_idx;             /**< index in the ring buffer to hold the next latency */
+  GstTensorFilterHistogram latency_hist; /**< histogram of invoke latencies since the last reset */
+  gint64 latest_report_time;    /**< the latest time to post the latency report (usec) */
+  guint64 pool_hits;            /**< number of output memories acquired from the buffer pool */
+  guint64 pool_misses;          /**< number of output memories allocated as the pool was unavailable or exhausted */
+  guint64 cache_hits;           /**< number of frames whose output is found in the invoke cache */
+  guint64 cache_misses;         /**< number of frames invoked because the output is not in the invoke cache */
+  guint64 deadline_dropped;     /**< number of frames dropped because they would miss the deadline */
+  gint64 warmup_time;           /**< time to run the warm-up invokes (usec) */
+  gint64 first_frame_latency;   /**< invoke latency of the first frame after the warm-up (usec, -1 if not invoked) */
 } GstTensorFilterStatistics;
 
+/**
+ * @brief Structure definition for an instance of NN framework invoking the frames in parallel.
+ */
+typedef struct _GstTensorFilterInstance
+{
+  void *privateData; /**< NNFW plugin's private data of this instance (the first instance uses the private data of tensor-filter) */
+  gboolean opened; /**< True if this instance is opened */
+  gint64 total_invoke_num; /**< number of invokes in this instance (updated atomically by the worker) */
+  gint64 total_invoke_latency; /**< accumulated invoke latency in this instance (usec, updated atomically by the worker) */
+} GstTensorFilterInstance;
+
 /**
  * @brief Structure definition for tensor-filter in/out combination
  */
@@ -99,6 +215,23 @@ typedef struct _GstTensorFilterCombination
   gboolean out_combi_o_defined;/**< True if output combination from model output is defined */
 } GstTensorFilterCombination;
 
+/**
+ * @brief Shared model representation with a pool of framework contexts (see shared-tensor-filter-key).
+ */
+typedef struct _GstTensorFilterSharedModel GstTensorFilterSharedModel;
+
+/**
+ * @brief Structure definition for the model loaded in background to replace the running model (see hot-swap).
+ */
+typedef struct _GstTensorFilterModelSwap
+{
+  const gchar **model_files; /**< The new model files */
+  int num_models; /**< The number of the new model files */
+  void *private_data; /**< NNFW plugin's private data opened with the new model */
+  gboolean validated; /**< TRUE if the new model is validated with the warm-up invoke */
+  gint64 load_time; /**< The time to load the new model in background (usec) */
+} GstTensorFilterModelSwap;
+
 /**
  * @brief Structure definition for common tensor-filter properties.
  */
@@ -108,6 +241,7 @@ typedef struct _GstTensorFilterPrivate
   GstTensorFilterProperties prop; /**< NNFW plugin's properties */
   GstTensorFilterFrameworkInfo info; /**< NNFW framework info */
   GstTensorFilterStatistics stat; /**< NNFW plugin's statistics */
+  GMutex stat_lock; /**< lock for the latency statistics (the recent latencies and the histogram), which are recorded and read in different threads */
   const GstTensorFilterFramework *fw; /**< The implementation core of the NNFW. NULL if not configured */
 
   /* internal properties for tensor-filter */
@@ -119,14 +253,80 @@ typedef struct _GstTensorFilterPrivate
 
   gint latency_mode;     /**< latency profiling mode (0: off, 1: on, ...) */
   gint throughput_mode;  /**< throughput profiling mode (0: off, 1: on, ...) */
+  guint latency_report_interval; /**< interval (ms) to post the latency percentiles on the bus (0: off) */
+  guint deadline; /**< budget (ms) from the buffer timestamp to complete the invoke (0: off) */
+
+  guint warmup_iterations; /**< number of invokes with zero-filled inputs after opening the framework */
+  gboolean preload; /**< TRUE to open the framework in background thread while the pipeline is starting */
+
+  gboolean hot_swap; /**< TRUE to load new model in background thread and swap it at a frame boundary */
+  gboolean hot_swap_validate; /**< TRUE to validate new model with the warm-up invoke before swapping */
+
+  GArray *cpu_affinity; /**< the CPU cores (guint) to run the threads invoking the model (NULL if not assigned) */
+  gint sched_priority; /**< the scheduling priority of the threads invoking the model (0: unchanged) */
+  gint policy_serial; /**< incremented when the thread policy is updated */
+  GMutex policy_lock; /**< lock for the thread policy (cpu_affinity, sched_priority and policy_threads) */
+  GArray *policy_threads; /**< the threads applied the policy with their old policy, to restore at stop */
 
   GstClockTime prev_ts;  /**< previous timestamp */
   GstClockTimeDiff throttling_delay;  /**< throttling delay from tensor rate */
   GstClockTimeDiff throttling_accum;  /**< accumulated frame durations for throttling */
 
   GstTensorFilterCombination combi;
+
+  guint pool_size; /**< max number of buffers in each output buffer pool (0 to disable the pool) */
+  guint pool_min_buffers; /**< number of buffers preallocated in each output buffer pool */
+  GstBufferPool *out_pool[NNS_TENSOR_SIZE_LIMIT]; /**< buffer pool for each output tensor */
+  GstBufferPool *batch_out_pool[NNS_TENSOR_SIZE_LIMIT]; /**< buffer pool for each batched output tensor (micro-batching) */
+  guint input_alignment; /**< memory alignment (in bytes) of the input tensor proposed to upstream (0 not to propose) */
+
+  guint max_inflight; /**< max number of frames in flight with asynchronous invoke (0 to invoke synchronously) */
+
+  guint batch_size; /**< number of frames to be invoked at once (1 to disable micro-batching) */
+  guint batch_timeout; /**< timeout (in milliseconds) to invoke the incomplete batch (0 to wait for the batch) */
+  guint batch_configured; /**< batch size set to the model (0 if micro-batching is not configured) */
+  gboolean batch_invoke; /**< TRUE if the subplugin invokes the frames in a batch with the callback 'invoke_batch' */
+  GstTensorsInfo batch_in_info; /**< batched input tensor info */
+  GstTensorsInfo batch_out_info; /**< batched output tensor info */
+
+  guint num_instances; /**< number of instances of NN framework invoking the frames in parallel */
+  GstTensorFilterInstance *instances; /**< the instances of NN framework (NULL if not opened) */
+  guint instances_len; /**< number of the opened instances */
+  GMutex instances_lock; /**< lock for the instances, the array is released while reading the statistics */
+  gint64 instances_start_time; /**< the time when the instances are opened (usec) */
+
+  gboolean invoke_cache; /**< TRUE to skip the invoke if the output of the same input is cached */
+  guint64 invoke_cache_size; /**< max size of the cached outputs in bytes */
+
+  guint shared_pool_size; /**< number of framework contexts added to the pool of the shared model */
+  guint shared_pool_share; /**< number of framework contexts added to the pool when attached to the shared model */
+  GstTensorFilterSharedModel *shared_model; /**< the shared model (NULL if the model is not shared) */
+  guint private_pool_size; /**< max number of framework contexts of the model not shared (single-shot context-pool-size, 0 not to pool the contexts) */
 } GstTensorFilterPrivate;
 
+/**
+ * @brief Reset the histogram of latencies.
+ */
+extern void
+gst_tensor_filter_histogram_reset (GstTensorFilterHistogram * hist);
+
+/**
+ * @brief Record the latency (usec) in the histogram.
+ */
+extern void
+gst_tensor_filter_histogram_record (GstTensorFilterHistogram * hist,
+    gint64 value);
+
+/**
+ * @brief Get the percentile of the recorded latencies.
+ * @param[in] hist The histogram of latencies
+ * @param[in] percentile The percentile to get (0 < percentile <= 100)
+ * @return The upper bound of the bucket including the percentile (usec), -1 if no value is recorded
+ */
+extern gint64
+gst_tensor_filter_histogram_get_percentile (const GstTensorFilterHistogram * hist,
+    gdouble percentile);
+
 /**
  * @brief Printout the comparison results of two tensors.
  * @param[in] info1 The tensors to be shown on the left hand side
@@ -208,6 +408,17 @@ extern gboolean
 gst_tensor_filter_common_get_out_info (GstTensorFilterPrivate * priv,
     GstTensorsInfo * in, GstTensorsInfo * out);
 
+/**
+ * @brief Configure the micro-batching. If the subplugin supports the batched invoke, the frames are passed without stacking.
+ * Otherwise, configure the batched tensor info, stacking the frames along the outermost dimension.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] batch_size The number of frames to be invoked at once (1 to disable micro-batching)
+ * @return TRUE if the model accepts the batched input info
+ */
+extern gboolean
+gst_tensor_filter_common_configure_batch (GstTensorFilterPrivate * priv,
+    guint batch_size);
+
 /**
  * @brief Load tensor info from NN model.
  * (both input and output tensor)
@@ -225,6 +436,141 @@ extern void gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv);
  */
 extern void gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv);
 
+/**
+ * @brief Open the instances of NN framework to invoke the frames in parallel.
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if all instances are opened
+ */
+extern gboolean
+gst_tensor_filter_common_open_instances (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Close the instances of NN framework.
+ * @param[in] priv Struct containing the properties of the object
+ */
+extern void
+gst_tensor_filter_common_close_instances (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Get the context of NN framework to call the subplugin.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[out] handle The handle to release the context
+ * @return The pointer to the private data of the framework context
+ * @note The context is checked out from the pool if the model is shared, release it with gst_tensor_filter_common_put_context().
+ */
+extern void **
+gst_tensor_filter_common_get_context (GstTensorFilterPrivate * priv,
+    gpointer * handle);
+
+/**
+ * @brief Release the context of NN framework.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] handle The handle given by gst_tensor_filter_common_get_context()
+ */
+extern void
+gst_tensor_filter_common_put_context (GstTensorFilterPrivate * priv,
+    gpointer handle);
+
+/**
+ * @brief Notify the context of NN framework is updated (e.g., input info, model files, or properties).
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] handle The handle given by gst_tensor_filter_common_get_context()
+ * @param[in] input_info The input info set to the context (NULL if not changed)
+ * @param[in] model_files The model files reloaded (NULL if not changed)
+ * @note If the model is shared, other contexts in the pool are closed and opened again with new info.
+ */
+extern void
+gst_tensor_filter_common_update_context (GstTensorFilterPrivate * priv,
+    gpointer handle, const GstTensorsInfo * input_info,
+    const gchar ** model_files);
+
+/**
+ * @brief Invoke the shared model with a framework context checked out from the pool.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] prop The properties to invoke the model
+ * @param[in] input The input tensors
+ * @param[out] output The output tensors
+ * @return 0 if OK. Non-zero if error.
+ * @note This waits until a context is available if all contexts in the pool are busy.
+ */
+extern gint
+gst_tensor_filter_common_invoke_shared (GstTensorFilterPrivate * priv,
+    const GstTensorFilterProperties * prop, const GstTensorMemory * input,
+    GstTensorMemory * output);
+
+/**
+ * @brief Check the subplugin supports the batched invoke (invoke_batch) with the opened model.
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if the subplugin accepts several frames at once
+ */
+extern gboolean
+gst_tensor_filter_common_batch_invoke_available (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Invoke the frames at once with the subplugin callback 'invoke_batch'.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] num_frames The number of frames
+ * @param[in] input The input tensors of each frame
+ * @param[out] output The output tensors of each frame
+ * @return 0 if OK. Non-zero if error.
+ * @note The frames are invoked one by one if the subplugin does not support the batched invoke.
+ */
+extern gint
+gst_tensor_filter_common_invoke_batch (GstTensorFilterPrivate * priv,
+    guint num_frames, const GstTensorMemory ** input,
+    GstTensorMemory ** output);
+
+/**
+ * @brief Apply the CPU affinity and scheduling priority to current thread invoking the model.
+ * @param[in] priv Struct containing the properties of the object
+ * @note The policy is applied once for each thread, unless the properties are updated. The old policy of the thread is saved to be restored.
+ */
+extern void
+gst_tensor_filter_common_apply_thread_policy (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Restore the old policy of the threads applied the CPU affinity and scheduling priority.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] current TRUE to restore current thread only (e.g., the thread is going to exit), FALSE to restore all threads
+ */
+extern void
+gst_tensor_filter_common_restore_thread_policy (GstTensorFilterPrivate * priv,
+    gboolean current);
+
+/**
+ * @brief Run the warm-up invokes with zero-filled inputs (see warmup-iterations).
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if there is no error. The warm-up is skipped if the framework is not opened or the tensor info is not fixed.
+ */
+extern gboolean
+gst_tensor_filter_common_warmup (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Load new model with a framework context, while the running model keeps invoking the frames.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] model_files The new model files (comma-separated)
+ * @param[in] validate TRUE to validate the new model with the warm-up invoke
+ * @return The model to be swapped (NULL if failed to load or the tensor info is not compatible). Call gst_tensor_filter_common_swap_commit() or gst_tensor_filter_common_swap_free().
+ */
+extern GstTensorFilterModelSwap *
+gst_tensor_filter_common_swap_prepare (GstTensorFilterPrivate * priv, const gchar * model_files, gboolean validate);
+
+/**
+ * @brief Replace the running model with the model loaded in background. Call this at a frame boundary.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in,out] swap The model loaded in background, replaced with the old model. Close it with gst_tensor_filter_common_swap_free().
+ */
+extern void
+gst_tensor_filter_common_swap_commit (GstTensorFilterPrivate * priv, GstTensorFilterModelSwap * swap);
+
+/**
+ * @brief Close and free the model loaded in background.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] swap The model loaded in background
+ */
+extern void
+gst_tensor_filter_common_swap_free (GstTensorFilterPrivate * priv, GstTensorFilterModelSwap * swap);
+
 /**
  * @brief Get neural network framework name from given model file. This does not guarantee the framework is available on the target device.
  * @param[in] model_files the prediction model paths
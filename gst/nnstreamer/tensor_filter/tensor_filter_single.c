@@ -34,6 +34,22 @@
  * The input and output are always in the format of other/tensor or
  * other/tensors. This element is going to be the basis of single shot api.
  *
+ * The instance can be invoked from several threads, but by default (the
+ * property "context-pool-size" is 1) the invokes wait for each other on one
+ * framework context. With "context-pool-size" larger than 1, the instance
+ * keeps a pool of framework contexts of the model (lazily opened up to the
+ * pool size) and each invoke checks out an idle context, so that the invokes
+ * run at once. Changing the input info waits until the running invokes are
+ * done. The output tensors allocated in invoke can be given back with
+ * release_output(), to be reused for the next invoke (up to the property
+ * "output-cache-size" for each tensor).
+ *
+ * For the loop invoking the model repeatedly, the application can register
+ * the input and output buffers once with register_buffers(). The buffers are
+ * validated with the tensor info when registered, and invoke_registered()
+ * runs the model with the buffers of given handle without the validation
+ * and the allocation for each call.
+ *
  */
 
 #ifdef HAVE_CONFIG_H
@@ -46,6 +62,16 @@
 #include "tensor_filter_common.h"
 #include "tensor_filter_single.h"
 
+/**
+ * @brief Default number of the framework contexts of the model, the invokes wait for each other.
+ */
+#define DEFAULT_CONTEXT_POOL_SIZE (1)
+
+/**
+ * @brief Default number of the released output data of each tensor, to be reused in invoke.
+ */
+#define DEFAULT_OUTPUT_CACHE_SIZE (4)
+
 /**
  * @brief Private data struct for tensor-filter single class.
  */
@@ -53,8 +79,28 @@ typedef struct _GTensorFilterSinglePrivate
 {
   GstTensorFilterPrivate filter_priv; /**< Internal properties for tensor-filter */
   gboolean allocate_in_invoke;  /**< cached value after first invoke */
+  GMutex lock; /**< lock to start/stop the filter and to access the output pool */
+  GRWLock invoke_lock; /**< lock to invoke (reader) against changing the input info (writer) */
+  GMutex serial_lock; /**< lock to invoke one by one, if the framework contexts are not pooled */
+  GQueue out_pool[NNS_TENSOR_SIZE_LIMIT]; /**< released output data of each tensor, to be reused in invoke */
+  guint out_pool_size; /**< max number of the released output data of each tensor (output-cache-size) */
+  GHashTable *buffers; /**< registered buffer sets (handle to GTensorFilterSingleBuffers) */
+  guint last_handle; /**< the last handle of the registered buffer set */
 } GTensorFilterSinglePrivate;
 
+/**
+ * @brief Data struct for the registered input and output buffers.
+ */
+typedef struct _GTensorFilterSingleBuffers
+{
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT]; /**< registered input tensors */
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT]; /**< registered output tensors */
+  guint num_outputs; /**< the number of output tensors */
+  gboolean allocated; /**< TRUE if the output is allocated when registered */
+  gboolean valid; /**< FALSE if the tensor info is changed after registered */
+  gint busy; /**< 1 while invoking the buffers */
+} GTensorFilterSingleBuffers;
+
 #define G_TENSOR_FILTER_SINGLE_PRIV(obj) ((GTensorFilterSinglePrivate *) (obj)->priv)
 
 #define g_tensor_filter_single_parent_class parent_class
@@ -69,8 +115,14 @@ static void g_tensor_filter_single_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec);
 
 /* GTensorFilterSingle method implementations */
+static gboolean g_tensor_filter_single_invoke_internal (GTensorFilterSingle *
+    self, const GstTensorMemory * input, GstTensorMemory * output,
+    gboolean allocate);
 static gboolean g_tensor_filter_single_invoke (GTensorFilterSingle * self,
     const GstTensorMemory * input, GstTensorMemory * output, gboolean allocate);
+static gboolean g_tensor_filter_single_invoke_batch (GTensorFilterSingle *
+    self, guint num_frames, const GstTensorMemory ** input,
+    GstTensorMemory ** output);
 static gboolean g_tensor_filter_input_configured (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_output_configured (GTensorFilterSingle * self);
 static gint g_tensor_filter_set_input_info (GTensorFilterSingle * self,
@@ -80,6 +132,18 @@ static void g_tensor_filter_destroy_notify (GTensorFilterSingle * self,
 static gboolean g_tensor_filter_allocate_in_invoke (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_start (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_stop (GTensorFilterSingle * self);
+static void g_tensor_filter_single_release_output (GTensorFilterSingle * self,
+    GstTensorMemory * output);
+static guint g_tensor_filter_single_register_buffers (GTensorFilterSingle *
+    self, const GstTensorMemory * input, GstTensorMemory * output,
+    gboolean allocate);
+static gboolean g_tensor_filter_single_invoke_registered (GTensorFilterSingle *
+    self, guint handle);
+static void g_tensor_filter_single_unregister_buffers (GTensorFilterSingle *
+    self, guint handle);
+static void g_tensor_filter_single_free_buffers (gpointer data);
+static void g_tensor_filter_single_invalidate_buffers (gpointer key,
+    gpointer value, gpointer user_data);
 
 /**
  * @brief initialize the tensor_filter's class
@@ -97,7 +161,25 @@ g_tensor_filter_single_class_init (GTensorFilterSingleClass * klass)
 
   gst_tensor_filter_install_properties (gobject_class);
 
+  g_object_class_install_property (gobject_class, PROP_CONTEXT_POOL_SIZE,
+      g_param_spec_uint ("context-pool-size", "Context pool size",
+          "The max number of framework contexts of the model, opened on "
+          "demand. Each invoke checks out an idle context, so that the "
+          "callers invoke concurrently. With 1, the invokes wait for each "
+          "other. This is not applied if the model is shared with "
+          "shared-tensor-filter-key (see shared-pool-size).",
+          1, G_MAXUINT, DEFAULT_CONTEXT_POOL_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_CACHE_SIZE,
+      g_param_spec_uint ("output-cache-size", "Output cache size",
+          "The max number of the output data given back with release_output() "
+          "for each output tensor, to be reused in the next invoke. "
+          "Set 0 to free the released output.",
+          0, G_MAXUINT, DEFAULT_OUTPUT_CACHE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   klass->invoke = g_tensor_filter_single_invoke;
+  klass->invoke_batch = g_tensor_filter_single_invoke_batch;
   klass->start = g_tensor_filter_single_start;
   klass->stop = g_tensor_filter_single_stop;
   klass->input_configured = g_tensor_filter_input_configured;
@@ -105,6 +187,10 @@ g_tensor_filter_single_class_init (GTensorFilterSingleClass * klass)
   klass->set_input_info = g_tensor_filter_set_input_info;
   klass->destroy_notify = g_tensor_filter_destroy_notify;
   klass->allocate_in_invoke = g_tensor_filter_allocate_in_invoke;
+  klass->release_output = g_tensor_filter_single_release_output;
+  klass->register_buffers = g_tensor_filter_single_register_buffers;
+  klass->invoke_registered = g_tensor_filter_single_invoke_registered;
+  klass->unregister_buffers = g_tensor_filter_single_unregister_buffers;
 }
 
 /**
@@ -115,6 +201,7 @@ g_tensor_filter_single_init (GTensorFilterSingle * self)
 {
   GTensorFilterSinglePrivate *spriv;
   GstTensorFilterPrivate *priv;
+  guint i;
 
   self->priv = g_type_instance_get_private ((GTypeInstance *) self,
       G_TYPE_TENSOR_FILTER_SINGLE);
@@ -123,6 +210,35 @@ g_tensor_filter_single_init (GTensorFilterSingle * self)
 
   gst_tensor_filter_common_init_property (priv);
   spriv->allocate_in_invoke = FALSE;
+
+  /* pool the framework contexts to invoke from several threads */
+  priv->private_pool_size = DEFAULT_CONTEXT_POOL_SIZE;
+  spriv->out_pool_size = DEFAULT_OUTPUT_CACHE_SIZE;
+
+  g_mutex_init (&spriv->lock);
+  g_rw_lock_init (&spriv->invoke_lock);
+  g_mutex_init (&spriv->serial_lock);
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    g_queue_init (&spriv->out_pool[i]);
+
+  spriv->buffers = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, g_tensor_filter_single_free_buffers);
+  spriv->last_handle = 0;
+}
+
+/**
+ * @brief Free the output data in the pool.
+ */
+static void
+g_tensor_filter_single_flush_output_pool (GTensorFilterSinglePrivate * spriv)
+{
+  gpointer data;
+  guint i;
+
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    while ((data = g_queue_pop_head (&spriv->out_pool[i])) != NULL)
+      g_free (data);
+  }
 }
 
 /**
@@ -146,6 +262,12 @@ g_tensor_filter_single_finalize (GObject * object)
 
   gst_tensor_filter_common_free_property (priv);
 
+  g_tensor_filter_single_flush_output_pool (spriv);
+  g_hash_table_destroy (spriv->buffers);
+  g_mutex_clear (&spriv->lock);
+  g_rw_lock_clear (&spriv->invoke_lock);
+  g_mutex_clear (&spriv->serial_lock);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -166,8 +288,21 @@ g_tensor_filter_single_set_property (GObject * object, guint prop_id,
 
   g_debug ("Setting property for prop %d.\n", prop_id);
 
-  if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  switch (prop_id) {
+    case PROP_CONTEXT_POOL_SIZE:
+      /* applied when the framework is opened */
+      priv->private_pool_size = g_value_get_uint (value);
+      break;
+    case PROP_OUTPUT_CACHE_SIZE:
+      g_mutex_lock (&spriv->lock);
+      spriv->out_pool_size = g_value_get_uint (value);
+      g_mutex_unlock (&spriv->lock);
+      break;
+    default:
+      if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 /**
@@ -187,8 +322,18 @@ g_tensor_filter_single_get_property (GObject * object, guint prop_id,
 
   g_debug ("Getting property for prop %d.\n", prop_id);
 
-  if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  switch (prop_id) {
+    case PROP_CONTEXT_POOL_SIZE:
+      g_value_set_uint (value, priv->private_pool_size);
+      break;
+    case PROP_OUTPUT_CACHE_SIZE:
+      g_value_set_uint (value, spriv->out_pool_size);
+      break;
+    default:
+      if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
+        G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 /**
@@ -254,17 +399,25 @@ g_tensor_filter_single_start (GTensorFilterSingle * self)
   if (G_UNLIKELY (priv->fw == NULL))
     return FALSE;
 
+  g_mutex_lock (&spriv->lock);
+
+  /* the filter may be started by other thread */
+  if (priv->configured)
+    goto done;
+
   gst_tensor_filter_common_open_fw (priv);
 
   if (G_UNLIKELY (!priv->prop.fw_opened))
-    return FALSE;
+    goto done;
 
   gst_tensor_filter_load_tensor_info (priv);
   spriv->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
 
   priv->configured = TRUE;
 
-  return TRUE;
+done:
+  g_mutex_unlock (&spriv->lock);
+  return priv->configured;
 }
 
 /**
@@ -282,10 +435,76 @@ g_tensor_filter_single_stop (GTensorFilterSingle * self)
   priv = &spriv->filter_priv;
 
   /** close framework, unload model */
+  g_mutex_lock (&spriv->lock);
   gst_tensor_filter_common_close_fw (priv);
+  g_tensor_filter_single_flush_output_pool (spriv);
+  g_mutex_unlock (&spriv->lock);
   return TRUE;
 }
 
+/**
+ * @brief Get the output data from the pool or allocate new one.
+ */
+static gpointer
+g_tensor_filter_single_alloc_output (GTensorFilterSinglePrivate * spriv,
+    guint index, gsize size)
+{
+  GstTensorFilterPrivate *priv = &spriv->filter_priv;
+  gpointer data = NULL;
+
+  /* the pool has the data of the output tensor size only */
+  if (size == gst_tensors_info_get_size (&priv->prop.output_meta, index)) {
+    g_mutex_lock (&spriv->lock);
+    data = g_queue_pop_head (&spriv->out_pool[index]);
+    g_mutex_unlock (&spriv->lock);
+
+    if (data)
+      __atomic_fetch_add (&priv->stat.pool_hits, 1, __ATOMIC_RELAXED);
+    else
+      __atomic_fetch_add (&priv->stat.pool_misses, 1, __ATOMIC_RELAXED);
+  }
+
+  if (data == NULL)
+    data = g_try_malloc (size);
+
+  return data;
+}
+
+/**
+ * @brief Called when the application does not need the output allocated in invoke.
+ * @param self "this" pointer
+ * @param output the output tensors allocated in invoke, which can be reused
+ * @note The output data is allocated with g_malloc(), the application may free it without this.
+ */
+static void
+g_tensor_filter_single_release_output (GTensorFilterSingle * self,
+    GstTensorMemory * output)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  guint i;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  g_mutex_lock (&spriv->lock);
+  for (i = 0; i < priv->prop.output_meta.num_tensors; i++) {
+    if (output[i].data == NULL)
+      continue;
+
+    if (priv->configured &&
+        output[i].size == gst_tensors_info_get_size (&priv->prop.output_meta, i) &&
+        g_queue_get_length (&spriv->out_pool[i]) < spriv->out_pool_size) {
+      g_queue_push_tail (&spriv->out_pool[i], output[i].data);
+    } else {
+      g_free (output[i].data);
+    }
+
+    output[i].data = NULL;
+  }
+  g_mutex_unlock (&spriv->lock);
+}
+
 /**
  * @brief Called to notify the framework to destroy the allocated memory
  * @param self "this" pointer
@@ -309,15 +528,10 @@ g_tensor_filter_destroy_notify (GTensorFilterSingle * self,
 }
 
 /**
- * @brief Called when an input supposed to be invoked
- * @param self "this" pointer
- * @param input memory containing input data to run processing on
- * @param output memory to put output data into after processing
- * @param allocate true to allocate output data (false means tensor data is already allocated)
- * @return TRUE if there is no error.
+ * @brief Invoke the filter, the caller should hold the invoke lock.
  */
 static gboolean
-g_tensor_filter_single_invoke (GTensorFilterSingle * self,
+g_tensor_filter_single_invoke_internal (GTensorFilterSingle * self,
     const GstTensorMemory * input, GstTensorMemory * output, gboolean allocate)
 {
   GTensorFilterSinglePrivate *spriv;
@@ -355,7 +569,8 @@ g_tensor_filter_single_invoke (GTensorFilterSingle * self,
     /* allocate memory if allocate_in_invoke is FALSE */
     if (allocate) {
       for (i = 0; i < priv->prop.output_meta.num_tensors; i++) {
-        output[i].data = g_try_malloc (output[i].size);
+        output[i].data = g_tensor_filter_single_alloc_output (spriv, i,
+            output[i].size);
         if (!output[i].data) {
           g_critical ("Failed to allocate the output tensor.");
           goto error;
@@ -379,13 +594,133 @@ g_tensor_filter_single_invoke (GTensorFilterSingle * self,
 
 error:
   /* if failed to invoke the model, release allocated memory. */
-  if (!spriv->allocate_in_invoke && allocate) {
-    for (i = 0; i < priv->prop.output_meta.num_tensors; i++) {
-      g_free (output[i].data);
-      output[i].data = NULL;
+  if (!spriv->allocate_in_invoke && allocate)
+    g_tensor_filter_single_release_output (self, output);
+  return FALSE;
+}
+
+/**
+ * @brief Lock to invoke the filter, and start the filter if not already started.
+ * @param self "this" pointer
+ * @param serial set TRUE if the invoke holds the serial lock, the framework contexts are not pooled and the invokes use one context.
+ * @return TRUE if the filter is started. The caller should unlock it with g_tensor_filter_single_invoke_unlock().
+ */
+static gboolean
+g_tensor_filter_single_invoke_lock (GTensorFilterSingle * self,
+    gboolean * serial)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  *serial = FALSE;
+  g_rw_lock_reader_lock (&spriv->invoke_lock);
+
+  /** start if not already started */
+  if (!priv->configured) {
+    if (!g_tensor_filter_single_start (self)) {
+      g_rw_lock_reader_unlock (&spriv->invoke_lock);
+      return FALSE;
     }
   }
-  return FALSE;
+
+  if (priv->shared_model == NULL) {
+    g_mutex_lock (&spriv->serial_lock);
+    *serial = TRUE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Unlock the filter locked with g_tensor_filter_single_invoke_lock().
+ */
+static void
+g_tensor_filter_single_invoke_unlock (GTensorFilterSingle * self,
+    gboolean serial)
+{
+  GTensorFilterSinglePrivate *spriv;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+
+  if (serial)
+    g_mutex_unlock (&spriv->serial_lock);
+  g_rw_lock_reader_unlock (&spriv->invoke_lock);
+}
+
+/**
+ * @brief Called when an input supposed to be invoked
+ * @param self "this" pointer
+ * @param input memory containing input data to run processing on
+ * @param output memory to put output data into after processing
+ * @param allocate true to allocate output data (false means tensor data is already allocated)
+ * @return TRUE if there is no error.
+ */
+static gboolean
+g_tensor_filter_single_invoke (GTensorFilterSingle * self,
+    const GstTensorMemory * input, GstTensorMemory * output, gboolean allocate)
+{
+  gboolean ret, serial;
+
+  if (!g_tensor_filter_single_invoke_lock (self, &serial))
+    return FALSE;
+
+  ret = g_tensor_filter_single_invoke_internal (self, input, output, allocate);
+  g_tensor_filter_single_invoke_unlock (self, serial);
+
+  return ret;
+}
+
+/**
+ * @brief Called when an application has several frames ready, to invoke them at once.
+ * @param self "this" pointer
+ * @param num_frames The number of frames
+ * @param input The input tensors of each frame
+ * @param output The output tensors of each frame, allocated by the caller
+ * @return TRUE if there is no error.
+ */
+static gboolean
+g_tensor_filter_single_invoke_batch (GTensorFilterSingle * self,
+    guint num_frames, const GstTensorMemory ** input,
+    GstTensorMemory ** output)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  gboolean ret = FALSE;
+  gboolean serial;
+  guint i;
+  gint status;
+
+  g_return_val_if_fail (num_frames > 0, FALSE);
+  g_return_val_if_fail (input != NULL && output != NULL, FALSE);
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  if (!g_tensor_filter_single_invoke_lock (self, &serial))
+    return FALSE;
+
+  /* the output is copied from the memory allocated by the sub-plugin */
+  if (spriv->allocate_in_invoke || num_frames == 1) {
+    for (i = 0; i < num_frames; i++) {
+      if (!g_tensor_filter_single_invoke_internal (self, input[i], output[i],
+              FALSE))
+        goto done;
+    }
+
+    ret = TRUE;
+    goto done;
+  }
+
+  status = gst_tensor_filter_common_invoke_batch (priv, num_frames, input,
+      output);
+  ret = (status == 0);
+
+done:
+  g_tensor_filter_single_invoke_unlock (self, serial);
+  return ret;
 }
 
 /**
@@ -402,6 +737,8 @@ g_tensor_filter_set_input_info (GTensorFilterSingle * self,
   GTensorFilterSinglePrivate *spriv;
   GstTensorFilterPrivate *priv;
   gint status = -EINVAL;
+  gpointer handle;
+  void **data;
 
   spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
   priv = &spriv->filter_priv;
@@ -409,23 +746,261 @@ g_tensor_filter_set_input_info (GTensorFilterSingle * self,
   if (G_UNLIKELY (!priv->fw) || G_UNLIKELY (!priv->prop.fw_opened))
     return -EINVAL;
 
+  /* wait for the running invokes, the context and the tensor info are changed */
+  g_rw_lock_writer_lock (&spriv->invoke_lock);
+
   gst_tensors_info_init (out_info);
+  data = gst_tensor_filter_common_get_context (priv, &handle);
+
   if (GST_TF_FW_V0 (priv->fw)) {
     if (G_LIKELY (priv->fw->setInputDimension)) {
-      status = priv->fw->setInputDimension (&priv->prop, &priv->privateData,
+      status = priv->fw->setInputDimension (&priv->prop, data,
           in_info, out_info);
     } else {
       status = -ENOENT;
     }
   } else {
-    status = priv->fw->getModelInfo (priv->fw, &priv->prop, &priv->privateData,
+    status = priv->fw->getModelInfo (priv->fw, &priv->prop, *data,
         SET_INPUT_INFO, (GstTensorsInfo *) in_info, out_info);
   }
 
+  /* other contexts in the pool are opened again with new info */
+  if (status == 0)
+    gst_tensor_filter_common_update_context (priv, handle, in_info, NULL);
+  gst_tensor_filter_common_put_context (priv, handle);
+
   if (status == 0) {
     gst_tensors_info_copy (&priv->prop.input_meta, in_info);
     gst_tensors_info_copy (&priv->prop.output_meta, out_info);
+
+    /* the size of output may be changed */
+    g_mutex_lock (&spriv->lock);
+    g_tensor_filter_single_flush_output_pool (spriv);
+    g_hash_table_foreach (spriv->buffers,
+        g_tensor_filter_single_invalidate_buffers, NULL);
+    g_mutex_unlock (&spriv->lock);
+
+    if (priv->shared_model)
+      priv->prop.input_configured = TRUE;
   }
 
+  g_rw_lock_writer_unlock (&spriv->invoke_lock);
   return status;
 }
+
+/**
+ * @brief Free the registered buffer set.
+ */
+static void
+g_tensor_filter_single_free_buffers (gpointer data)
+{
+  GTensorFilterSingleBuffers *buffers = (GTensorFilterSingleBuffers *) data;
+  guint i;
+
+  if (buffers->allocated) {
+    for (i = 0; i < buffers->num_outputs; i++)
+      g_free (buffers->output[i].data);
+  }
+
+  g_free (buffers);
+}
+
+/**
+ * @brief Mark the registered buffer set invalid, the tensor info is changed.
+ */
+static void
+g_tensor_filter_single_invalidate_buffers (gpointer key, gpointer value,
+    gpointer user_data)
+{
+  GTensorFilterSingleBuffers *buffers = (GTensorFilterSingleBuffers *) value;
+
+  buffers->valid = FALSE;
+}
+
+/**
+ * @brief Check the tensors are same with the tensor info.
+ */
+static gboolean
+g_tensor_filter_single_validate_tensors (const GstTensorsInfo * info,
+    const GstTensorMemory * mem, const gchar * name)
+{
+  gsize size;
+  guint i;
+
+  for (i = 0; i < info->num_tensors; i++) {
+    size = gst_tensors_info_get_size (info, i);
+
+    if (mem[i].data == NULL || mem[i].size != size) {
+      g_critical ("Invalid %s tensor %u (size %" G_GSIZE_FORMAT
+          ", expected %" G_GSIZE_FORMAT ").", name, i, mem[i].size, size);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Register the input and output buffers to be invoked repeatedly.
+ * @param self "this" pointer
+ * @param input the input tensors, the data should be valid until unregistered
+ * @param output the output tensors. If allocate is TRUE, the data is allocated and set in this.
+ * @param allocate TRUE to allocate the output data, which is freed when unregistered
+ * @return the handle of the buffer set, 0 if failed.
+ * @note The size of each tensor should be same with the tensor info of the model.
+ */
+static guint
+g_tensor_filter_single_register_buffers (GTensorFilterSingle * self,
+    const GstTensorMemory * input, GstTensorMemory * output, gboolean allocate)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  GTensorFilterSingleBuffers *buffers;
+  GstTensorsInfo *out_info;
+  guint i, handle = 0;
+
+  g_return_val_if_fail (input != NULL && output != NULL, 0);
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  /** start if not already started */
+  if (!priv->configured) {
+    if (!g_tensor_filter_single_start (self)) {
+      return 0;
+    }
+  }
+
+  if (!priv->prop.input_configured || !priv->prop.output_configured) {
+    g_critical ("The tensor info is not configured, cannot register the buffers.");
+    return 0;
+  }
+
+  out_info = &priv->prop.output_meta;
+  buffers = g_new0 (GTensorFilterSingleBuffers, 1);
+  buffers->num_outputs = out_info->num_tensors;
+  buffers->allocated = allocate;
+  buffers->valid = TRUE;
+
+  memcpy (buffers->input, input,
+      sizeof (GstTensorMemory) * priv->prop.input_meta.num_tensors);
+
+  if (allocate) {
+    for (i = 0; i < out_info->num_tensors; i++) {
+      output[i].size = gst_tensors_info_get_size (out_info, i);
+      output[i].data = g_try_malloc0 (output[i].size);
+      buffers->output[i] = output[i];
+    }
+  } else {
+    memcpy (buffers->output, output,
+        sizeof (GstTensorMemory) * out_info->num_tensors);
+  }
+
+  /* validate the buffers once */
+  if (!g_tensor_filter_single_validate_tensors (&priv->prop.input_meta,
+          buffers->input, "input") ||
+      !g_tensor_filter_single_validate_tensors (out_info, buffers->output,
+          "output")) {
+    if (allocate) {
+      for (i = 0; i < out_info->num_tensors; i++)
+        output[i].data = NULL;
+    }
+
+    g_tensor_filter_single_free_buffers (buffers);
+    return 0;
+  }
+
+  g_mutex_lock (&spriv->lock);
+  do {
+    handle = ++spriv->last_handle;
+  } while (handle == 0 || g_hash_table_contains (spriv->buffers,
+          GUINT_TO_POINTER (handle)));
+  g_hash_table_insert (spriv->buffers, GUINT_TO_POINTER (handle), buffers);
+  g_mutex_unlock (&spriv->lock);
+
+  return handle;
+}
+
+/**
+ * @brief Invoke the filter with the registered buffers.
+ * @param self "this" pointer
+ * @param handle the handle of the registered buffer set
+ * @return TRUE if there is no error.
+ * @note The buffer set cannot be invoked from several threads at once.
+ */
+static gboolean
+g_tensor_filter_single_invoke_registered (GTensorFilterSingle * self,
+    guint handle)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  GTensorFilterSingleBuffers *buffers;
+  gboolean ret = FALSE;
+  gboolean serial;
+  gint status;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  g_mutex_lock (&spriv->lock);
+  buffers = (GTensorFilterSingleBuffers *) g_hash_table_lookup (spriv->buffers,
+      GUINT_TO_POINTER (handle));
+  g_mutex_unlock (&spriv->lock);
+
+  if (buffers == NULL) {
+    g_critical ("Invalid handle %u of the registered buffers.", handle);
+    return FALSE;
+  }
+
+  if (!buffers->valid || !priv->configured) {
+    g_critical ("The tensor info is changed, the buffers (%u) should be registered again.",
+        handle);
+    return FALSE;
+  }
+
+  if (!g_atomic_int_compare_and_exchange (&buffers->busy, 0, 1)) {
+    g_critical ("The buffers (%u) are being invoked by other thread.", handle);
+    return FALSE;
+  }
+
+  if (!g_tensor_filter_single_invoke_lock (self, &serial)) {
+    g_atomic_int_set (&buffers->busy, 0);
+    return FALSE;
+  }
+
+  if (!buffers->valid) {
+    g_critical ("The tensor info is changed, the buffers (%u) should be registered again.",
+        handle);
+  } else if (spriv->allocate_in_invoke) {
+    /* the output is copied from the memory allocated by the sub-plugin */
+    ret = g_tensor_filter_single_invoke_internal (self, buffers->input,
+        buffers->output, FALSE);
+  } else {
+    GST_TF_FW_INVOKE_COMPAT (priv, status, buffers->input, buffers->output);
+    ret = (status == 0);
+  }
+  g_tensor_filter_single_invoke_unlock (self, serial);
+
+  g_atomic_int_set (&buffers->busy, 0);
+  return ret;
+}
+
+/**
+ * @brief Unregister the buffers.
+ * @param self "this" pointer
+ * @param handle the handle of the registered buffer set
+ * @note The output allocated in register_buffers is freed. This should not be called while invoking the buffers.
+ */
+static void
+g_tensor_filter_single_unregister_buffers (GTensorFilterSingle * self,
+    guint handle)
+{
+  GTensorFilterSinglePrivate *spriv;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+
+  g_mutex_lock (&spriv->lock);
+  if (!g_hash_table_remove (spriv->buffers, GUINT_TO_POINTER (handle)))
+    g_warning ("Invalid handle %u of the registered buffers.", handle);
+  g_mutex_unlock (&spriv->lock);
+}
@@ -40,6 +40,8 @@ G_BEGIN_DECLS
   (G_TYPE_CHECK_INSTANCE_TYPE((obj),G_TYPE_TENSOR_FILTER_SINGLE))
 #define G_IS_TENSOR_FILTER_SINGLE_CLASS(klass) \
   (G_TYPE_CHECK_CLASS_TYPE((klass),G_TYPE_TENSOR_FILTER_SINGLE))
+#define G_TENSOR_FILTER_SINGLE_GET_CLASS(obj) \
+  (G_TYPE_INSTANCE_GET_CLASS((obj),G_TYPE_TENSOR_FILTER_SINGLE,GTensorFilterSingleClass))
 #define G_TENSOR_FILTER_SINGLE_CAST(obj)  ((GTensorFilterSingle *)(obj))
 
 typedef struct _GTensorFilterSingle GTensorFilterSingle;
@@ -81,6 +83,18 @@ struct _GTensorFilterSingleClass
   gboolean (*allocate_in_invoke) (GTensorFilterSingle * self);
   /** Free the data allocated by the tensor filter in invoke */
   void (*destroy_notify) (GTensorFilterSingle * self, GstTensorMemory * mem);
+  /** Invoke the filter with several frames at once, output should be allocated. */
+  gboolean (*invoke_batch) (GTensorFilterSingle * self, guint num_frames,
+      const GstTensorMemory ** input, GstTensorMemory ** output);
+  /** Release the output allocated in invoke, to be reused in next invoke. */
+  void (*release_output) (GTensorFilterSingle * self, GstTensorMemory * output);
+  /** Register the input and output buffers to be invoked repeatedly, returns the handle (0 if failed). */
+  guint (*register_buffers) (GTensorFilterSingle * self,
+      const GstTensorMemory * input, GstTensorMemory * output, gboolean allocate);
+  /** Invoke the filter with the registered buffers. */
+  gboolean (*invoke_registered) (GTensorFilterSingle * self, guint handle);
+  /** Unregister the buffers, the output allocated in register_buffers is freed. */
+  void (*unregister_buffers) (GTensorFilterSingle * self, guint handle);
 };
 
 /**
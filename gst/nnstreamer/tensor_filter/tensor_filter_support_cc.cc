@@ -42,6 +42,16 @@
 
 #include <nnstreamer_cppplugin_api_filter.hh>
 
+#include <cstddef>
+
+/**
+ * The callbacks of version 2 should fit in the union of version 0,
+ * so that the subplugins built with the earlier version keep the same layout.
+ */
+static_assert (offsetof (GstTensorFilterFramework, v1.invoke_batch)
+                   <= offsetof (GstTensorFilterFramework, v0.allocateInInvoke),
+    "GstTensorFilterFramework is grown with the callbacks of version 2.");
+
 namespace nnstreamer
 {
 
@@ -76,7 +86,8 @@ tensor_filter_subplugin::cpp_open (const GstTensorFilterProperties *prop, void *
   const GstTensorFilterFramework *tfsp = nnstreamer_filter_find (prop->fwname);
 
   assert (tfsp);
-  assert (tfsp->version == GST_TENSOR_FILTER_FRAMEWORK_V1);
+  assert (tfsp->version == GST_TENSOR_FILTER_FRAMEWORK_V1
+          || tfsp->version == GST_TENSOR_FILTER_FRAMEWORK_V2);
 
   /* 1. Fetch stored empty object from subplugin api (subplugin_data) */
   tensor_filter_subplugin *sp = (tensor_filter_subplugin *)tfsp->v1.subplugin_data;
@@ -170,6 +181,39 @@ tensor_filter_subplugin::cpp_invoke (const GstTensorFilterFramework *tf,
   return 0;
 }
 
+/**
+ * @brief C V2 tensor-filter wrapper callback function, "invoke_batch"
+ */
+int
+tensor_filter_subplugin::cpp_invoke_batch (const GstTensorFilterFramework *tf,
+    const GstTensorFilterProperties *prop, void *private_data,
+    unsigned int num_frames, const GstTensorMemory **input, GstTensorMemory **output)
+{
+  tensor_filter_subplugin *obj;
+  tensor_filter_subplugin_batch *batch;
+
+  GET_TFSP_WITH_CHECKS (obj, private_data);
+
+  /* the batched invoke is available if the subplugin derives the interface */
+  batch = dynamic_cast<tensor_filter_subplugin_batch *> (obj);
+  if (batch == nullptr)
+    return -ENOENT;
+
+  try {
+    return batch->invoke_batch (num_frames, input, output);
+  } catch (const std::invalid_argument &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (const std::system_error &e) {
+    _RETURN_ERR_WITH_MSG (e.code ().value () * -1, e.what ());
+  } catch (const std::runtime_error &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (const std::exception &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  }
+
+  return 0;
+}
+
 /**
  * @brief C V1 tensor-filter wrapper callback function, "getFrameworkInfo"
  */
@@ -188,7 +232,8 @@ tensor_filter_subplugin::cpp_getFrameworkInfo (const GstTensorFilterFramework *t
       tfsp = nnstreamer_filter_find (prop->fwname);
 
     assert (tfsp);
-    assert (tfsp->version == GST_TENSOR_FILTER_FRAMEWORK_V1);
+    assert (tfsp->version == GST_TENSOR_FILTER_FRAMEWORK_V1
+            || tfsp->version == GST_TENSOR_FILTER_FRAMEWORK_V2);
 
     obj = (tensor_filter_subplugin *)tfsp->v1.subplugin_data;
   } else {
@@ -233,10 +278,10 @@ tensor_filter_subplugin::cpp_eventHandler (const GstTensorFilterFramework *tf,
 }
 
 /**
- * @brief The template for fwdesc, the C wrapper (V1) struct.
+ * @brief The template for fwdesc, the C wrapper (V2) struct.
  */
 const GstTensorFilterFramework tensor_filter_subplugin::fwdesc_template
-    = {.version = GST_TENSOR_FILTER_FRAMEWORK_V1,
+    = {.version = GST_TENSOR_FILTER_FRAMEWORK_V2,
         .open = cpp_open,
         .close = cpp_close,
         {.v1 = {
@@ -245,6 +290,8 @@ const GstTensorFilterFramework tensor_filter_subplugin::fwdesc_template
              .getModelInfo = cpp_getModelInfo,
              .eventHandler = cpp_eventHandler,
              .subplugin_data = nullptr,
+             .invoke_async = nullptr,
+             .invoke_batch = cpp_invoke_batch,
          } } };
 
 /**
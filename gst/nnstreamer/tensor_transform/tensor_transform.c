@@ -177,6 +177,9 @@ static gboolean gst_tensor_transform_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensor_transform_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensor_transform_decide_allocation (GstBaseTransform *
+    trans, GstQuery * query);
+static gboolean gst_tensor_transform_stop (GstBaseTransform * trans);
 
 static gboolean gst_tensor_transform_convert_dimension (GstTensorTransform *
     filter, GstPadDirection direction, guint idx, const GstTensorInfo * in_info,
@@ -288,6 +291,10 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_transform_transform_size);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensor_transform_decide_allocation);
+
+  trans_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_transform_stop);
 }
 
 /**
@@ -309,6 +316,33 @@ gst_tensor_transform_init (GstTensorTransform * filter)
 
   gst_tensors_config_init (&filter->in_config);
   gst_tensors_config_init (&filter->out_config);
+
+  filter->allocator = NULL;
+  gst_allocation_params_init (&filter->params);
+  filter->pool = NULL;
+  filter->pool_prefix = 0;
+}
+
+/**
+ * @brief Release the allocator and buffer pool negotiated with downstream.
+ */
+static void
+gst_tensor_transform_clear_allocation (GstTensorTransform * filter)
+{
+  if (filter->allocator) {
+    gst_object_unref (filter->allocator);
+    filter->allocator = NULL;
+  }
+
+  gst_allocation_params_init (&filter->params);
+
+  if (filter->pool) {
+    gst_buffer_pool_set_active (filter->pool, FALSE);
+    gst_object_unref (filter->pool);
+    filter->pool = NULL;
+  }
+
+  filter->pool_prefix = 0;
 }
 
 /**
@@ -934,6 +968,8 @@ gst_tensor_transform_finalize (GObject * object)
     filter->apply = NULL;
   }
 
+  gst_tensor_transform_clear_allocation (filter);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -1489,7 +1525,19 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
       buf_size += hsize;
     }
 
-    out_mem[i] = gst_allocator_alloc (NULL, buf_size, NULL);
+    if (out_flexible) {
+      out_mem[i] = gst_allocator_alloc (filter->allocator, buf_size,
+          &filter->params);
+    } else {
+      if (filter->pool)
+        out_mem[i] = gst_tensor_buffer_pool_alloc_memory (filter->pool,
+            buf_size, filter->pool_prefix);
+
+      /* reserve the header area for flexible tensor downstream */
+      if (out_mem[i] == NULL)
+        out_mem[i] = gst_tensor_alloc_with_header_room_full (buf_size,
+            filter->allocator, &filter->params);
+    }
     gst_buffer_append_memory (outbuf, out_mem[i]);
 
     if (!gst_memory_map (out_mem[i], &out_map[i], GST_MAP_WRITE)) {
@@ -1888,3 +1936,100 @@ gst_tensor_transform_transform_size (GstBaseTransform * trans,
 
   return TRUE;
 }
+
+/**
+ * @brief Check the buffer pool proposed by downstream and activate it.
+ * @return TRUE if the output memory can be acquired from the pool.
+ */
+static gboolean
+gst_tensor_transform_setup_pool (GstTensorTransform * filter,
+    GstBufferPool * pool, GstCaps * caps, guint min, guint max)
+{
+  GstTensorsConfig config;
+  gsize size;
+  gboolean ret = FALSE;
+
+  /* the memory of the tensor not in the list of apply is shared with input */
+  if (filter->apply || caps == NULL)
+    return FALSE;
+
+  gst_tensors_config_init (&config);
+  gst_tensors_config_from_structure (&config, gst_caps_get_structure (caps, 0));
+
+  if (!gst_tensors_config_validate (&config) ||
+      gst_tensors_info_is_flexible (&config.info) ||
+      config.info.num_tensors != 1)
+    goto done;
+
+  size = gst_tensors_info_get_size (&config.info, 0);
+  ret = gst_tensor_buffer_pool_setup (pool, caps, size, min, max,
+      &filter->pool_prefix);
+
+done:
+  gst_tensors_config_free (&config);
+  return ret;
+}
+
+/**
+ * @brief Decide the allocation with downstream. optional vmethod of BaseTransform
+ * @details The output buffer consists of the memory blocks of each tensor, which are allocated in transform().
+ *          This keeps the allocation parameters (e.g., alignment) and the buffer pool proposed by downstream,
+ *          and removes the pools from the query so that the base class does not acquire the output buffer from the pool.
+ */
+static gboolean
+gst_tensor_transform_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query)
+{
+  GstTensorTransform *filter;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+  GstBufferPool *pool = NULL;
+  GstCaps *caps;
+  guint size, min, max;
+
+  filter = GST_TENSOR_TRANSFORM_CAST (trans);
+
+  gst_tensor_transform_clear_allocation (filter);
+
+  gst_allocation_params_init (&params);
+  if (gst_query_get_n_allocation_params (query) > 0)
+    gst_query_parse_nth_allocation_param (query, 0, &allocator, &params);
+
+  filter->allocator = allocator;
+  filter->params = params;
+
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_parse_allocation (query, &caps, NULL);
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+
+    if (pool) {
+      if (gst_tensor_transform_setup_pool (filter, pool, caps, min, max))
+        filter->pool = pool;
+      else
+        gst_object_unref (pool);
+    }
+
+    while (gst_query_get_n_allocation_pools (query) > 0)
+      gst_query_remove_nth_allocation_pool (query, 0);
+  }
+
+  silent_debug ("Decided allocation: align %zu, pool %s",
+      filter->params.align, filter->pool ? "downstream" : "none");
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+      query);
+}
+
+/**
+ * @brief Called when the element stops processing. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensor_transform_stop (GstBaseTransform * trans)
+{
+  GstTensorTransform *filter;
+
+  filter = GST_TENSOR_TRANSFORM_CAST (trans);
+  gst_tensor_transform_clear_allocation (filter);
+
+  return TRUE;
+}
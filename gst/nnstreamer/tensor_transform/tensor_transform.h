@@ -162,6 +162,11 @@ struct _GstTensorTransform
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   GList *apply; /**< Select the tensors to apply transformation */
+
+  GstAllocator *allocator; /**< allocator negotiated with downstream (NULL for default) */
+  GstAllocationParams params; /**< allocation parameters negotiated with downstream */
+  GstBufferPool *pool; /**< buffer pool proposed by downstream, used for static output with single tensor */
+  gsize pool_prefix; /**< size of the area reserved in front of the data in the buffer pool */
 };
 
 /**
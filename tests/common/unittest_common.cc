@@ -18,6 +18,7 @@
 #include <glib/gstdio.h>
 #include <nnstreamer_conf.h>
 #include <nnstreamer_plugin_api.h>
+#include <nnstreamer_tensor_view.hh>
 #include <tensor_common.h>
 #include <unistd.h>
 #include <unittest_util.h>
@@ -1416,6 +1417,61 @@ TEST (commonMetaInfo, appendHeader)
   gst_memory_unref (result);
 }
 
+/**
+ * @brief Test for tensor meta info (append header to memory with reserved header area).
+ */
+TEST (commonMetaInfo, appendHeaderRoom)
+{
+  GstTensorMetaInfo meta1, meta2;
+  GstMemory *result1, *result2, *data;
+  GstMapInfo map, map1, map2;
+  gsize hsize, msize;
+
+  gst_tensor_meta_info_init (&meta1);
+  meta1.type = _NNS_UINT8;
+  meta1.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta1.dimension[0] = 300U;
+  meta1.dimension[1] = 1U;
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta1);
+  data = gst_tensor_alloc_with_header_room (300);
+  ASSERT_TRUE (data != NULL);
+
+  ASSERT_TRUE (gst_memory_map (data, &map, GST_MAP_WRITE));
+  memset (map.data, 0x7F, 300);
+  gst_memory_unmap (data, &map);
+
+  /* header is written in the reserved area, without copying the data */
+  result1 = gst_tensor_meta_info_append_header (&meta1, data);
+  ASSERT_TRUE (result1 != NULL);
+
+  msize = gst_memory_get_sizes (result1, NULL, NULL);
+  EXPECT_EQ (msize, hsize + 300U);
+
+  EXPECT_TRUE (gst_tensor_meta_info_parse_memory (&meta2, result1));
+  EXPECT_EQ (meta2.type, _NNS_UINT8);
+  EXPECT_EQ (meta2.dimension[0], 300U);
+
+  ASSERT_TRUE (gst_memory_map (data, &map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result1, &map1, GST_MAP_READ));
+  EXPECT_TRUE (map1.data + hsize == map.data);
+
+  /* the memory is shared, so the header and data should be copied */
+  result2 = gst_tensor_meta_info_append_header (&meta1, data);
+  ASSERT_TRUE (result2 != NULL);
+  ASSERT_TRUE (gst_memory_map (result2, &map2, GST_MAP_READ));
+  EXPECT_FALSE (map2.data + hsize == map.data);
+  EXPECT_EQ (memcmp (map1.data, map2.data, hsize + 300U), 0);
+
+  gst_memory_unmap (result2, &map2);
+  gst_memory_unmap (result1, &map1);
+  gst_memory_unmap (data, &map);
+
+  gst_memory_unref (result2);
+  gst_memory_unref (result1);
+  gst_memory_unref (data);
+}
+
 /**
  * @brief Test for tensor meta info (append header to memory with invalid param).
  */
@@ -1781,6 +1837,219 @@ TEST (versionControl, getVer01)
   g_free (verstr3);
 }
 
+/**
+ * @brief Test for the pooled tensor allocator.
+ */
+TEST (tensorAllocator, pool01)
+{
+  GstTensorAllocStats stats;
+  GstMemory *mem1, *mem2;
+  GstMapInfo map;
+  gpointer data;
+
+  gst_tensor_alloc_set_pool (TRUE, 1024 * 1024, 512 * 1024, 0);
+
+  mem1 = gst_allocator_alloc (NULL, 1000, NULL);
+  ASSERT_TRUE (mem1 != NULL);
+  EXPECT_EQ (gst_memory_get_sizes (mem1, NULL, NULL), 1000U);
+  ASSERT_TRUE (gst_memory_map (mem1, &map, GST_MAP_WRITE));
+  data = map.data;
+  memset (map.data, 1, map.size);
+  gst_memory_unmap (mem1, &map);
+
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_EQ (stats.live_bytes, 1024U);
+  EXPECT_EQ (stats.misses, 1U);
+  EXPECT_EQ (stats.hits, 0U);
+
+  /* the block is returned to the pool, and reused for the same size class */
+  gst_memory_unref (mem1);
+  mem2 = gst_allocator_alloc (NULL, 900, NULL);
+  ASSERT_TRUE (mem2 != NULL);
+  ASSERT_TRUE (gst_memory_map (mem2, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data == data);
+  gst_memory_unmap (mem2, &map);
+
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_EQ (stats.hits, 1U);
+  EXPECT_EQ (stats.pooled_bytes, 0U);
+  EXPECT_EQ (stats.peak_bytes, 1024U);
+
+  gst_memory_unref (mem2);
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_EQ (stats.live_bytes, 0U);
+  EXPECT_EQ (stats.pooled_bytes, 1024U);
+
+  /* free the blocks in the pool */
+  gst_tensor_alloc_trim ();
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_EQ (stats.pooled_bytes, 0U);
+  EXPECT_EQ (stats.trimmed_bytes, 1024U);
+
+  gst_tensor_alloc_set_pool (FALSE, 0, 0, 0);
+}
+
+/**
+ * @brief Test for the pooled tensor allocator with the byte cap.
+ */
+TEST (tensorAllocator, poolTrim01)
+{
+  GstTensorAllocStats stats, old_stats;
+  GstMemory *mem[4];
+  guint i;
+
+  gst_tensor_alloc_get_stats (&old_stats);
+  gst_tensor_alloc_set_pool (TRUE, 4096, 2048, 0);
+
+  for (i = 0; i < 4; i++) {
+    mem[i] = gst_allocator_alloc (NULL, 2048, NULL);
+    ASSERT_TRUE (mem[i] != NULL);
+  }
+
+  for (i = 0; i < 4; i++)
+    gst_memory_unref (mem[i]);
+
+  /* the pool does not exceed the cap */
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_LE (stats.pooled_bytes, 4096U);
+  EXPECT_GT (stats.trimmed_bytes, old_stats.trimmed_bytes);
+  EXPECT_EQ (stats.live_bytes, 0U);
+
+  gst_tensor_alloc_set_pool (FALSE, 0, 0, 0);
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_EQ (stats.pooled_bytes, 0U);
+}
+
+/**
+ * @brief Test for the typed view of packed tensor.
+ */
+TEST (tensorView, packed01)
+{
+  float data[2 * 3 * 4];
+  GstTensorInfo info;
+  GstTensorMemory mem = { data, sizeof (data) };
+  size_t i;
+
+  for (i = 0; i < 2 * 3 * 4; i++)
+    data[i] = (float) i;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("2:3:4:1", info.dimension);
+
+  nnstreamer::tensor_view<const float, 3> view (mem, info);
+
+  EXPECT_EQ (view.size (), 24U);
+  EXPECT_EQ (view.dim (1), 3U);
+  EXPECT_EQ (view.stride (0), 1U);
+  EXPECT_EQ (view.stride (1), 2U);
+  EXPECT_EQ (view.stride (2), 6U);
+  EXPECT_TRUE (view.is_contiguous ());
+  EXPECT_EQ (view (1, 2, 3), 23.0f);
+  EXPECT_EQ (view (0, 1, 2), 14.0f);
+  EXPECT_EQ (view[5], 5.0f);
+  EXPECT_EQ (view.end () - view.begin (), 24);
+}
+
+/**
+ * @brief Test for the typed view with the strides.
+ */
+TEST (tensorView, strided01)
+{
+  uint8_t data[4 * 3] = { 0, };
+  const uint32_t dim[2] = { 3, 3 };
+  const size_t stride[2] = { 1, 4 };
+
+  /* 3x3 matrix, each row is padded to 4 elements */
+  nnstreamer::tensor_view<uint8_t, 2> view (data, dim, stride);
+
+  EXPECT_FALSE (view.is_contiguous ());
+  view (2, 1) = 10;
+  view (0, 2) = 20;
+  EXPECT_EQ (data[6], 10U);
+  EXPECT_EQ (data[8], 20U);
+}
+
+/**
+ * @brief Test for the typed view with invalid tensor (negative).
+ */
+TEST (tensorView, invalidTensor_n)
+{
+  int32_t data[4] = { 0, };
+  GstTensorInfo info;
+  GstTensorMemory mem = { data, sizeof (data) };
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_INT32;
+  gst_tensor_parse_dimension ("2:2:2:1", info.dimension);
+
+  /* different type */
+  EXPECT_THROW (nnstreamer::tensor_view<float> (mem, info), std::invalid_argument);
+  /* rank exceeds the view */
+  EXPECT_THROW ((nnstreamer::tensor_view<int32_t, 2> (mem, info)), std::invalid_argument);
+  /* memory is smaller than the tensor */
+  EXPECT_THROW (nnstreamer::tensor_view<int32_t> (mem, info), std::invalid_argument);
+}
+
+/**
+ * @brief Test for the type dispatch of tensor.
+ */
+TEST (tensorView, dispatchType01)
+{
+  int i;
+
+  for (i = 0; i < _NNS_END; i++) {
+    size_t size = nnstreamer::dispatch_type ((tensor_type) i, [i] (auto tag) {
+      using T = typename decltype (tag)::type;
+      EXPECT_EQ (nnstreamer::tensor_type_of<T>::value, tensor_type (i));
+      return sizeof (T);
+    });
+
+    EXPECT_EQ (size, gst_tensor_get_element_size ((tensor_type) i));
+  }
+}
+
+/**
+ * @brief Test for the type dispatch of tensor, writing the kernel once for each type.
+ */
+TEST (tensorView, dispatchType02)
+{
+  int16_t in_data[6] = { -3, -2, -1, 0, 1, 2 };
+  int16_t out_data[6] = { 0, };
+  GstTensorInfo info;
+  GstTensorMemory in = { in_data, sizeof (in_data) };
+  GstTensorMemory out = { out_data, sizeof (out_data) };
+  int ret, i;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_INT16;
+  gst_tensor_parse_dimension ("6:1:1:1", info.dimension);
+
+  ret = nnstreamer::dispatch_type (info.type, [&] (auto tag) {
+    using T = typename decltype (tag)::type;
+    nnstreamer::tensor_view<const T> src (in, info);
+    nnstreamer::tensor_view<T> dst (out, info);
+
+    for (size_t n = 0; n < src.size (); n++)
+      dst[n] = src[n] * 2;
+    return 0;
+  });
+
+  EXPECT_EQ (ret, 0);
+  for (i = 0; i < 6; i++)
+    EXPECT_EQ (out_data[i], in_data[i] * 2);
+}
+
+/**
+ * @brief Test for the type dispatch with invalid type (negative).
+ */
+TEST (tensorView, dispatchInvalidType_n)
+{
+  EXPECT_THROW (nnstreamer::dispatch_type (_NNS_END, [] (auto tag) {
+    return sizeof (typename decltype (tag)::type);
+  }), std::invalid_argument);
+}
+
 /**
  * @brief Main function for unit test.
  */
@@ -76,9 +76,17 @@ filter_basic::invoke (const GstTensorMemory *in, GstTensorMemory *out)
   g_assert (prop->input_meta.info[0].type == _NNS_UINT8);
   g_assert (prop->output_meta.info[0].type == _NNS_UINT8);
 
-  for (int i = 0; i < 4 * 4 * 3; i++) {
-    *((uint8_t *)out[0].data + i) = *((uint8_t *)in[0].data + i) * 2;
-    *((uint8_t *)out[0].data + i + 4 * 4 * 3) = *((uint8_t *)in[0].data + i) + 1;
+  /* the output has 2 frames, (in * 2) and (in + 1) */
+  nnstreamer::tensor_view<const uint8_t, 3> src (in[0], prop->input_meta.info[0]);
+  nnstreamer::tensor_view<uint8_t> dst (out[0], prop->output_meta.info[0]);
+
+  for (uint32_t y = 0; y < src.dim (2); y++) {
+    for (uint32_t x = 0; x < src.dim (1); x++) {
+      for (uint32_t c = 0; c < src.dim (0); c++) {
+        dst (c, x, y, 0) = src (c, x, y) * 2;
+        dst (c, x, y, 1) = src (c, x, y) + 1;
+      }
+    }
   }
   return 0;
 }
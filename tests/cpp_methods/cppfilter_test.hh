@@ -13,6 +13,7 @@
 
 #include <glib.h>
 #include <tensor_filter_cpp.hh>
+#include <nnstreamer_tensor_view.hh>
 
 class filter_basic: public tensor_filter_cpp {
   public:
@@ -89,6 +89,24 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=4 ! videoc
 # This won't fail, but not much meaningful
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=4 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=257,height=353 ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 ! tensor_filter framework=tensorflow2-lite model=${PATH_TO_MULTI_TENSOR_OUTPUT_MODEL} ! fakesink" 5 0 0 $PERFORMANCE
 
+# Test the interpreters sharing the model
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=${PATH_TO_IMAGE} ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw,format=RGB,framerate=0/1 ! tensor_converter ! tensor_filter framework=tensorflow2-lite model=${PATH_TO_MODEL} custom=NumInterpreters:2 ! filesink location=tensorfilter.out.log" 6 0 0 $PERFORMANCE
+python3 checkLabel.py tensorfilter.out.log ${PATH_TO_LABEL} orange
+testResult $? 6 "Golden test comparison with interpreter pool" 0 1
+
+# Test XNNPACK delegate, skip the case if XNNPACK is not enabled in the build (tensorflow2-lite uses the default kernels)
+G_MESSAGES_DEBUG=all gst-launch-1.0 -q --gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=${PATH_TO_IMAGE} ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw,format=RGB,framerate=0/1 ! tensor_converter ! tensor_filter framework=tensorflow2-lite model=${PATH_TO_MODEL} custom=Delegate:XNNPACK,NumThreads:2 ! filesink location=tensorfilter.out.log 2>info
+xnnpack_ret=$?
+if grep -q "XNNPACK delegate support is not enabled" info; then
+    echo "XNNPACK delegate is not available, skip the test case 7"
+else
+    testResult $xnnpack_ret 7 "Pipeline test with XNNPACK delegate" 0 1
+    grep -q "Set XNNPACK delegate" info
+    testResult $? 7-1 "XNNPACK delegate is in use" 0 1
+    python3 checkLabel.py tensorfilter.out.log ${PATH_TO_LABEL} orange
+    testResult $? 7-2 "Golden test comparison with XNNPACK delegate" 0 1
+fi
+
 # Test the backend setting done with tensorflow2-lite
 # This also performs tests for generic backend configuration parsing
 function run_pipeline() {
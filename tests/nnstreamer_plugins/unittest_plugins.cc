@@ -17,10 +17,15 @@
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_subplugin.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 #include <string.h>
 #include <tensor_common.h>
 #include <unistd.h>
+#include <utime.h>
 
+#include "../gst/nnstreamer/tensor_filter/tensor_filter_single.h"
 #include "../gst/nnstreamer/tensor_transform/tensor_transform.h"
 
 #ifdef ENABLE_TENSORFLOW_LITE
@@ -4722,6 +4727,21 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
   g_free (test_model2);
 }
 
+/**
+ * @brief Reload the model of tf-lite with the event of the subplugin.
+ */
+static int
+reload_tflite_model (const GstTensorFilterFramework *fw,
+    GstTensorFilterProperties *prop, void *private_data)
+{
+  GstTensorFilterFrameworkEventData data;
+
+  data.model_files = prop->model_files;
+  data.num_models = prop->num_models;
+
+  return fw->eventHandler (fw, prop, private_data, RELOAD_MODEL, &data);
+}
+
 /**
  * @brief Test to reload tf-lite; model does not exist (negative)
  */
@@ -4736,7 +4756,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteModelNotFound_n)
   gchar *test_model;
 
   /* Check if mandatory methods are contained */
-  ASSERT_TRUE (fw && fw->open && fw->close && fw->reloadModel);
+  ASSERT_TRUE (fw && fw->open && fw->close && fw->eventHandler);
 
   /* supposed to run test in build directory */
   if (root_path == NULL)
@@ -4769,7 +4789,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteModelNotFound_n)
   ((gchar **)model_files)[0] = test_model; /* remove const for the test */
 
   /* reload tf-lite model */
-  EXPECT_TRUE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_TRUE (reload_tflite_model (fw, prop, private_data) == 0);
 
   g_free (test_model);
   test_model = g_build_filename (root_path, "tests", "test_models", "models",
@@ -4777,7 +4797,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteModelNotFound_n)
   ((gchar **)model_files)[0] = test_model; /* remove const for the test */
 
   /* reload tf-lite model which does not exist */
-  EXPECT_FALSE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_FALSE (reload_tflite_model (fw, prop, private_data) == 0);
 
   /* close tf-lite model */
   fw->close (prop, &private_data);
@@ -4800,7 +4820,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteModelWrongDims_n)
   gchar *test_model;
 
   /* Check if mandatory methods are contained */
-  ASSERT_TRUE (fw && fw->open && fw->close && fw->reloadModel);
+  ASSERT_TRUE (fw && fw->open && fw->close && fw->eventHandler);
 
   /* supposed to run test in build directory */
   if (root_path == NULL)
@@ -4833,7 +4853,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteModelWrongDims_n)
   ((gchar **)model_files)[0] = test_model; /* remove const for the test */
 
   /* reload tf-lite model with unmatched dims */
-  EXPECT_FALSE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_FALSE (reload_tflite_model (fw, prop, private_data) == 0);
 
   /* close tf-lite model */
   fw->close (prop, &private_data);
@@ -4857,7 +4877,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSameModelNotFound_n)
   gchar *test_model_renamed;
 
   /* Check if mandatory methods are contained */
-  ASSERT_TRUE (fw && fw->open && fw->close && fw->reloadModel);
+  ASSERT_TRUE (fw && fw->open && fw->close && fw->eventHandler);
 
   /* supposed to run test in build directory */
   if (root_path == NULL)
@@ -4887,13 +4907,13 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSameModelNotFound_n)
   EXPECT_TRUE (fw->open (prop, &private_data) == 0);
 
   /* reload tf-lite model again */
-  EXPECT_TRUE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_TRUE (reload_tflite_model (fw, prop, private_data) == 0);
 
   /* rename the model */
   ASSERT_TRUE (g_rename (test_model, test_model_renamed) == 0);
 
   /* reload tf-lite model which does not exist */
-  EXPECT_FALSE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_FALSE (reload_tflite_model (fw, prop, private_data) == 0);
 
   /* test model rollback */
   ASSERT_TRUE (g_rename (test_model_renamed, test_model) == 0);
@@ -4922,7 +4942,7 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSameModelWrongDims_n)
   gchar *test_model_renamed;
 
   /* Check if mandatory methods are contained */
-  ASSERT_TRUE (fw && fw->open && fw->close && fw->reloadModel);
+  ASSERT_TRUE (fw && fw->open && fw->close && fw->eventHandler);
 
   /* supposed to run test in build directory */
   if (root_path == NULL)
@@ -4954,14 +4974,14 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSameModelWrongDims_n)
   EXPECT_TRUE (fw->open (prop, &private_data) == 0);
 
   /* reload tf-lite model again */
-  EXPECT_TRUE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_TRUE (reload_tflite_model (fw, prop, private_data) == 0);
 
   /* rename the model */
   ASSERT_TRUE (g_rename (test_model, test_model_backup) == 0);
   ASSERT_TRUE (g_rename (test_model_renamed, test_model) == 0);
 
   /* reload tf-lite model with unmatched dims */
-  EXPECT_FALSE (fw->reloadModel (prop, &private_data) == 0);
+  EXPECT_FALSE (reload_tflite_model (fw, prop, private_data) == 0);
 
   /* test model rollback */
   ASSERT_TRUE (g_rename (test_model, test_model_renamed) == 0);
@@ -4976,6 +4996,139 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSameModelWrongDims_n)
   g_free (test_model_renamed);
 }
 
+/**
+ * @brief Test to get the statistics of the interpreters of tf-lite.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, frameworkStatsTFlite)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  gchar *str_launch_line, *stats;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+      "model=%s custom=NumInterpreters:2", test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  /* not opened yet */
+  gst_harness_get (h, "tensor_filter", "framework-stats", &stats, NULL);
+  EXPECT_STREQ (stats, "");
+  g_free (stats);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  /* the threads are divided even if not given */
+  gst_harness_get (h, "tensor_filter", "framework-stats", &stats, NULL);
+  EXPECT_TRUE (g_str_has_prefix (stats, "threads="));
+  EXPECT_FALSE (g_str_has_prefix (stats, "threads=-1"));
+  EXPECT_TRUE (strstr (stats, "interpreter0-invokes=") != NULL);
+  EXPECT_TRUE (strstr (stats, "interpreter1-invokes=") != NULL);
+  EXPECT_TRUE (strstr (stats, "-invokes=1,") != NULL);
+  EXPECT_TRUE (strstr (stats, "interpreter0-zero-copy=") != NULL);
+  g_free (stats);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+}
+
+/**
+ * @brief Test the output ring of tensorflow-lite (custom option OutputRing).
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, outputRingTFlite)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_a, *out_b, *out_c;
+  GstTensorConfig config;
+  GstMapInfo map_a, map_b;
+  gchar *str_launch_line;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+      "model=%s custom=OutputRing:2", test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  /* hold the first output while the next frame is invoked */
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_a = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_a), 1001U);
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_b = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_b), 1001U);
+
+  /* the slot in use is not given to the next invoke */
+  ASSERT_TRUE (gst_buffer_map (out_a, &map_a, GST_MAP_READ));
+  ASSERT_TRUE (gst_buffer_map (out_b, &map_b, GST_MAP_READ));
+  EXPECT_NE (map_a.data, map_b.data);
+  gst_buffer_unmap (out_a, &map_a);
+  gst_buffer_unmap (out_b, &map_b);
+
+  /* the released slots are reused (the invoke waits if none is released) */
+  gst_buffer_unref (out_a);
+  gst_buffer_unref (out_b);
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_c = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_c), 1001U);
+  gst_buffer_unref (out_c);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+}
+
 /**
  * @brief Test framework auto detecion option in tensor-filter.
  */
@@ -6070,173 +6223,1752 @@ TEST_REQUIRE_TFLITE (testTensorFilter, flexToFlex)
 }
 
 /**
- * @brief Test for flatbuf, flexbuf and protobuf (tensors -> serialized buf -> tensors)
+ * @brief Test for output buffer pool in tensor_filter
  */
-TEST (testStreamBuffers, tensorsNormal)
+TEST_REQUIRE_TFLITE (testTensorFilter, outputPool)
 {
-  const gchar *mode_name[3] = { "flatbuf", "flexbuf", "protobuf" };
-  GstBuffer *dec_out_buf = NULL, *conv_out_buf = NULL;
-  GstTensorsConfig config, check_config;
-  GstMemory *mem;
-  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
-  GstMapInfo info;
-  guint mode_idx, i, j;
-  const GstTensorDecoderDef *fb_dec;
-  const NNStreamerExternalConverter *fb_conv;
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  gchar *pipeline;
+  gchar *test_model;
+  guint64 hits, misses;
+  guint i, pool_size;
 
-  for (mode_idx = 0; mode_idx < 3; mode_idx++) {
-    /** Find converter and decoder subplugins */
-    fb_dec = nnstreamer_decoder_find (mode_name[mode_idx]);
-    fb_conv = nnstreamer_converter_find (mode_name[mode_idx]);
-    ASSERT_TRUE (fb_dec);
-    ASSERT_TRUE (fb_conv);
+  GET_MODEL_PATH ("mobilenet_v1_1.0_224_quant.tflite");
 
-    /** Prepare input */
-    gst_tensors_config_init (&config);
-    gst_tensors_config_init (&check_config);
-    config.rate_n = 0;
-    config.rate_d = 1;
-    config.info.num_tensors = 2;
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
 
-    config.info.info[0].type = _NNS_INT32;
-    gst_tensor_parse_dimension ("3:4:2:2", config.info.info[0].dimension);
-    config.info.info[1].name = g_strdup ("2nd_tensor");
-    config.info.info[1].type = _NNS_INT32;
-    gst_tensor_parse_dimension ("3:4:2:2", config.info.info[1].dimension);
+  pipeline = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s output-pool-size=2", test_model);
+  gst_harness_add_parse (h, pipeline);
+  g_free (pipeline);
 
-    for (i = 0; i < config.info.num_tensors; i++) {
-      input[i].size = gst_tensor_info_get_size (&config.info.info[i]);
-      input[i].data = g_malloc0 (input[0].size);
-      memcpy (input[i].data, aggr_test_frames[i], input[i].size);
-    }
+  gst_harness_get (h, "tensor_filter", "output-pool-size", &pool_size, NULL);
+  EXPECT_EQ (pool_size, 2U);
 
-    /** Decode tensors to serialized buffers */
-    dec_out_buf = gst_buffer_new ();
-    fb_dec->decode (NULL, &config, input, dec_out_buf);
+  /* input tensor info */
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
 
-    for (i = 0; i < config.info.num_tensors; i++) {
-      g_free (input[i].data);
-    }
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
 
-    EXPECT_TRUE (dec_out_buf != NULL);
-    EXPECT_EQ (gst_buffer_n_memory (dec_out_buf), 1U);
+  /* the output memory is recycled after releasing the buffer */
+  for (i = 0; i < 3U; i++) {
+    in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-    /** Convert flatbuf to tensors */
-    conv_out_buf = fb_conv->convert (dec_out_buf, &check_config, NULL);
-    EXPECT_EQ (gst_buffer_n_memory (conv_out_buf), 2U);
+    out_buf = gst_harness_pull (h);
+    EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+    gst_buffer_unref (out_buf);
+  }
 
-    /** Check tensors config. */
-    EXPECT_TRUE (check_config.info.info[0].name == NULL);
-    EXPECT_STREQ ("2nd_tensor", check_config.info.info[1].name);
-    EXPECT_TRUE (gst_tensors_config_is_equal (&config, &check_config));
-    /** Check data */
-    for (i = 0; i < config.info.num_tensors; i++) {
-      mem = gst_buffer_peek_memory (conv_out_buf, i);
-      ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
-      for (j = 0; j < 48; j++)
-        EXPECT_EQ (((gint *)info.data)[j], aggr_test_frames[i][j]);
-      gst_memory_unmap (mem, &info);
-    }
+  gst_harness_get (h, "tensor_filter", "output-pool-hits", &hits,
+      "output-pool-misses", &misses, NULL);
+  EXPECT_EQ (hits, 3U);
+  EXPECT_EQ (misses, 0U);
 
-    gst_tensors_config_free (&config);
-    gst_tensors_config_free (&check_config);
-    gst_buffer_unref (dec_out_buf);
-    gst_buffer_unref (conv_out_buf);
+  /* the pool is exhausted if downstream holds the buffers */
+  for (i = 0; i < 3U; i++) {
+    in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
   }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 6U);
+
+  gst_harness_get (h, "tensor_filter", "output-pool-hits", &hits,
+      "output-pool-misses", &misses, NULL);
+  EXPECT_EQ (hits, 5U);
+  EXPECT_EQ (misses, 1U);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
 }
 
 /**
- * @brief Test for decoder subplugins with invalid parameter
+ * @brief Name of the custom filter allowing in-place invoke.
  */
-TEST (testDecoderSubplugins, flatbufInvalidParam0_n)
+static const char test_fw_in_place_name[] = "custom-in-place";
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), adding 1 to each element.
+ */
+static int
+test_in_place_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
 {
-  const gchar *mode_name = "flatbuf";
-  GstBuffer *dec_out_buf = NULL;
-  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
-  const GstTensorDecoderDef *fb_dec;
+  const guint8 *in_data;
+  guint8 *out_data;
+  gsize i;
 
-  /** Find decoder subplugins */
-  fb_dec = nnstreamer_decoder_find (mode_name);
-  ASSERT_TRUE (fb_dec);
+  EXPECT_EQ (input[0].size, output[0].size);
 
-  dec_out_buf = gst_buffer_new ();
-  EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, NULL, input, dec_out_buf));
+  in_data = (const guint8 *) input[0].data;
+  out_data = (guint8 *) output[0].data;
 
-  gst_buffer_unref (dec_out_buf);
+  for (i = 0; i < input[0].size; i++)
+    out_data[i] = in_data[i] + 1;
+
+  return 0;
 }
 
 /**
- * @brief Test for decoder subplugins with invalid parameter
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
  */
-TEST (testDecoderSubplugins, flatbufInvalidParam1_n)
+static int
+test_in_place_getFWInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
 {
-  const gchar *mode_name = "flatbuf";
-  GstBuffer *dec_out_buf = NULL;
-  GstTensorsConfig config;
-  const GstTensorDecoderDef *fb_dec;
-
-  /** Find  decoder subplugins */
-  fb_dec = nnstreamer_decoder_find (mode_name);
-  ASSERT_TRUE (fb_dec);
-
-  gst_tensors_config_init (&config);
-  dec_out_buf = gst_buffer_new ();
-  EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, &config, NULL, dec_out_buf));
-
-  gst_tensors_config_free (&config);
-  gst_buffer_unref (dec_out_buf);
+  memset (fw_info, 0, sizeof (GstTensorFilterFrameworkInfo));
+  fw_info->name = test_fw_in_place_name;
+  fw_info->allow_in_place = 1;
+  fw_info->run_without_model = 1;
+  return 0;
 }
 
 /**
- * @brief Test for decoder subplugins with invalid parameter
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
  */
-TEST (testDecoderSubplugins, flatbufInvalidParam2_n)
+static int
+test_in_place_getModelInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info)
 {
-  const gchar *mode_name = "flatbuf";
-  GstTensorsConfig config;
-  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
-  const GstTensorDecoderDef *fb_dec;
-
-  /** Find  decoder subplugins */
-  fb_dec = nnstreamer_decoder_find (mode_name);
-  ASSERT_TRUE (fb_dec);
+  if (ops == SET_INPUT_INFO) {
+    gst_tensors_info_copy (out_info, in_info);
+    return 0;
+  }
 
-  gst_tensors_config_init (&config);
-  EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, &config, input, NULL));
+  return -ENOENT;
 }
 
 /**
- * @brief Test for converter subplugins with invalid parameter
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
  */
-TEST (testConverterSubplugins, flatbufInvalidParam0_n)
+static int
+test_in_place_eventHandler (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data, event_ops ops,
+    GstTensorFilterFrameworkEventData *data)
 {
-  const gchar *mode_name = "flatbuf";
-  GstBuffer *conv_out_buf = NULL;
-  GstTensorsConfig config;
-  const NNStreamerExternalConverter *fb_conv;
-
-  /** Find converter subplugins */
-  fb_conv = nnstreamer_converter_find (mode_name);
-  ASSERT_TRUE (fb_conv);
-
-  gst_tensors_config_init (&config);
-  conv_out_buf = fb_conv->convert (NULL, &config, NULL);
-
-  EXPECT_TRUE (NULL == conv_out_buf);
-  gst_tensors_config_free (&config);
+  return -ENOENT;
 }
 
 /**
- * @brief Test for converter subplugins with invalid parameter
+ * @brief Test for in-place invoke in tensor_filter
  */
-TEST (testConverterSubplugins, flatbufInvalidParam1_n)
+TEST (testTensorFilter, inPlaceInvoke)
 {
-  const gchar *mode_name = "flatbuf";
-  GstBuffer *in_buf = NULL, *conv_out_buf = NULL;
-  GstTensorsConfig config;
-  const NNStreamerExternalConverter *fb_conv;
-
-  /** Find converter subplugins */
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *in_mem;
+  GstMapInfo map;
+  GstTensorConfig config;
+  gsize i;
+  const gsize data_size = 10;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h, "tensor_filter framework=custom-in-place");
+
+  /* input tensor info */
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  /* writable input, the output is written into the input memory */
+  in_buf = gst_harness_create_buffer (h, data_size);
+  in_mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (in_mem, &map, GST_MAP_WRITE));
+  for (i = 0; i < data_size; i++)
+    map.data[i] = (guint8) i;
+  gst_memory_unmap (in_mem, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) == in_mem);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  for (i = 0; i < data_size; i++)
+    EXPECT_EQ (map.data[i], (guint8) (i + 1));
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  /* input is not writable, the output is written into new memory */
+  in_buf = gst_harness_create_buffer (h, data_size);
+  in_mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (in_mem, &map, GST_MAP_WRITE));
+  for (i = 0; i < data_size; i++)
+    map.data[i] = (guint8) i;
+  gst_memory_unmap (in_mem, &map);
+
+  gst_buffer_ref (in_buf);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) != in_mem);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  for (i = 0; i < data_size; i++)
+    EXPECT_EQ (map.data[i], (guint8) (i + 1));
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  /* the input is not changed */
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_READ));
+  for (i = 0; i < data_size; i++)
+    EXPECT_EQ (map.data[i], (guint8) i);
+  gst_buffer_unmap (in_buf, &map);
+  gst_buffer_unref (in_buf);
+
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the allocation query with input-alignment of tensor_filter
+ */
+TEST (testTensorFilter, inputAlignment)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstBufferPool *pool = NULL;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+  GstQuery *query;
+  GstMapInfo map;
+  GstTensorConfig config;
+  GstCaps *caps;
+  gpointer data;
+  guint size, align = 0;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  caps = gst_tensor_caps_from_config (&config);
+
+  h = gst_harness_new_parse ("tensor_filter framework=custom-in-place input-alignment=64");
+  ASSERT_TRUE (h != NULL);
+
+  /* invalid alignment is ignored */
+  gst_harness_set (h, "tensor_filter", "input-alignment", 3U, NULL);
+  gst_harness_get (h, "tensor_filter", "input-alignment", &align, NULL);
+  EXPECT_EQ (align, 64U);
+
+  gst_harness_set_src_caps (h, gst_caps_ref (caps));
+
+  /* push a buffer to decide the allocation with downstream */
+  EXPECT_EQ (gst_harness_push (h, gst_harness_create_buffer (h, 10)), GST_FLOW_OK);
+  gst_buffer_unref (gst_harness_pull (h));
+
+  query = gst_query_new_allocation (caps, TRUE);
+  EXPECT_TRUE (gst_pad_peer_query (h->srcpad, query));
+
+  ASSERT_GE (gst_query_get_n_allocation_params (query), 1U);
+  gst_query_parse_nth_allocation_param (query, 0, &allocator, &params);
+  EXPECT_EQ (params.align, 63U);
+  if (allocator)
+    gst_object_unref (allocator);
+
+  ASSERT_EQ (gst_query_get_n_allocation_pools (query), 1U);
+  gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, NULL, NULL);
+  EXPECT_EQ (size, 10U);
+  ASSERT_TRUE (pool != NULL);
+
+  EXPECT_TRUE (gst_buffer_pool_set_active (pool, TRUE));
+  EXPECT_EQ (gst_buffer_pool_acquire_buffer (pool, &in_buf, NULL), GST_FLOW_OK);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_READ));
+  EXPECT_EQ (((guintptr) map.data) & 63U, 0U);
+  gst_buffer_unmap (in_buf, &map);
+  gst_buffer_unref (in_buf);
+  EXPECT_TRUE (gst_buffer_pool_set_active (pool, FALSE));
+
+  gst_object_unref (pool);
+  gst_query_unref (query);
+  gst_harness_teardown (h);
+
+  /* tensor_transform allocates the output from the pool proposed by tensor_filter */
+  h = gst_harness_new_parse ("tensor_transform mode=arithmetic option=add:1 ! "
+      "tensor_filter framework=custom-in-place input-alignment=64");
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_set_src_caps (h, gst_caps_ref (caps));
+
+  in_buf = gst_harness_create_buffer (h, 10);
+  gst_buffer_memset (in_buf, 0, 0, 10);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_EQ (((guintptr) map.data) & 63U, 0U);
+  EXPECT_EQ (map.data[0], 2U);
+  data = map.data;
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  /* the memory goes back to the pool and is recycled */
+  EXPECT_EQ (gst_harness_push (h, gst_harness_create_buffer (h, 10)), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data == data);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+  gst_caps_unref (caps);
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Callback to record the memory of the buffer pushed into tensor_filter.
+ */
+static GstPadProbeReturn
+test_in_place_probe (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+
+  *((GstMemory **) user_data) = gst_buffer_peek_memory (buf, 0);
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Test for the pipeline taking the in-place path with the aligned memory proposed by tensor_filter.
+ */
+TEST (testTensorFilter, inPlacePipeline)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstElement *filter;
+  GstPad *sinkpad;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *in_mem = NULL;
+  GstMapInfo map;
+  GstTensorConfig config;
+  guint i;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h = gst_harness_new_parse ("tensor_transform mode=arithmetic option=add:1 ! "
+      "tensor_filter framework=custom-in-place input-alignment=64");
+  ASSERT_TRUE (h != NULL);
+
+  filter = gst_harness_find_element (h, "tensor_filter");
+  ASSERT_TRUE (filter != NULL);
+  sinkpad = gst_element_get_static_pad (filter, "sink");
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER, test_in_place_probe,
+      &in_mem, NULL);
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  for (i = 0; i < 3; i++) {
+    in_buf = gst_harness_create_buffer (h, 10);
+    gst_buffer_memset (in_buf, 0, i, 10);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* the model writes the output into the aligned memory from tensor_transform */
+    out_buf = gst_harness_pull (h);
+    EXPECT_TRUE (gst_base_transform_is_in_place (GST_BASE_TRANSFORM (filter)));
+    EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) == in_mem);
+
+    ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+    EXPECT_EQ (((guintptr) map.data) & 63U, 0U);
+    EXPECT_EQ (map.data[0], i + 2);
+    gst_buffer_unmap (out_buf, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  gst_object_unref (sinkpad);
+  gst_object_unref (filter);
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Name of the custom filter to test the output ring.
+ */
+static const char test_fw_ring_name[] = "custom-ring";
+
+/**
+ * @brief Number of the slots in the output ring.
+ */
+#define TEST_RING_SLOTS (2)
+
+/**
+ * @brief Data for the output ring of the custom filter.
+ */
+typedef struct
+{
+  guint8 data[TEST_RING_SLOTS][16]; /**< The memory block of each slot */
+  GstTensorMemory slots[TEST_RING_SLOTS * NNS_TENSOR_SIZE_LIMIT]; /**< The output tensors of each slot */
+  guint released[TEST_RING_SLOTS]; /**< The number of released slots */
+  gboolean ring_released; /**< TRUE if the ring is released */
+} test_ring_data_s;
+
+static test_ring_data_s test_ring_data;
+
+/**
+ * @brief Callback to return the slot of the output ring.
+ */
+static void
+test_ring_release_slot (void *ring_data, unsigned int slot)
+{
+  test_ring_data_s *rdata = (test_ring_data_s *) ring_data;
+
+  ASSERT_LT (slot, (unsigned int) TEST_RING_SLOTS);
+  rdata->released[slot]++;
+}
+
+/**
+ * @brief Callback to return the output ring.
+ */
+static void
+test_ring_release_ring (void *ring_data)
+{
+  test_ring_data_s *rdata = (test_ring_data_s *) ring_data;
+
+  rdata->ring_released = TRUE;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
+ */
+static int
+test_ring_getFWInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  memset (fw_info, 0, sizeof (GstTensorFilterFrameworkInfo));
+  fw_info->name = test_fw_ring_name;
+  fw_info->run_without_model = 1;
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), providing the output ring.
+ */
+static int
+test_ring_eventHandler (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data, event_ops ops,
+    GstTensorFilterFrameworkEventData *data)
+{
+  guint n;
+
+  if (ops != GET_OUTPUT_RING)
+    return -ENOENT;
+
+  for (n = 0; n < TEST_RING_SLOTS; n++) {
+    test_ring_data.slots[n * NNS_TENSOR_SIZE_LIMIT].data = test_ring_data.data[n];
+    test_ring_data.slots[n * NNS_TENSOR_SIZE_LIMIT].size = sizeof (test_ring_data.data[n]);
+  }
+
+  data->num_slots = TEST_RING_SLOTS;
+  data->slots = test_ring_data.slots;
+  data->release_slot = test_ring_release_slot;
+  data->release_ring = test_ring_release_ring;
+  data->ring_data = &test_ring_data;
+  return 0;
+}
+
+/**
+ * @brief Test for the output ring owned by the subplugin
+ */
+TEST (testTensorFilter, outputRing)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf[3];
+  GstMapInfo map;
+  GstTensorConfig config;
+  gboolean cache = TRUE;
+  gsize i;
+  guint k;
+  const gsize data_size = 10;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_ring_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_ring_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  memset (&test_ring_data, 0, sizeof (test_ring_data));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h, "tensor_filter framework=custom-ring");
+
+  /* input tensor info */
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  /* the output is written into the slots in order */
+  for (k = 0; k < TEST_RING_SLOTS; k++) {
+    in_buf = gst_harness_create_buffer (h, data_size);
+    ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+    for (i = 0; i < data_size; i++)
+      map.data[i] = (guint8) (i + k);
+    gst_buffer_unmap (in_buf, &map);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    out_buf[k] = gst_harness_pull (h);
+    EXPECT_EQ (gst_buffer_n_memory (out_buf[k]), 1U);
+
+    ASSERT_TRUE (gst_buffer_map (out_buf[k], &map, GST_MAP_READ));
+    EXPECT_TRUE (map.data == test_ring_data.data[k]);
+    EXPECT_EQ (map.size, data_size);
+    for (i = 0; i < data_size; i++)
+      EXPECT_EQ (map.data[i], (guint8) (i + k + 1));
+    gst_buffer_unmap (out_buf[k], &map);
+  }
+
+  /* downstream releases the first slot, and the next output reuses it */
+  EXPECT_EQ (test_ring_data.released[0], 0U);
+  gst_buffer_unref (out_buf[0]);
+  EXPECT_EQ (test_ring_data.released[0], 1U);
+
+  in_buf = gst_harness_create_buffer (h, data_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf[2] = gst_harness_pull (h);
+  ASSERT_TRUE (gst_buffer_map (out_buf[2], &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data == test_ring_data.data[0]);
+  gst_buffer_unmap (out_buf[2], &map);
+
+  /* the cached outputs would hold the slots, invoke-cache is rejected */
+  gst_harness_set (h, "tensor_filter", "invoke-cache", TRUE, NULL);
+  gst_harness_get (h, "tensor_filter", "invoke-cache", &cache, NULL);
+  EXPECT_FALSE (cache);
+
+  /* the ring is returned when the slots in use are released */
+  gst_harness_teardown (h);
+  EXPECT_FALSE (test_ring_data.ring_released);
+
+  gst_buffer_unref (out_buf[1]);
+  gst_buffer_unref (out_buf[2]);
+  EXPECT_EQ (test_ring_data.released[0], 2U);
+  EXPECT_EQ (test_ring_data.released[1], 1U);
+  EXPECT_TRUE (test_ring_data.ring_released);
+
+  nnstreamer_filter_exit (test_fw_ring_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Name of the custom filter to test the shared model.
+ */
+static const char test_fw_shared_name[] = "custom-shared";
+
+/**
+ * @brief Number of the opened contexts of the custom filter to test the shared model.
+ */
+static gint test_shared_opened = 0;
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v1).
+ */
+static int
+test_shared_open (const GstTensorFilterProperties *prop, void **private_data)
+{
+  *private_data = g_new0 (gint, 1);
+  g_atomic_int_inc (&test_shared_opened);
+  return 0;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v1).
+ */
+static void
+test_shared_close (const GstTensorFilterProperties *prop, void **private_data)
+{
+  g_free (*private_data);
+  *private_data = NULL;
+  g_atomic_int_add (&test_shared_opened, -1);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
+ */
+static int
+test_shared_getFWInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  memset (fw_info, 0, sizeof (GstTensorFilterFrameworkInfo));
+  fw_info->name = test_fw_shared_name;
+  fw_info->run_without_model = 1;
+  return 0;
+}
+
+/**
+ * @brief Test for the shared model with the pool of contexts.
+ */
+TEST (testTensorFilter, sharedModelPool)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h1, *h2;
+  GstTensorConfig config;
+  GstCaps *caps;
+  gchar *stats = NULL;
+  guint i;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_shared_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h1 = gst_harness_new_parse ("tensor_filter framework=custom-shared "
+      "shared-tensor-filter-key=test_shared_key shared-pool-size=2");
+  h2 = gst_harness_new_parse ("tensor_filter framework=custom-shared "
+      "shared-tensor-filter-key=test_shared_key shared-pool-size=2");
+  ASSERT_TRUE (h1 != NULL && h2 != NULL);
+
+  caps = gst_tensor_caps_from_config (&config);
+  gst_harness_set_src_caps (h1, gst_caps_ref (caps));
+  gst_harness_set_src_caps (h2, caps);
+
+  for (i = 0; i < 2; i++) {
+    EXPECT_EQ (gst_harness_push (h1, gst_harness_create_buffer (h1, 10)), GST_FLOW_OK);
+    gst_buffer_unref (gst_harness_pull (h1));
+    EXPECT_EQ (gst_harness_push (h2, gst_harness_create_buffer (h2, 10)), GST_FLOW_OK);
+    gst_buffer_unref (gst_harness_pull (h2));
+  }
+
+  /* sequential invokes do not grow the pool */
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+
+  gst_harness_get (h1, "tensor_filter", "shared-pool-stats", &stats, NULL);
+  EXPECT_STREQ (stats, "contexts=1,invokes=4,contentions=0,avg-wait=0");
+  g_free (stats);
+
+  /* the context is closed when the last tensor_filter is closed */
+  gst_harness_teardown (h1);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+  gst_harness_teardown (h2);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 0);
+
+  nnstreamer_filter_exit (test_fw_shared_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Number of invokes of the custom filter to test the invoke cache.
+ */
+static guint test_cache_invoke_count = 0;
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), counting the invokes.
+ */
+static int
+test_cache_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  test_cache_invoke_count++;
+  return test_in_place_invoke (self, prop, private_data, input, output);
+}
+
+/**
+ * @brief Push the buffer filled with the value and pull the output.
+ */
+static GstBuffer *
+test_cache_push_and_pull (GstHarness *h, guint8 value)
+{
+  GstBuffer *in_buf;
+  GstMapInfo map;
+
+  in_buf = gst_harness_create_buffer (h, 10);
+  EXPECT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  memset (map.data, value, map.size);
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  return gst_harness_pull (h);
+}
+
+/**
+ * @brief Test for the invoke cache of tensor_filter.
+ */
+TEST (testTensorFilter, invokeCache)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstTensorConfig config;
+  GstBuffer *out_buf1, *out_buf2, *out_buf3;
+  GstMapInfo map;
+  guint64 hits, misses;
+  gboolean cache = TRUE;
+  guint i;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_cache_invoke;
+  fw->getFrameworkInfo = test_shared_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h = gst_harness_new_parse ("tensor_filter framework=custom-shared invoke-cache=true");
+  ASSERT_TRUE (h != NULL);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  test_cache_invoke_count = 0;
+
+  /* invoked, the output is held in the cache and shared without copying */
+  out_buf1 = test_cache_push_and_pull (h, 1);
+  out_buf2 = test_cache_push_and_pull (h, 1);
+  out_buf3 = test_cache_push_and_pull (h, 1);
+  EXPECT_EQ (test_cache_invoke_count, 1U);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf1, 0) == gst_buffer_peek_memory (out_buf2, 0));
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf2, 0) == gst_buffer_peek_memory (out_buf3, 0));
+
+  /* the cached output is not writable */
+  EXPECT_FALSE (gst_memory_is_writable (gst_buffer_peek_memory (out_buf1, 0)));
+
+  ASSERT_TRUE (gst_buffer_map (out_buf2, &map, GST_MAP_READ));
+  for (i = 0; i < map.size; i++)
+    EXPECT_EQ (map.data[i], 2U);
+  gst_buffer_unmap (out_buf2, &map);
+
+  gst_buffer_unref (out_buf1);
+  gst_buffer_unref (out_buf2);
+  gst_buffer_unref (out_buf3);
+
+  /* new input */
+  gst_buffer_unref (test_cache_push_and_pull (h, 5));
+  EXPECT_EQ (test_cache_invoke_count, 2U);
+
+  gst_buffer_unref (test_cache_push_and_pull (h, 1));
+  EXPECT_EQ (test_cache_invoke_count, 2U);
+
+  gst_harness_get (h, "tensor_filter", "invoke-cache-hits", &hits,
+      "invoke-cache-misses", &misses, NULL);
+  EXPECT_EQ (hits, 3U);
+  EXPECT_EQ (misses, 2U);
+
+  /* disable the cache */
+  gst_harness_set (h, "tensor_filter", "invoke-cache", FALSE, NULL);
+  gst_buffer_unref (test_cache_push_and_pull (h, 1));
+  EXPECT_EQ (test_cache_invoke_count, 3U);
+
+  gst_harness_teardown (h);
+
+  /* the frames in micro-batches are not looked up in the cache, invoke-cache is rejected */
+  h = gst_harness_new_parse ("tensor_filter framework=custom-shared batch-size=2");
+  ASSERT_TRUE (h != NULL);
+  gst_harness_set (h, "tensor_filter", "invoke-cache", TRUE, NULL);
+  gst_harness_get (h, "tensor_filter", "invoke-cache", &cache, NULL);
+  EXPECT_FALSE (cache);
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (test_fw_shared_name);
+  g_free (fw);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), fixed tensor info.
+ */
+static int
+test_warmup_getModelInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info)
+{
+  if (ops == GET_IN_OUT_INFO) {
+    gst_tensors_info_init (in_info);
+    in_info->num_tensors = 1;
+    in_info->info[0].type = _NNS_UINT8;
+    gst_tensor_parse_dimension ("10:1:1:1", in_info->info[0].dimension);
+
+    gst_tensors_info_copy (out_info, in_info);
+    return 0;
+  }
+
+  return -ENOENT;
+}
+
+/**
+ * @brief Test for preloading the model in background and the warm-up when the element starts.
+ */
+TEST (testTensorFilter, warmupPreload)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstTensorConfig config;
+  gint64 warmup_time, first_latency;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_cache_invoke;
+  fw->getFrameworkInfo = test_shared_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  test_cache_invoke_count = 0;
+
+  h = gst_harness_new_parse (
+      "tensor_filter framework=custom-shared preload=true warmup-iterations=3");
+  ASSERT_TRUE (h != NULL);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  /* the model is opened and warmed up before the first frame */
+  EXPECT_EQ (test_cache_invoke_count, 3U);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+
+  gst_harness_get (h, "tensor_filter", "warmup-time", &warmup_time,
+      "first-frame-latency", &first_latency, NULL);
+  EXPECT_GE (warmup_time, 0);
+  EXPECT_EQ (first_latency, -1);
+
+  gst_buffer_unref (test_cache_push_and_pull (h, 1));
+  EXPECT_EQ (test_cache_invoke_count, 4U);
+
+  gst_harness_get (h, "tensor_filter", "first-frame-latency", &first_latency, NULL);
+  EXPECT_GE (first_latency, 0);
+
+  gst_harness_teardown (h);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 0);
+
+  nnstreamer_filter_exit (test_fw_shared_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the framework preloaded in background and closed without starting the element.
+ */
+TEST (testTensorFilter, preloadCloseInNull)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstElement *filter;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_cache_invoke;
+  fw->getFrameworkInfo = test_shared_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  filter = gst_element_factory_make ("tensor_filter", NULL);
+  ASSERT_TRUE (filter != NULL);
+  g_object_set (filter, "framework", test_fw_shared_name, "preload", TRUE, NULL);
+
+  EXPECT_EQ (gst_element_set_state (filter, GST_STATE_READY), GST_STATE_CHANGE_SUCCESS);
+
+  /* the property used to open the framework waits for the background thread */
+  g_object_set (filter, "custom", "test", NULL);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+
+  /* the framework is closed though the background thread is already joined */
+  EXPECT_EQ (gst_element_set_state (filter, GST_STATE_NULL), GST_STATE_CHANGE_SUCCESS);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 0);
+
+  gst_object_unref (filter);
+
+  nnstreamer_filter_exit (test_fw_shared_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the model hot swap of tensor_filter.
+ */
+TEST (testTensorFilter, modelHotSwap)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstElement *filter;
+  GstBus *bus;
+  GstMessage *msg = NULL;
+  GstTensorConfig config;
+  gchar *model = NULL;
+  gboolean validated = FALSE;
+  gint64 swap_time = -1;
+  guint i;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_cache_invoke;
+  fw->getFrameworkInfo = test_shared_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h,
+      "tensor_filter framework=custom-shared is-updatable=true hot-swap=true");
+  filter = gst_harness_find_element (h, "tensor_filter");
+  ASSERT_TRUE (filter != NULL);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (filter, bus);
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  gst_buffer_unref (test_cache_push_and_pull (h, 1));
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+
+  /* load new model in background, the running model keeps invoking */
+  g_object_set (filter, "model", "new.model", NULL);
+
+  for (i = 0; i < 100 && msg == NULL; i++) {
+    gst_buffer_unref (test_cache_push_and_pull (h, 1));
+    msg = gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT);
+    if (msg == NULL)
+      g_usleep (10000);
+  }
+
+  ASSERT_TRUE (msg != NULL);
+  EXPECT_TRUE (gst_structure_has_name (gst_message_get_structure (msg),
+      "nnstreamer-model-swap"));
+  gst_structure_get (gst_message_get_structure (msg), "swap-time",
+      G_TYPE_INT64, &swap_time, "validated", G_TYPE_BOOLEAN, &validated, NULL);
+  EXPECT_GE (swap_time, 0);
+  EXPECT_TRUE (validated);
+  gst_message_unref (msg);
+
+  /* the old model is closed */
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+  g_object_get (filter, "model", &model, NULL);
+  EXPECT_STREQ (model, "new.model");
+  g_free (model);
+
+  gst_element_set_bus (filter, NULL);
+  gst_object_unref (bus);
+  gst_object_unref (filter);
+  gst_harness_teardown (h);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 0);
+
+  nnstreamer_filter_exit (test_fw_shared_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the cpu affinity and scheduling priority of tensor_filter.
+ */
+TEST (testTensorFilter, threadPolicy)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  gchar *cpus = NULL;
+  gint priority;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  h = gst_harness_new_parse ("tensor_filter framework=custom-in-place cpu-affinity=0");
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &cpus,
+      "sched-priority", &priority, NULL);
+  EXPECT_STREQ (cpus, "0");
+  EXPECT_EQ (priority, 0);
+  g_free (cpus);
+
+  /* range of cores */
+  gst_harness_set (h, "tensor_filter", "cpu-affinity", "0-2, 5", NULL);
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "0,1,2,5");
+  g_free (cpus);
+
+  /* invalid range, keep the old value */
+  gst_harness_set (h, "tensor_filter", "cpu-affinity", "3-1", NULL);
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "0,1,2,5");
+  g_free (cpus);
+
+  gst_harness_set (h, "tensor_filter", "sched-priority", -1, NULL);
+  gst_harness_get (h, "tensor_filter", "sched-priority", &priority, NULL);
+  EXPECT_EQ (priority, -1);
+
+  /* clear the affinity */
+  gst_harness_set (h, "tensor_filter", "cpu-affinity", "", NULL);
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "");
+  g_free (cpus);
+
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+
+#if defined(__linux__)
+/**
+ * @brief Test for the thread policy restored when tensor_filter stops.
+ */
+TEST (testTensorFilter, threadPolicyRestore)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorConfig config;
+  cpu_set_t old_set, set;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  ASSERT_EQ (sched_getaffinity (0, sizeof (cpu_set_t), &old_set), 0);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h = gst_harness_new_parse ("tensor_filter framework=custom-in-place cpu-affinity=0");
+  ASSERT_TRUE (h != NULL);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 10);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  EXPECT_TRUE (out_buf != NULL);
+  if (out_buf)
+    gst_buffer_unref (out_buf);
+
+  /* the thread pushing the buffer is pinned, if the core is available */
+  if (CPU_ISSET (0, &old_set)) {
+    ASSERT_EQ (sched_getaffinity (0, sizeof (cpu_set_t), &set), 0);
+    EXPECT_EQ (CPU_COUNT (&set), 1);
+    EXPECT_TRUE (CPU_ISSET (0, &set));
+  }
+
+  /* the old affinity is restored when the element stops */
+  gst_harness_teardown (h);
+
+  ASSERT_EQ (sched_getaffinity (0, sizeof (cpu_set_t), &set), 0);
+  EXPECT_TRUE (CPU_EQUAL (&set, &old_set));
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+#endif
+
+/**
+ * @brief Test for deadline mode of tensor_filter.
+ */
+TEST (testTensorFilter, deadlineDrop)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstEvent *event;
+  GstTensorConfig config;
+  guint64 dropped;
+  gboolean received_qos = FALSE;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h = gst_harness_new_parse ("tensor_filter framework=custom-in-place deadline=10");
+  ASSERT_TRUE (h != NULL);
+  gst_harness_use_testclock (h);
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  EXPECT_TRUE (gst_harness_set_time (h, GST_SECOND));
+
+  /* in time */
+  in_buf = gst_harness_create_buffer (h, 10);
+  GST_BUFFER_PTS (in_buf) = GST_SECOND;
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_try_pull (h);
+  EXPECT_TRUE (out_buf != NULL);
+  if (out_buf)
+    gst_buffer_unref (out_buf);
+
+  /* late frame (e.g., backlogged), dropped without invoking */
+  in_buf = gst_harness_create_buffer (h, 10);
+  GST_BUFFER_PTS (in_buf) = 500 * GST_MSECOND;
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_TRUE (gst_harness_try_pull (h) == NULL);
+
+  gst_harness_get (h, "tensor_filter", "deadline-dropped", &dropped, NULL);
+  EXPECT_EQ (dropped, 1U);
+
+  /* qos event to upstream */
+  while ((event = gst_harness_try_pull_upstream_event (h)) != NULL) {
+    if (GST_EVENT_TYPE (event) == GST_EVENT_QOS)
+      received_qos = TRUE;
+    gst_event_unref (event);
+  }
+  EXPECT_TRUE (received_qos);
+
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for latency percentiles of tensor_filter.
+ */
+TEST (testTensorFilter, latencyPercentiles)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstHarness *h;
+  GstElement *filter;
+  GstBuffer *in_buf;
+  GstTensorConfig config;
+  gint64 p50, p90, p99, max;
+  guint i;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_in_place_invoke;
+  fw->getFrameworkInfo = test_in_place_getFWInfo;
+  fw->getModelInfo = test_in_place_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h, "tensor_filter framework=custom-in-place latency=1");
+  filter = gst_harness_find_element (h, "tensor_filter");
+  ASSERT_TRUE (filter != NULL);
+
+  /* nothing recorded yet */
+  g_object_get (filter, "latency-p50", &p50, "latency-max", &max, NULL);
+  EXPECT_EQ (p50, -1);
+  EXPECT_EQ (max, -1);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+
+  for (i = 0; i < 20; i++) {
+    in_buf = gst_harness_create_buffer (h, 10);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+    gst_buffer_unref (gst_harness_pull (h));
+  }
+
+  g_object_get (filter, "latency-p50", &p50, "latency-p90", &p90,
+      "latency-p99", &p99, "latency-max", &max, NULL);
+  EXPECT_GE (p50, 0);
+  EXPECT_LE (p50, p90);
+  EXPECT_LE (p90, p99);
+  EXPECT_LE (p99, max);
+
+  /* reset the histogram */
+  g_signal_emit_by_name (filter, "reset-latency");
+  g_object_get (filter, "latency-p99", &p99, "latency-max", &max, NULL);
+  EXPECT_EQ (p99, -1);
+  EXPECT_EQ (max, -1);
+
+  gst_object_unref (filter);
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (test_fw_in_place_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Name of the custom filter to test the concurrent invokes of single-shot.
+ */
+static const char test_fw_single_name[] = "custom-single";
+
+/**
+ * @brief Number of the running invokes and the max number of concurrent invokes.
+ */
+static gint test_single_running = 0;
+static gint test_single_max_running = 0;
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), slow invoke.
+ */
+static int
+test_single_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  gint running, max_running;
+
+  running = g_atomic_int_add (&test_single_running, 1) + 1;
+  do {
+    max_running = g_atomic_int_get (&test_single_max_running);
+  } while (running > max_running
+           && !g_atomic_int_compare_and_exchange (&test_single_max_running, max_running, running));
+
+  /* each context is used by one thread at once */
+  EXPECT_EQ (g_atomic_int_add ((gint *) private_data, 1), 0);
+  g_usleep (2000);
+  g_atomic_int_add ((gint *) private_data, -1);
+
+  g_atomic_int_add (&test_single_running, -1);
+  return test_in_place_invoke (self, prop, private_data, input, output);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1).
+ */
+static int
+test_single_getFWInfo (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    GstTensorFilterFrameworkInfo *fw_info)
+{
+  memset (fw_info, 0, sizeof (GstTensorFilterFrameworkInfo));
+  fw_info->name = test_fw_single_name;
+  fw_info->run_without_model = 1;
+  return 0;
+}
+
+/**
+ * @brief Number of invokes in each thread to test the single-shot.
+ */
+#define TEST_SINGLE_INVOKES (50)
+
+/**
+ * @brief Thread to invoke the single-shot instance.
+ */
+static gpointer
+test_single_invoke_thread (gpointer data)
+{
+  GTensorFilterSingle *single = G_TENSOR_FILTER_SINGLE (data);
+  GTensorFilterSingleClass *klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  guint8 in_data[10];
+  guint i;
+
+  memset (in_data, 3, sizeof (in_data));
+  input[0].data = in_data;
+  input[0].size = sizeof (in_data);
+
+  for (i = 0; i < TEST_SINGLE_INVOKES; i++) {
+    output[0].size = sizeof (in_data);
+    EXPECT_TRUE (klass->invoke (single, input, output, TRUE));
+    EXPECT_EQ (((guint8 *) output[0].data)[0], 4U);
+
+    /* give back the output to be reused */
+    klass->release_output (single, output);
+    EXPECT_TRUE (output[0].data == NULL);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Invoke the single-shot instance from the threads.
+ */
+static void
+test_single_run_threads (GTensorFilterSingle *single, guint num_threads)
+{
+  GThread *threads[4];
+  guint i;
+
+  g_atomic_int_set (&test_single_max_running, 0);
+  for (i = 0; i < num_threads; i++)
+    threads[i] = g_thread_new ("single", test_single_invoke_thread, single);
+  for (i = 0; i < num_threads; i++)
+    g_thread_join (threads[i]);
+}
+
+/**
+ * @brief Test for the concurrent invokes of single-shot with the pool of contexts.
+ */
+TEST (testTensorFilterSingle, concurrentInvoke)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  const guint num_threads[3] = { 1, 2, 4 };
+  gchar *stats = NULL;
+  guint64 hits, misses;
+  guint i, contexts = 0;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_single_invoke;
+  fw->getFrameworkInfo = test_single_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE,
+      "framework", test_fw_single_name, "context-pool-size", 4, NULL);
+  ASSERT_TRUE (single != NULL);
+  klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+  ASSERT_TRUE (klass->start (single));
+
+  for (i = 0; i < 3; i++)
+    test_single_run_threads (single, num_threads[i]);
+
+  /* the contexts are opened on demand, up to the pool size, and invoked at once */
+  EXPECT_GT (g_atomic_int_get (&test_single_max_running), 1);
+  EXPECT_LE (g_atomic_int_get (&test_single_max_running), 4);
+
+  g_object_get (single, "shared-pool-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_EQ (sscanf (stats, "contexts=%u,", &contexts), 1);
+  EXPECT_LE (contexts, 4U);
+  EXPECT_EQ ((gint) contexts, g_atomic_int_get (&test_shared_opened));
+  g_free (stats);
+
+  /* the output is reused after the first invoke of each thread */
+  g_object_get (single, "output-pool-hits", &hits, "output-pool-misses", &misses, NULL);
+  EXPECT_EQ (hits + misses, (guint64) (1 + 2 + 4) * TEST_SINGLE_INVOKES);
+  EXPECT_LE (misses, 4U);
+
+  EXPECT_TRUE (klass->stop (single));
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 0);
+  g_object_unref (single);
+
+  nnstreamer_filter_exit (test_fw_single_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the invokes of single-shot without the pool of contexts, which wait for each other.
+ */
+TEST (testTensorFilterSingle, serialInvoke)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  guint pool_size = 0, cache_size = 0;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_single_invoke;
+  fw->getFrameworkInfo = test_single_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE,
+      "framework", test_fw_single_name, NULL);
+  ASSERT_TRUE (single != NULL);
+  klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+
+  g_object_get (single, "context-pool-size", &pool_size,
+      "output-cache-size", &cache_size, NULL);
+  EXPECT_EQ (pool_size, 1U);
+  EXPECT_EQ (cache_size, 4U);
+
+  ASSERT_TRUE (klass->start (single));
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+
+  /* one context, the invokes run one by one */
+  test_single_run_threads (single, 4);
+  EXPECT_EQ (g_atomic_int_get (&test_single_max_running), 1);
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 1);
+
+  EXPECT_TRUE (klass->stop (single));
+  EXPECT_EQ (g_atomic_int_get (&test_shared_opened), 0);
+  g_object_unref (single);
+
+  nnstreamer_filter_exit (test_fw_single_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the invoke with the registered buffers of single-shot.
+ */
+TEST (testTensorFilterSingle, registeredBuffers)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  GstTensorMemory user_output[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  guint8 in_data[10], out_data[10];
+  guint handle1, handle2, i;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_single_invoke;
+  fw->getFrameworkInfo = test_single_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE,
+      "framework", test_fw_single_name, NULL);
+  ASSERT_TRUE (single != NULL);
+  klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+
+  memset (in_data, 5, sizeof (in_data));
+  input[0].data = in_data;
+  input[0].size = sizeof (in_data);
+
+  /* the output is allocated and owned by the filter */
+  handle1 = klass->register_buffers (single, input, output, TRUE);
+  EXPECT_NE (handle1, 0U);
+  ASSERT_TRUE (output[0].data != NULL);
+  EXPECT_EQ (output[0].size, sizeof (in_data));
+
+  /* the output is given by the application */
+  user_output[0].data = out_data;
+  user_output[0].size = sizeof (out_data);
+  handle2 = klass->register_buffers (single, input, user_output, FALSE);
+  EXPECT_NE (handle2, 0U);
+  EXPECT_NE (handle1, handle2);
+
+  for (i = 0; i < 5; i++) {
+    in_data[0] = i;
+    EXPECT_TRUE (klass->invoke_registered (single, handle1));
+    EXPECT_EQ (((guint8 *) output[0].data)[0], i + 1);
+
+    EXPECT_TRUE (klass->invoke_registered (single, handle2));
+    EXPECT_EQ (out_data[0], i + 1);
+  }
+
+  klass->unregister_buffers (single, handle1);
+  klass->unregister_buffers (single, handle2);
+
+  /* unregistered handle */
+  EXPECT_FALSE (klass->invoke_registered (single, handle1));
+
+  EXPECT_TRUE (klass->stop (single));
+  g_object_unref (single);
+
+  nnstreamer_filter_exit (test_fw_single_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the registered buffers of single-shot with invalid size.
+ */
+TEST (testTensorFilterSingle, registeredBuffersInvalidSize_n)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT] = { 0 };
+  guint8 in_data[10], out_data[20];
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->open = test_shared_open;
+  fw->close = test_shared_close;
+  fw->invoke = test_single_invoke;
+  fw->getFrameworkInfo = test_single_getFWInfo;
+  fw->getModelInfo = test_warmup_getModelInfo;
+  fw->eventHandler = test_in_place_eventHandler;
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE,
+      "framework", test_fw_single_name, NULL);
+  ASSERT_TRUE (single != NULL);
+  klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+
+  input[0].data = in_data;
+  input[0].size = sizeof (in_data);
+  output[0].data = out_data;
+  output[0].size = sizeof (out_data);
+
+  /* the size of output is different from the tensor info */
+  EXPECT_EQ (klass->register_buffers (single, input, output, FALSE), 0U);
+
+  /* invalid input data */
+  input[0].data = NULL;
+  EXPECT_EQ (klass->register_buffers (single, input, output, TRUE), 0U);
+  EXPECT_TRUE (output[0].data == NULL);
+
+  EXPECT_FALSE (klass->invoke_registered (single, 100U));
+
+  EXPECT_TRUE (klass->stop (single));
+  g_object_unref (single);
+
+  nnstreamer_filter_exit (test_fw_single_name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for flatbuf, flexbuf and protobuf (tensors -> serialized buf -> tensors)
+ */
+TEST (testStreamBuffers, tensorsNormal)
+{
+  const gchar *mode_name[3] = { "flatbuf", "flexbuf", "protobuf" };
+  GstBuffer *dec_out_buf = NULL, *conv_out_buf = NULL;
+  GstTensorsConfig config, check_config;
+  GstMemory *mem;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstMapInfo info;
+  guint mode_idx, i, j;
+  const GstTensorDecoderDef *fb_dec;
+  const NNStreamerExternalConverter *fb_conv;
+
+  for (mode_idx = 0; mode_idx < 3; mode_idx++) {
+    /** Find converter and decoder subplugins */
+    fb_dec = nnstreamer_decoder_find (mode_name[mode_idx]);
+    fb_conv = nnstreamer_converter_find (mode_name[mode_idx]);
+    ASSERT_TRUE (fb_dec);
+    ASSERT_TRUE (fb_conv);
+
+    /** Prepare input */
+    gst_tensors_config_init (&config);
+    gst_tensors_config_init (&check_config);
+    config.rate_n = 0;
+    config.rate_d = 1;
+    config.info.num_tensors = 2;
+
+    config.info.info[0].type = _NNS_INT32;
+    gst_tensor_parse_dimension ("3:4:2:2", config.info.info[0].dimension);
+    config.info.info[1].name = g_strdup ("2nd_tensor");
+    config.info.info[1].type = _NNS_INT32;
+    gst_tensor_parse_dimension ("3:4:2:2", config.info.info[1].dimension);
+
+    for (i = 0; i < config.info.num_tensors; i++) {
+      input[i].size = gst_tensor_info_get_size (&config.info.info[i]);
+      input[i].data = g_malloc0 (input[0].size);
+      memcpy (input[i].data, aggr_test_frames[i], input[i].size);
+    }
+
+    /** Decode tensors to serialized buffers */
+    dec_out_buf = gst_buffer_new ();
+    fb_dec->decode (NULL, &config, input, dec_out_buf);
+
+    for (i = 0; i < config.info.num_tensors; i++) {
+      g_free (input[i].data);
+    }
+
+    EXPECT_TRUE (dec_out_buf != NULL);
+    EXPECT_EQ (gst_buffer_n_memory (dec_out_buf), 1U);
+
+    /** Convert flatbuf to tensors */
+    conv_out_buf = fb_conv->convert (dec_out_buf, &check_config, NULL);
+    EXPECT_EQ (gst_buffer_n_memory (conv_out_buf), 2U);
+
+    /** Check tensors config. */
+    EXPECT_TRUE (check_config.info.info[0].name == NULL);
+    EXPECT_STREQ ("2nd_tensor", check_config.info.info[1].name);
+    EXPECT_TRUE (gst_tensors_config_is_equal (&config, &check_config));
+    /** Check data */
+    for (i = 0; i < config.info.num_tensors; i++) {
+      mem = gst_buffer_peek_memory (conv_out_buf, i);
+      ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+      for (j = 0; j < 48; j++)
+        EXPECT_EQ (((gint *)info.data)[j], aggr_test_frames[i][j]);
+      gst_memory_unmap (mem, &info);
+    }
+
+    gst_tensors_config_free (&config);
+    gst_tensors_config_free (&check_config);
+    gst_buffer_unref (dec_out_buf);
+    gst_buffer_unref (conv_out_buf);
+  }
+}
+
+/**
+ * @brief Test for decoder subplugins with invalid parameter
+ */
+TEST (testDecoderSubplugins, flatbufInvalidParam0_n)
+{
+  const gchar *mode_name = "flatbuf";
+  GstBuffer *dec_out_buf = NULL;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  const GstTensorDecoderDef *fb_dec;
+
+  /** Find decoder subplugins */
+  fb_dec = nnstreamer_decoder_find (mode_name);
+  ASSERT_TRUE (fb_dec);
+
+  dec_out_buf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, NULL, input, dec_out_buf));
+
+  gst_buffer_unref (dec_out_buf);
+}
+
+/**
+ * @brief Test for decoder subplugins with invalid parameter
+ */
+TEST (testDecoderSubplugins, flatbufInvalidParam1_n)
+{
+  const gchar *mode_name = "flatbuf";
+  GstBuffer *dec_out_buf = NULL;
+  GstTensorsConfig config;
+  const GstTensorDecoderDef *fb_dec;
+
+  /** Find  decoder subplugins */
+  fb_dec = nnstreamer_decoder_find (mode_name);
+  ASSERT_TRUE (fb_dec);
+
+  gst_tensors_config_init (&config);
+  dec_out_buf = gst_buffer_new ();
+  EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, &config, NULL, dec_out_buf));
+
+  gst_tensors_config_free (&config);
+  gst_buffer_unref (dec_out_buf);
+}
+
+/**
+ * @brief Test for decoder subplugins with invalid parameter
+ */
+TEST (testDecoderSubplugins, flatbufInvalidParam2_n)
+{
+  const gchar *mode_name = "flatbuf";
+  GstTensorsConfig config;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  const GstTensorDecoderDef *fb_dec;
+
+  /** Find  decoder subplugins */
+  fb_dec = nnstreamer_decoder_find (mode_name);
+  ASSERT_TRUE (fb_dec);
+
+  gst_tensors_config_init (&config);
+  EXPECT_EQ (GST_FLOW_ERROR, fb_dec->decode (NULL, &config, input, NULL));
+}
+
+/**
+ * @brief Test for converter subplugins with invalid parameter
+ */
+TEST (testConverterSubplugins, flatbufInvalidParam0_n)
+{
+  const gchar *mode_name = "flatbuf";
+  GstBuffer *conv_out_buf = NULL;
+  GstTensorsConfig config;
+  const NNStreamerExternalConverter *fb_conv;
+
+  /** Find converter subplugins */
+  fb_conv = nnstreamer_converter_find (mode_name);
+  ASSERT_TRUE (fb_conv);
+
+  gst_tensors_config_init (&config);
+  conv_out_buf = fb_conv->convert (NULL, &config, NULL);
+
+  EXPECT_TRUE (NULL == conv_out_buf);
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Test for converter subplugins with invalid parameter
+ */
+TEST (testConverterSubplugins, flatbufInvalidParam1_n)
+{
+  const gchar *mode_name = "flatbuf";
+  GstBuffer *in_buf = NULL, *conv_out_buf = NULL;
+  GstTensorsConfig config;
+  const NNStreamerExternalConverter *fb_conv;
+
+  /** Find converter subplugins */
   fb_conv = nnstreamer_converter_find (mode_name);
   ASSERT_TRUE (fb_conv);
 
@@ -6984,6 +8716,132 @@ TEST (testTensorCrop, infoDelayed_n)
   _crop_test_free (&crop_test);
 }
 
+/**
+ * @brief Test for the model file mapped and shared in the process.
+ */
+TEST (testTensorFilter, sharedModelFile)
+{
+  const void *data1, *data2, *data3;
+  size_t size1 = 0, size2 = 0, size3 = 0;
+  struct utimbuf ut;
+  gchar *filename, *stats, *expected;
+  gint fd;
+
+  fd = g_file_open_tmp ("nnstreamer_model_XXXXXX", &filename, NULL);
+  ASSERT_GE (fd, 0);
+  close (fd);
+  ASSERT_TRUE (g_file_set_contents (filename, "dummy-model", -1, NULL));
+
+  /* the same file is mapped once */
+  data1 = nnstreamer_filter_model_file_ref (filename, &size1);
+  data2 = nnstreamer_filter_model_file_ref (filename, &size2);
+  ASSERT_TRUE (data1 != NULL);
+  EXPECT_TRUE (data1 == data2);
+  EXPECT_EQ (size1, strlen ("dummy-model"));
+  EXPECT_EQ (size2, size1);
+  EXPECT_EQ (memcmp (data1, "dummy-model", size1), 0);
+
+  stats = nnstreamer_filter_model_file_stats ();
+  expected = g_strdup_printf ("%s:size=%zu,refs=2", filename, size1);
+  EXPECT_TRUE (g_strstr_len (stats, -1, expected) != NULL);
+  g_free (expected);
+  g_free (stats);
+
+  /* the updated file is mapped again */
+  ut.actime = ut.modtime = time (NULL) + 10;
+  ASSERT_EQ (g_utime (filename, &ut), 0);
+
+  data3 = nnstreamer_filter_model_file_ref (filename, &size3);
+  ASSERT_TRUE (data3 != NULL);
+  EXPECT_TRUE (data3 != data1);
+  EXPECT_EQ (size3, size1);
+
+  nnstreamer_filter_model_file_unref (data1);
+  nnstreamer_filter_model_file_unref (data2);
+  nnstreamer_filter_model_file_unref (data3);
+
+  stats = nnstreamer_filter_model_file_stats ();
+  EXPECT_TRUE (g_strstr_len (stats, -1, filename) == NULL);
+  g_free (stats);
+
+  g_remove (filename);
+  g_free (filename);
+}
+
+/**
+ * @brief Test for the model file mapped and shared in the process with invalid file.
+ */
+TEST (testTensorFilter, sharedModelFileInvalid_n)
+{
+  size_t size = 0;
+
+  EXPECT_TRUE (nnstreamer_filter_model_file_ref ("/invalid/model/path", &size) == NULL);
+  EXPECT_TRUE (nnstreamer_filter_model_file_ref (NULL, &size) == NULL);
+  EXPECT_TRUE (nnstreamer_filter_model_file_ref ("/invalid/model/path", NULL) == NULL);
+
+  /* nothing happens with the data not mapped */
+  nnstreamer_filter_model_file_unref (NULL);
+  nnstreamer_filter_model_file_unref (&size);
+}
+
+/**
+ * @brief Test for nnstreamer tracer, the summary is written at EOS.
+ * @note The tracer is registered in the hooks and cannot be released. This should be the last test.
+ */
+TEST (testNNStreamerTracer, summaryAtEos)
+{
+  GstElement *pipeline;
+  GstBus *bus;
+  GstMessage *msg;
+  GObject *tracer;
+  GType tracer_type;
+  gchar *filename, *params, *contents = NULL;
+  gint fd;
+
+  fd = g_file_open_tmp ("nnstreamer_tracer_XXXXXX", &filename, NULL);
+  ASSERT_GE (fd, 0);
+  close (fd);
+
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=3 ! "
+      "video/x-raw,format=RGB,width=4,height=4,framerate=(fraction)30/1 ! "
+      "tensor_converter ! queue ! tensor_transform mode=typecast option=float32 ! "
+      "fakesink", NULL);
+  ASSERT_TRUE (pipeline != nullptr);
+
+  /* the tracer type is registered when the plugin is loaded */
+  tracer_type = g_type_from_name ("GstNNStreamerTracer");
+  ASSERT_NE (tracer_type, (GType) 0);
+
+  params = g_strdup_printf ("file=%s", filename);
+  tracer = (GObject *) g_object_new (tracer_type, "params", params, NULL);
+  g_free (params);
+  ASSERT_TRUE (tracer != nullptr);
+
+  EXPECT_NE (gst_element_set_state (pipeline, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND,
+      (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  ASSERT_TRUE (msg != nullptr);
+  EXPECT_EQ (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  EXPECT_TRUE (g_file_get_contents (filename, &contents, NULL, NULL));
+  EXPECT_TRUE (g_strstr_len (contents, -1, "nnstreamer tracer summary") != NULL);
+  EXPECT_TRUE (g_strstr_len (contents, -1, "tensor_converter") != NULL);
+  EXPECT_TRUE (g_strstr_len (contents, -1, "tensor_transform") != NULL);
+  EXPECT_TRUE (g_strstr_len (contents, -1, "videotestsrc") == NULL);
+
+  g_free (contents);
+  g_remove (filename);
+  g_free (filename);
+}
+
 /**
  * @brief Main function for unit test.
  */
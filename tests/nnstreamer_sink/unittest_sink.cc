@@ -113,6 +113,8 @@ typedef enum {
   TEST_TYPE_CUSTOM_MULTI, /**< pipeline with multiple custom filters */
   TEST_TYPE_CUSTOM_BUF_DROP, /**< pipeline to test buffer-drop in tensor_filter using custom filter */
   TEST_TYPE_CUSTOM_PASSTHROUGH, /**< pipeline to test custom passthrough without so file */
+  TEST_TYPE_CUSTOM_PASSTHROUGH_BATCH, /**< pipeline to test custom passthrough with micro-batching */
+  TEST_TYPE_CUSTOM_PASSTHROUGH_MULTI, /**< pipeline to test custom passthrough with multiple instances */
   TEST_TYPE_NEGO_FAILED, /**< pipeline to test caps negotiation */
   TEST_TYPE_VIDEO_RGB_SPLIT, /**< pipeline to test tensor_split */
   TEST_TYPE_VIDEO_RGB_AGGR_1, /**< pipeline to test tensor_aggregator (change dimension index 3 : 1 > 10)*/
@@ -162,6 +164,8 @@ typedef struct {
   guint mem_blocks; /**< memory blocks in received buffer */
   gsize received_size; /**< received buffer size */
   gboolean invalid_timestamp; /**< flag to check timestamp */
+  gboolean invalid_order; /**< flag to check the order of timestamp */
+  GstClockTime last_pts; /**< timestamp of the last received buffer */
   gboolean test_failed; /**< flag to indicate error */
   gboolean start; /**< stream started (for tensor_sink signal) */
   gboolean end; /**< eos reached (for tensor_sink signal) */
@@ -295,6 +299,13 @@ _new_data_cb (GstElement *element, GstBuffer *buffer, gpointer user_data)
     g_test_data.invalid_timestamp = TRUE;
   }
 
+  /** check the order of timestamp */
+  if (GST_CLOCK_TIME_IS_VALID (g_test_data.last_pts)
+      && GST_BUFFER_PTS (buffer) <= g_test_data.last_pts) {
+    g_test_data.invalid_order = TRUE;
+  }
+  g_test_data.last_pts = GST_BUFFER_PTS (buffer);
+
   g_test_data.received++;
   g_test_data.received_size = buf_size;
   g_test_data.mem_blocks = mem_blocks;
@@ -525,6 +536,8 @@ _setup_pipeline (TestOption &option)
   g_test_data.mem_blocks = 0;
   g_test_data.received_size = 0;
   g_test_data.invalid_timestamp = FALSE;
+  g_test_data.invalid_order = FALSE;
+  g_test_data.last_pts = GST_CLOCK_TIME_NONE;
   g_test_data.test_failed = FALSE;
   g_test_data.start = FALSE;
   g_test_data.end = FALSE;
@@ -938,6 +951,20 @@ _setup_pipeline (TestOption &option)
         "tensor_converter ! tensor_filter framework=custom-passthrough ! tensor_sink name=test_sink",
         option.num_buffers, fps);
     break;
+  case TEST_TYPE_CUSTOM_PASSTHROUGH_BATCH:
+    /* video 160x120 RGB, passthrough custom filter invoking 4 frames at once */
+    str_pipeline = g_strdup_printf (
+        "videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
+        "tensor_converter ! tensor_filter name=test_filter framework=custom-passthrough batch-size=4 ! tensor_sink name=test_sink",
+        option.num_buffers, fps);
+    break;
+  case TEST_TYPE_CUSTOM_PASSTHROUGH_MULTI:
+    /* video 160x120 RGB, passthrough custom filter with 3 instances */
+    str_pipeline = g_strdup_printf (
+        "videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
+        "tensor_converter ! tensor_filter name=test_filter framework=custom-passthrough num-instances=3 ! tensor_sink name=test_sink",
+        option.num_buffers, fps);
+    break;
   case TEST_TYPE_NEGO_FAILED:
     /** caps negotiation failed */
     str_pipeline = g_strdup_printf ("videotestsrc num-buffers=%d ! videoconvert ! video/x-raw,width=160,height=120,format=RGB,framerate=(fraction)%lu/1 ! "
@@ -4062,6 +4089,63 @@ test_custom_v1_eventHandler (const GstTensorFilterFramework *self,
   return -ENOENT;
 }
 
+/**
+ * @brief Data for the asynchronous invoke of the custom filter (v2).
+ */
+typedef struct {
+  const GstTensorMemory *input; /**< input tensors */
+  GstTensorMemory *output; /**< output tensors */
+  guint num_tensors; /**< the number of tensors */
+  GstTensorFilterInvokeCallback callback; /**< callback to notify the completion */
+  void *user_data; /**< user data for the callback */
+} test_custom_async_data_s;
+
+/**
+ * @brief Thread to complete the asynchronous invoke of the custom filter (v2).
+ */
+static gpointer
+test_custom_v2_invoke_thread (gpointer data)
+{
+  test_custom_async_data_s *async_data = (test_custom_async_data_s *) data;
+  guint i;
+
+  /* random delay to complete the invoke out of order */
+  g_usleep (g_random_int_range (0, 3000));
+
+  for (i = 0; i < async_data->num_tensors; i++)
+    memcpy (async_data->output[i].data, async_data->input[i].data,
+        async_data->input[i].size);
+
+  async_data->callback (async_data->user_data, 0);
+  g_free (async_data);
+  return NULL;
+}
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v2).
+ */
+static int
+test_custom_v2_invoke_async (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output,
+    GstTensorFilterInvokeCallback callback, void *user_data)
+{
+  test_custom_async_data_s *async_data;
+  GThread *thread;
+
+  async_data = g_new0 (test_custom_async_data_s, 1);
+  async_data->input = input;
+  async_data->output = output;
+  async_data->num_tensors = prop->input_meta.num_tensors;
+  async_data->callback = callback;
+  async_data->user_data = user_data;
+
+  thread = g_thread_new ("test-async-invoke", test_custom_v2_invoke_thread,
+      async_data);
+  g_thread_unref (thread);
+  return 0;
+}
+
 /**
  * @brief Test for passthrough custom filter without model.
  */
@@ -4239,6 +4323,293 @@ TEST (tensorStreamTest, subpluginV1Run)
   g_free (fw);
 }
 
+/**
+ * @brief Test for passthrough custom filter with asynchronous invoke (v2).
+ */
+TEST (tensorStreamTest, subpluginV2AsyncRun)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V2;
+  fw->invoke = test_custom_v1_invoke;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+  fw->invoke_async = test_custom_v2_invoke_async;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  /* the output task pushes the results of the frames in flight */
+  test_custom_run_pipeline ();
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief The number of invokes of the custom filter with micro-batching.
+ */
+static guint test_custom_batch_invoked = 0;
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), checking the batched input.
+ */
+static int
+test_custom_v1_batch_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  /* 4 frames of 160x120 RGB */
+  EXPECT_EQ (input[0].size, 4U * 3U * 160 * 120);
+  EXPECT_EQ (prop->input_meta.info[0].dimension[3], 4U);
+
+  test_custom_batch_invoked++;
+  return test_custom_v1_invoke (self, prop, private_data, input, output);
+}
+
+/**
+ * @brief Test for passthrough custom filter with micro-batching.
+ */
+TEST (tensorStreamTest, subpluginV1BatchRun)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_PASSTHROUGH_BATCH };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_batch_invoke;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_batch_invoked = 0;
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* 2 full batches, and the incomplete batch is invoked with EOS */
+  EXPECT_EQ (test_custom_batch_invoked, 3U);
+
+  /* the batch size cannot be changed after the caps are negotiated */
+  {
+    GstElement *filter;
+    guint batch_size = 0;
+
+    filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+    ASSERT_TRUE (filter != NULL);
+
+    g_object_set (filter, "batch-size", 2U, NULL);
+    g_object_get (filter, "batch-size", &batch_size, NULL);
+    EXPECT_EQ (batch_size, 4U);
+    gst_object_unref (filter);
+  }
+
+  /* check received buffers, each frame is split from the batch */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  /* check timestamp */
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  /* check tensor config for video */
+  EXPECT_TRUE (gst_tensors_config_validate (&g_test_data.tensors_config));
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[3], 1U);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief The number of frames in each batched invoke of the custom filter.
+ */
+static GArray *test_custom_batch_frames = NULL;
+
+/**
+ * @brief The optional callback for GstTensorFilterFramework (v2), invoking the frames at once.
+ */
+static int
+test_custom_v2_invoke_batch (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    unsigned int num_frames, const GstTensorMemory **input, GstTensorMemory **output)
+{
+  unsigned int i;
+  int ret;
+
+  /* supports the batched invoke */
+  if (num_frames == 0)
+    return 0;
+
+  g_array_append_val (test_custom_batch_frames, num_frames);
+
+  for (i = 0; i < num_frames; i++) {
+    /* the frames are not stacked */
+    EXPECT_EQ (input[i][0].size, 3U * 160 * 120);
+    EXPECT_EQ (prop->input_meta.info[0].dimension[3], 1U);
+
+    ret = test_custom_v1_invoke (self, prop, private_data, input[i], output[i]);
+    if (ret != 0)
+      return ret;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Test for passthrough custom filter with micro-batching, invoking the frames with the callback invoke_batch.
+ */
+TEST (tensorStreamTest, subpluginV2BatchInvokeRun)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_PASSTHROUGH_BATCH };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V2;
+  fw->invoke = test_custom_v1_invoke;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+  fw->invoke_batch = test_custom_v2_invoke_batch;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_batch_frames = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* 2 full batches, and the incomplete batch without padding with EOS */
+  EXPECT_EQ (test_custom_batch_frames->len, 3U);
+  if (test_custom_batch_frames->len == 3U) {
+    EXPECT_EQ (g_array_index (test_custom_batch_frames, guint, 0), 4U);
+    EXPECT_EQ (g_array_index (test_custom_batch_frames, guint, 1), 4U);
+    EXPECT_EQ (g_array_index (test_custom_batch_frames, guint, 2), 2U);
+  }
+
+  /* check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  /* check timestamp */
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  g_array_free (test_custom_batch_frames, TRUE);
+  test_custom_batch_frames = NULL;
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework (v1), completing the invoke with random delay.
+ */
+static int
+test_custom_v1_delayed_invoke (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  g_usleep (g_random_int_range (0, 3000));
+  return test_custom_v1_invoke (self, prop, private_data, input, output);
+}
+
+/**
+ * @brief Test for passthrough custom filter with multiple instances.
+ */
+TEST (tensorStreamTest, subpluginV1MultiInstanceRun)
+{
+  const guint num_buffers = 20;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_PASSTHROUGH_MULTI };
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+  GstElement *filter;
+  gchar *utilization = NULL;
+  gchar **instances;
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V1;
+  fw->invoke = test_custom_v1_delayed_invoke;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  /* construct pipeline for test */
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  /* check the utilization of each instance */
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+  ASSERT_TRUE (filter != NULL);
+  g_object_get (filter, "instance-utilization", &utilization, NULL);
+  ASSERT_TRUE (utilization != NULL);
+
+  instances = g_strsplit (utilization, ",", -1);
+  EXPECT_EQ (g_strv_length (instances), 3U);
+  g_strfreev (instances);
+  g_free (utilization);
+  gst_object_unref (filter);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /* check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /* check received buffers, pushed in the order of the input */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+  EXPECT_FALSE (g_test_data.invalid_order);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
 /**
  * @brief Test for plugin registration with invalid param (v1).
  */
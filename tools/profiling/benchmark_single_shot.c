@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer, benchmark of the concurrent invokes of single-shot.
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	benchmark_single_shot.c
+ * @date	16 Oct 2026
+ * @brief	Print the throughput of single-shot invoked from several threads, with the pool of framework contexts.
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @bug		No known bugs except for NYI items
+ *
+ * This is not a test case, it only prints the number of invokes per second.
+ * The model is a custom-easy function sleeping for the given time.
+ *
+ * usage: benchmark_single_shot [context-pool-size] [invokes per thread] [invoke time in usec]
+ */
+
+#include <glib.h>
+#include <stdlib.h>
+#include <string.h>
+#include <nnstreamer_plugin_api.h>
+#include <tensor_filter_custom_easy.h>
+#include <tensor_filter_single.h>
+
+#define BENCHMARK_MODEL_NAME "benchmark_single_shot"
+#define BENCHMARK_TENSOR_SIZE (1024)
+#define BENCHMARK_MAX_THREADS (8)
+
+static guint invokes_per_thread = 100;
+static gulong invoke_time = 2000;
+
+/**
+ * @brief The model of custom-easy, copy the input after sleeping.
+ */
+static int
+benchmark_invoke (void *data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * in, GstTensorMemory * out)
+{
+  g_usleep (invoke_time);
+  memcpy (out[0].data, in[0].data, MIN (in[0].size, out[0].size));
+  return 0;
+}
+
+/**
+ * @brief Thread to invoke the single-shot instance.
+ */
+static gpointer
+benchmark_invoke_thread (gpointer data)
+{
+  GTensorFilterSingle *single = G_TENSOR_FILTER_SINGLE (data);
+  GTensorFilterSingleClass *klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT] = { {0} };
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT] = { {0} };
+  guint8 in_data[BENCHMARK_TENSOR_SIZE];
+  guint i;
+
+  memset (in_data, 1, sizeof (in_data));
+  input[0].data = in_data;
+  input[0].size = sizeof (in_data);
+
+  for (i = 0; i < invokes_per_thread; i++) {
+    output[0].size = sizeof (in_data);
+    if (!klass->invoke (single, input, output, TRUE)) {
+      g_printerr ("Failed to invoke the model.\n");
+      break;
+    }
+
+    klass->release_output (single, output);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Invoke the single-shot instance from the threads and return the invokes per second.
+ */
+static gdouble
+benchmark_run_threads (GTensorFilterSingle * single, guint num_threads)
+{
+  GThread *threads[BENCHMARK_MAX_THREADS];
+  gint64 start, elapsed;
+  guint i;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < num_threads; i++)
+    threads[i] = g_thread_new ("benchmark", benchmark_invoke_thread, single);
+  for (i = 0; i < num_threads; i++)
+    g_thread_join (threads[i]);
+  elapsed = g_get_monotonic_time () - start;
+
+  return (gdouble) (num_threads * invokes_per_thread) * G_USEC_PER_SEC /
+      MAX (elapsed, 1);
+}
+
+/**
+ * @brief Main function of the benchmark.
+ */
+int
+main (int argc, char **argv)
+{
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GstTensorsInfo info;
+  gchar *stats = NULL;
+  guint pool_size = 4;
+  guint num_threads;
+
+  if (argc > 1)
+    pool_size = (guint) MAX (strtoul (argv[1], NULL, 10), 1);
+  if (argc > 2)
+    invokes_per_thread = (guint) strtoul (argv[2], NULL, 10);
+  if (argc > 3)
+    invoke_time = strtoul (argv[3], NULL, 10);
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1U;
+  info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("1024:1:1:1", info.info[0].dimension);
+
+  if (NNS_custom_easy_register (BENCHMARK_MODEL_NAME, benchmark_invoke, NULL,
+          &info, &info) != 0) {
+    g_printerr ("Failed to register the custom-easy model.\n");
+    return 1;
+  }
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE,
+      "framework", "custom-easy", "model", BENCHMARK_MODEL_NAME,
+      "context-pool-size", pool_size, NULL);
+  klass = G_TENSOR_FILTER_SINGLE_GET_CLASS (single);
+
+  if (!klass->start (single)) {
+    g_printerr ("Failed to start the single-shot instance.\n");
+    g_object_unref (single);
+    NNS_custom_easy_unregister (BENCHMARK_MODEL_NAME);
+    return 1;
+  }
+
+  g_print ("context-pool-size %u, %u invokes per thread, invoke time %lu usec\n",
+      pool_size, invokes_per_thread, invoke_time);
+
+  for (num_threads = 1; num_threads <= BENCHMARK_MAX_THREADS; num_threads *= 2) {
+    g_print ("%u threads: %.1f invokes/sec\n", num_threads,
+        benchmark_run_threads (single, num_threads));
+  }
+
+  g_object_get (single, "shared-pool-stats", &stats, NULL);
+  g_print ("pool statistics: %s\n", stats ? stats : "");
+  g_free (stats);
+
+  klass->stop (single);
+  g_object_unref (single);
+  NNS_custom_easy_unregister (BENCHMARK_MODEL_NAME);
+  return 0;
+}
@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+##
+## SPDX-License-Identifier: LGPL-2.1-only
+##
+## @file benchmark_tflite_xnnpack.sh
+## @date 16 Oct 2026
+## @brief Compare the throughput of tensorflow2-lite with the XNNPACK delegate and the default kernels
+##
+## This is not a test case, it only prints the elapsed time of each run.
+## usage: benchmark_tflite_xnnpack.sh [model] [frames] [threads] [plugin path]
+##
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null && pwd )"
+
+MODEL=${1:-"${DIR}/../../tests/test_models/models/deeplabv3_257_mv_gpu.tflite"}
+FRAMES=${2:-30}
+THREADS=${3:-2}
+PLUGIN_PATH=${4:-"${DIR}/../../build"}
+
+if [[ ! -f ${MODEL} ]]; then
+    echo "Cannot find the model ${MODEL}"
+    exit 1
+fi
+
+# The float model deeplabv3 has the input 3:257:257:1
+function run_throughput() {
+    gst-launch-1.0 -q --gst-plugin-path=${PLUGIN_PATH} videotestsrc num-buffers=${FRAMES} ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=257,height=257,framerate=0/1 ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,div:255.0 ! tensor_filter framework=tensorflow2-lite model=${MODEL} custom=$1 ! fakesink sync=false 2>benchmark.info
+}
+
+function measure() {
+    local start_time
+    local elapsed
+
+    start_time=$(date +%s%N)
+    if ! run_throughput $2; then
+        echo "$1: failed to run the pipeline (see benchmark.info)"
+        return
+    fi
+    elapsed=$(( ($(date +%s%N) - start_time) / 1000000 ))
+
+    if grep -q "XNNPACK delegate support is not enabled" benchmark.info; then
+        echo "$1: XNNPACK delegate is not available in this build"
+        return
+    fi
+
+    echo "$1: ${FRAMES} frames in ${elapsed} ms"
+}
+
+echo "Model ${MODEL}, ${THREADS} threads"
+measure "default kernels" NumThreads:${THREADS}
+measure "XNNPACK delegate" Delegate:XNNPACK,NumThreads:${THREADS}
+rm -f benchmark.info